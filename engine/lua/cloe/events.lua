@@ -142,6 +142,44 @@ function events.next(simulation_duration)
     return string.format("next=%s", simulation_duration:s())
 end
 
+--- When the predicate over signals is true.
+---
+--- The predicate is compiled by the engine and evaluated natively in every
+--- step, which is much cheaper than checking the same condition in a Lua
+--- function. It supports comparisons, `&&`, `||`, `!`, parentheses,
+--- held conditions such as `x > 5 for 1s`, and comparisons with
+--- hysteresis such as `x > 5 hysteresis 1`.
+---
+--- Example:
+---
+---     cloe.schedule {
+---         on = cloe.events.predicate("vehicles.default.speed >= 10 for 500ms"),
+---         run = function(sync) ... end,
+---     }
+---
+--- If a timeout in absolute simulation time is given, the event also
+--- occurs once the timeout has passed.
+---
+--- If a group is given, then once one predicate event of the group occurs,
+--- the triggers of all other predicate events in that group are removed.
+---
+--- @param expression string predicate over signals
+--- @param timeout? string|Duration absolute simulation time
+--- @param group? string name of group in which only the first event occurs
+--- @return table
+function events.predicate(expression, timeout, group)
+    validate("cloe.events.predicate(string, [string|userdata], [string])", expression, timeout, group)
+    if type(timeout) == "string" then
+        timeout = types.Duration.new(timeout)
+    end
+    return {
+        name = "predicate",
+        expression = expression,
+        timeout = timeout and timeout:s() or nil,
+        group = group,
+    }
+end
+
 --- When the simulation is paused.
 ---
 --- This will trigger every few milliseconds while in the pause state.
@@ -407,16 +407,24 @@ function TestFixture:wait_duration(duration)
     })
 end
 
---- Wait until the function supplied returns true, then resume.
+--- Wait until the condition supplied is true, then resume.
 ---
 --- This will yield execution of the test-case back to the simulation
---- until the function, which is run once every cycle, returns true.
+--- until the condition, which is checked once every cycle, is true.
 ---
---- @param condition fun(sync: Sync):boolean
+--- The condition is either a function or a predicate over signals as
+--- supported by `cloe.events.predicate`, such as:
+---
+---     z:wait_until("vehicles.default.speed >= 10 for 500ms", "20s")
+---
+--- A predicate is evaluated natively by the engine, so prefer it over a
+--- function whenever the condition only depends on signals.
+---
+--- @param condition string|fun(sync: Sync):boolean
 --- @param timeout? Duration|string
 --- @return nil
 function TestFixture:wait_until(condition, timeout)
-    validate("TestFixture:wait_until(function, [string|userdata|nil])", self, condition, timeout)
+    validate("TestFixture:wait_until(string|function, [string|userdata|nil])", self, condition, timeout)
     if type(timeout) == "string" then
         timeout = types.Duration.new(timeout)
     end
@@ -426,6 +434,38 @@ function TestFixture:wait_until(condition, timeout)
     else
         self:debugf("wait until condition: %s", condition)
     end
+    if type(condition) == "string" then
+        if not timeout then
+            coroutine.yield({
+                on = events.predicate(condition),
+                group = self._id,
+                run = function(sync)
+                    return self:_resume(true)
+                end,
+            })
+            return
+        end
+
+        -- The condition and the timeout are separate triggers in one group,
+        -- so that only one of them fires. The condition is inserted first,
+        -- so it wins if both are true in the same step, just like below.
+        self:_schedule({
+            on = events.predicate(condition, nil, self._id),
+            group = self._id,
+            run = function(sync)
+                return self:_resume(true)
+            end,
+        })
+        coroutine.yield({
+            on = events.predicate("false", timeout, self._id),
+            group = self._id,
+            run = function(sync)
+                self:warnf("condition timed out after %s", timeout)
+                return self:_resume(false)
+            end,
+        })
+        return
+    end
     coroutine.yield({
         on = events.loop(),
         group = self._id,
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file batch_job.cpp
+ * \see  batch_job.hpp
+ */
+
+#include "batch_job.hpp"
+
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+#include <fmt/format.h>  // for format
+
+namespace engine {
+
+BatchParameter parse_parameter(const std::string& s) {
+  auto eq = s.find('=');
+  if (eq == std::string::npos || eq == 0) {
+    throw std::invalid_argument("expect parameter of the form KEY=VALUE,...: " + s);
+  }
+  BatchParameter p{s.substr(0, eq), {}};
+  size_t pos = eq + 1;
+  while (true) {
+    auto comma = s.find(',', pos);
+    p.second.emplace_back(s.substr(pos, comma - pos));
+    if (comma == std::string::npos) {
+      break;
+    }
+    pos = comma + 1;
+  }
+  return p;
+}
+
+std::string BatchJob::outcome() const {
+  if (!started) {
+    return "skipped";
+  } else if (result.is_object() && result.contains("outcome")) {
+    return result["outcome"].get<std::string>();
+  } else if (crashed) {
+    return "crashed";
+  } else {
+    return "no-start";
+  }
+}
+
+void to_json(cloe::Json& j, const BatchJob& b) {
+  j = cloe::Json{
+      {"name", b.name},
+      {"files", b.files},
+      {"parameters", b.parameters},
+      {"outcome", b.outcome()},
+      {"exit_code", b.exit_code},
+      {"elapsed", b.elapsed},
+      {"result", b.result},
+  };
+}
+
+std::vector<BatchJob> make_jobs(const std::vector<std::string>& parameters,
+                                const std::vector<std::string>& common_files,
+                                const std::vector<std::string>& filepaths,
+                                const std::filesystem::path& result_dir) {
+  std::vector<BatchParameter> params;
+  for (const auto& s : parameters) {
+    params.emplace_back(parse_parameter(s));
+  }
+
+  std::vector<std::map<std::string, std::string>> combinations{{}};
+  for (const auto& p : params) {
+    std::vector<std::map<std::string, std::string>> next;
+    for (const auto& c : combinations) {
+      for (const auto& value : p.second) {
+        auto d = c;
+        d[p.first] = value;
+        next.emplace_back(std::move(d));
+      }
+    }
+    combinations = std::move(next);
+  }
+
+  std::vector<BatchJob> jobs;
+  for (const auto& file : filepaths) {
+    for (const auto& c : combinations) {
+      BatchJob job;
+      job.index = jobs.size();
+      job.name = file;
+      for (const auto& kv : c) {
+        job.name += fmt::format(" {}={}", kv.first, kv.second);
+      }
+      job.files = common_files;
+      job.files.emplace_back(file);
+      job.parameters = c;
+      job.result_file = result_dir / fmt::format("{}.json", job.index);
+      jobs.emplace_back(std::move(job));
+    }
+  }
+  return jobs;
+}
+
+}  // namespace engine
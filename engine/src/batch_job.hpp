@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file batch_job.hpp
+ * \see  batch_job.cpp
+ * \see  batch_job_test.cpp
+ * \see  main_batch.cpp
+ *
+ * This file defines the jobs that the batch command runs, one for each stack
+ * file and each combination of parameter values.
+ */
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdlib>     // for EXIT_FAILURE
+#include <filesystem>  // for path
+#include <map>         // for map<>
+#include <string>      // for string
+#include <utility>     // for pair<>
+#include <vector>      // for vector<>
+
+#include <cloe/core.hpp>  // for Json
+
+namespace engine {
+
+/**
+ * BatchParameter is a parameter name together with the values it takes.
+ */
+using BatchParameter = std::pair<std::string, std::vector<std::string>>;
+
+/**
+ * Return the parameter from an argument of the form KEY=VALUE1,VALUE2,...
+ *
+ * - Throws std::invalid_argument if the argument has no key.
+ */
+BatchParameter parse_parameter(const std::string& s);
+
+struct BatchJob {
+  size_t index;
+  std::string name;
+  std::vector<std::string> files;
+  std::map<std::string, std::string> parameters;
+  std::filesystem::path result_file;
+
+  // Set when the job is run:
+  bool started{false};
+  int exit_code{EXIT_FAILURE};
+  bool crashed{false};
+  double elapsed{0.0};
+  cloe::Json result;
+
+  [[nodiscard]] std::string outcome() const;
+
+  friend void to_json(cloe::Json& j, const BatchJob& b);
+};
+
+/**
+ * Return one job for each stack file and each combination of parameter
+ * values, in this order.
+ *
+ * Each job consists of the common files followed by its stack file, and
+ * writes its result to a file in result_dir.
+ *
+ * - Throws std::invalid_argument if a parameter is invalid.
+ */
+std::vector<BatchJob> make_jobs(const std::vector<std::string>& parameters,
+                                const std::vector<std::string>& common_files,
+                                const std::vector<std::string>& filepaths,
+                                const std::filesystem::path& result_dir);
+
+}  // namespace engine
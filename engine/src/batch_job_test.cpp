@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file batch_job_test.cpp
+ * \see  batch_job.hpp
+ */
+
+#include <filesystem>  // for path
+#include <map>         // for map<>
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string, to_string
+#include <vector>      // for vector<>
+
+#include <gtest/gtest.h>
+
+#include "batch_job.hpp"  // for parse_parameter, make_jobs
+using engine::make_jobs;
+using engine::parse_parameter;
+
+TEST(engine_batch_job, parse_parameter) {
+  auto p = parse_parameter("SPEED=10,20,30");
+  EXPECT_EQ(p.first, "SPEED");
+  EXPECT_EQ(p.second, (std::vector<std::string>{"10", "20", "30"}));
+
+  // Values may be empty and contain further equal signs.
+  p = parse_parameter("X=");
+  EXPECT_EQ(p.second, (std::vector<std::string>{""}));
+  p = parse_parameter("X=a=b,,c");
+  EXPECT_EQ(p.second, (std::vector<std::string>{"a=b", "", "c"}));
+
+  EXPECT_THROW(parse_parameter("X"), std::invalid_argument);
+  EXPECT_THROW(parse_parameter("=1,2"), std::invalid_argument);
+  EXPECT_THROW(parse_parameter(""), std::invalid_argument);
+}
+
+TEST(engine_batch_job, make_jobs) {
+  auto jobs = make_jobs({"A=1,2", "B=x,y,z"}, {"common.json"}, {"s1.json", "s2.json"}, "/tmp/d");
+  ASSERT_EQ(jobs.size(), 12);
+  for (size_t i = 0; i < jobs.size(); i++) {
+    EXPECT_EQ(jobs[i].index, i);
+    EXPECT_EQ(jobs[i].files.size(), 2);
+    EXPECT_EQ(jobs[i].files[0], "common.json");
+    EXPECT_EQ(jobs[i].result_file, std::filesystem::path("/tmp/d") / (std::to_string(i) + ".json"));
+    EXPECT_EQ(jobs[i].outcome(), "skipped");
+  }
+
+  // Stack files vary slowest, then parameters in the order given.
+  EXPECT_EQ(jobs[0].files[1], "s1.json");
+  EXPECT_EQ(jobs[0].name, "s1.json A=1 B=x");
+  EXPECT_EQ(jobs[1].name, "s1.json A=1 B=y");
+  EXPECT_EQ(jobs[3].name, "s1.json A=2 B=x");
+  EXPECT_EQ(jobs[6].files[1], "s2.json");
+  EXPECT_EQ(jobs[11].parameters, (std::map<std::string, std::string>{{"A", "2"}, {"B", "z"}}));
+
+  // Without parameters, there is one job per stack file.
+  jobs = make_jobs({}, {}, {"s1.json", "s2.json"}, "/tmp/d");
+  ASSERT_EQ(jobs.size(), 2);
+  EXPECT_EQ(jobs[1].files, (std::vector<std::string>{"s2.json"}));
+  EXPECT_TRUE(jobs[1].parameters.empty());
+
+  // A later value of the same parameter replaces the earlier one.
+  jobs = make_jobs({"A=1", "A=2,3"}, {}, {"s.json"}, "/tmp/d");
+  ASSERT_EQ(jobs.size(), 2);
+  EXPECT_EQ(jobs[0].parameters.at("A"), "2");
+
+  EXPECT_THROW(make_jobs({"A=1", "B"}, {}, {"s.json"}, "/tmp/d"), std::invalid_argument);
+  EXPECT_TRUE(make_jobs({}, {}, {}, "/tmp/d").empty());
+}
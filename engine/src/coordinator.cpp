@@ -39,8 +39,10 @@
 #include <cloe/trigger.hpp>    // for Trigger
 using namespace cloe;          // NOLINT(build/namespaces)
 
+#include "input_journal.hpp"  // for InputJournal, InputJournalWriter
 #include "lua_action.hpp"
 #include "lua_api.hpp"
+#include "utility/tracer.hpp"  // for TraceSpan
 
 namespace engine {
 
@@ -201,6 +203,11 @@ sol::table Coordinator::register_lua_table(const std::string& field) {
 
 cloe::CallbackResult Coordinator::execute_trigger(TriggerPtr&& t, const Sync& sync) {
   logger()->debug("Execute trigger {}", inline_json(*t));
+  std::string span_name;
+  if (tracer_ != nullptr) {
+    span_name = t->event().name() + " -> " + t->action().name();
+  }
+  TraceSpan span(tracer_, "trigger", span_name);
   auto result = (t->action())(sync, *executer_registrar_);
   if (!t->is_conceal()) {
     history_.emplace_back(sync.time(), std::move(t));
@@ -236,14 +243,63 @@ size_t Coordinator::process_pending_web_triggers(const Sync& sync) {
   // for thread safety here!
   size_t count = 0;
   std::unique_lock guard(input_mutex_);
+  if (replay_) {
+    for (const auto& j : replay_->pop_due(sync.step())) {
+      input_queue_.emplace_back(make_trigger(Source::NETWORK, Conf{j}));
+    }
+  }
   while (!input_queue_.empty()) {
-    store_trigger(std::move(input_queue_.front()), sync);
+    auto& tp = input_queue_.front();
+    if (journal_ && tp->source() == Source::NETWORK) {
+      journal_->record(sync.step(), Json(*tp));
+    }
+    store_trigger(std::move(tp), sync);
     input_queue_.pop_front();
     count++;
   }
   return count;
 }
 
+Json Coordinator::pending_triggers() const {
+  Json j = Json::array();
+  auto append = [&j](const Json& triggers) {
+    if (triggers.is_array()) {
+      j.insert(j.end(), triggers.begin(), triggers.end());
+    }
+  };
+  for (const auto& kv : storage_) {
+    append(Json(*kv.second));
+  }
+  std::unique_lock guard(input_mutex_);
+  append(Json(input_queue_));
+  return j;
+}
+
+size_t Coordinator::restore_triggers(const Json& triggers, const Sync& sync) {
+  for (auto& kv : storage_) {
+    kv.second->clear();
+  }
+  {
+    std::unique_lock guard(input_mutex_);
+    input_queue_.clear();
+  }
+
+  size_t count = 0;
+  for (const auto& j : triggers) {
+    try {
+      auto tp = make_trigger(j.at("source").get<Source>(), Conf{j});
+      if (tp == nullptr) {
+        continue;
+      }
+      store_trigger(std::move(tp), sync);
+      count++;
+    } catch (std::exception& e) {
+      logger()->warn("Cannot restore trigger {}: {}", j.dump(), e.what());
+    }
+  }
+  return count;
+}
+
 void Coordinator::store_trigger(TriggerPtr&& tp, const Sync& sync) {
   tp->set_since(sync.time());
 
@@ -39,7 +39,10 @@
 namespace engine {
 
 // Forward declarations:
-class TriggerRegistrar;  // from coordinator.cpp
+class TriggerRegistrar;    // from coordinator.cpp
+class InputJournal;        // from input_journal.hpp
+class InputJournalWriter;  // from input_journal.hpp
+class Tracer;              // from utility/tracer.hpp
 
 /**
  * TriggerUnknownAction is thrown when an Action cannot be created because the
@@ -136,6 +139,44 @@ class Coordinator {
   size_t process_pending_lua_triggers(const cloe::Sync& sync);
   size_t process_pending_web_triggers(const cloe::Sync& sync);
 
+  /**
+   * Return the JSON representation of all triggers that have not been
+   * executed yet, from which restore_triggers can recreate them.
+   */
+  [[nodiscard]] cloe::Json pending_triggers() const;
+
+  /**
+   * Replace all pending triggers by the given ones, as returned by
+   * pending_triggers, and return the number of triggers restored.
+   *
+   * Triggers that cannot be recreated from JSON, such as those with Lua
+   * function actions, are skipped with a warning.
+   */
+  size_t restore_triggers(const cloe::Json& triggers, const cloe::Sync& sync);
+
+  /**
+   * Record each trigger inserted via the network in the journal, together
+   * with the step in which it is inserted.
+   *
+   * Triggers from other sources are not recorded, since they are inserted
+   * again when the simulation is replayed.
+   */
+  void set_journal(std::shared_ptr<InputJournalWriter> journal) { journal_ = std::move(journal); }
+
+  /**
+   * Insert the triggers of the journal in the steps in which they were
+   * recorded, as if they had been inserted via the network.
+   */
+  void set_replay(std::shared_ptr<InputJournal> replay) { replay_ = std::move(replay); }
+
+  /**
+   * Record the execution of each trigger in the tracer.
+   *
+   * The tracer is not owned and must outlive the coordinator, or be reset
+   * with nullptr.
+   */
+  void set_tracer(Tracer* tracer) { tracer_ = tracer; }
+
   void insert_trigger_from_lua(const cloe::Sync& sync, const sol::object& obj);
   void execute_action_from_lua(const cloe::Sync& sync, const sol::object& obj);
 
@@ -175,6 +216,13 @@ class Coordinator {
 
   // History:
   std::vector<HistoryTrigger> history_;
+
+  // Journal:
+  std::shared_ptr<InputJournalWriter> journal_;
+  std::shared_ptr<InputJournal> replay_;
+
+  // Tracing:
+  Tracer* tracer_{nullptr};  // non-owning
 };
 
 void register_usertype_coordinator(sol::table& lua, const cloe::Sync& sync);
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file input_journal.cpp
+ * \see  input_journal.hpp
+ */
+
+#include "input_journal.hpp"
+
+#include <algorithm>    // for stable_sort
+#include <cstring>      // for memcmp
+#include <string_view>  // for string_view
+#include <utility>      // for move
+
+#include <cloe/core/error.hpp>  // for Error
+
+namespace engine {
+
+namespace {
+
+constexpr std::string_view MAGIC = "CLOEJRNL";
+
+template <typename T>
+void write_value(std::ofstream& ofs, const T& x) {
+  ofs.write(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::ifstream& ifs, T& x) {
+  ifs.read(reinterpret_cast<char*>(&x), sizeof(T));
+  return ifs.gcount() == sizeof(T);
+}
+
+}  // anonymous namespace
+
+InputJournalWriter::InputJournalWriter(const std::filesystem::path& filepath, uint64_t seed)
+    : filepath_(filepath), ofs_(filepath, std::ios::binary | std::ios::trunc) {
+  ofs_.write(MAGIC.data(), MAGIC.size());
+  write_value(ofs_, FORMAT_VERSION);
+  write_value(ofs_, seed);
+  ofs_.flush();
+  if (!ofs_) {
+    throw cloe::Error("cannot write input journal: {}", filepath_.native());
+  }
+}
+
+void InputJournalWriter::record(uint64_t step, const cloe::Json& trigger) {
+  auto data = cloe::Json::to_cbor(trigger);
+  write_value(ofs_, step);
+  write_value(ofs_, static_cast<uint32_t>(data.size()));
+  ofs_.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+  ofs_.flush();
+  if (!ofs_) {
+    throw cloe::Error("cannot write input journal: {}", filepath_.native());
+  }
+  count_++;
+}
+
+InputJournal InputJournal::read(const std::filesystem::path& filepath) {
+  std::ifstream ifs(filepath, std::ios::binary);
+  if (!ifs) {
+    throw cloe::Error("cannot open input journal: {}", filepath.native());
+  }
+
+  char magic[MAGIC.size()];
+  uint32_t version = 0;
+  uint64_t seed = 0;
+  ifs.read(magic, sizeof(magic));
+  if (ifs.gcount() != sizeof(magic) || std::memcmp(magic, MAGIC.data(), sizeof(magic)) != 0) {
+    throw cloe::Error("not an input journal: {}", filepath.native());
+  }
+  if (!read_value(ifs, version) || version != InputJournalWriter::FORMAT_VERSION) {
+    throw cloe::Error("unsupported input journal version {}, expected {}: {}", version,
+                      InputJournalWriter::FORMAT_VERSION, filepath.native());
+  }
+  if (!read_value(ifs, seed)) {
+    throw cloe::Error("input journal truncated: {}", filepath.native());
+  }
+
+  std::vector<JournalEntry> entries;
+  while (true) {
+    uint64_t step;
+    uint32_t size;
+    if (!read_value(ifs, step) || !read_value(ifs, size)) {
+      break;
+    }
+    std::vector<uint8_t> data(size);
+    ifs.read(reinterpret_cast<char*>(data.data()), size);
+    if (ifs.gcount() != static_cast<std::streamsize>(size)) {
+      break;
+    }
+    entries.emplace_back(JournalEntry{step, cloe::Json::from_cbor(data)});
+  }
+
+  // Records are written in order, but make sure anyway.
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const auto& a, const auto& b) { return a.step < b.step; });
+  return InputJournal(seed, std::move(entries));
+}
+
+std::vector<cloe::Json> InputJournal::pop_due(uint64_t step) {
+  std::vector<cloe::Json> due;
+  while (next_ < entries_.size() && entries_[next_].step <= step) {
+    due.emplace_back(entries_[next_].trigger);
+    next_++;
+  }
+  return due;
+}
+
+}  // namespace engine
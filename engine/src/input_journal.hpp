@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file input_journal.hpp
+ * \see  input_journal.cpp
+ * \see  input_journal_test.cpp
+ *
+ * This file defines the input journal, which records the nondeterministic
+ * input of a simulation, so that it can be replayed without interaction.
+ */
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t, uint64_t
+#include <filesystem>  // for path
+#include <fstream>     // for ofstream
+#include <utility>     // for move
+#include <vector>      // for vector<>
+
+#include <cloe/core.hpp>  // for Json
+
+namespace engine {
+
+/**
+ * JournalEntry is a trigger that was inserted from outside the simulation,
+ * together with the step in which it was inserted.
+ */
+struct JournalEntry {
+  uint64_t step;
+  cloe::Json trigger;
+};
+
+/**
+ * InputJournalWriter writes an input journal file.
+ *
+ * The file starts with the random seed of the simulation, followed by one
+ * record per trigger, with the trigger encoded as CBOR. Each record is
+ * flushed immediately, so that the journal is complete even if the
+ * simulation crashes. The format is in host byte order.
+ */
+class InputJournalWriter {
+ public:
+  /// Incremented whenever the file format changes.
+  static constexpr uint32_t FORMAT_VERSION = 1;
+
+  /**
+   * Create the journal file, overwriting any existing file.
+   *
+   * Throws cloe::Error if the file cannot be written.
+   */
+  InputJournalWriter(const std::filesystem::path& filepath, uint64_t seed);
+
+  /**
+   * Append the trigger that was inserted in the given step.
+   */
+  void record(uint64_t step, const cloe::Json& trigger);
+
+  [[nodiscard]] size_t size() const { return count_; }
+
+ private:
+  std::filesystem::path filepath_;
+  std::ofstream ofs_;
+  size_t count_{0};
+};
+
+/**
+ * InputJournal is an input journal read from a file, from which the
+ * triggers are replayed in the steps in which they were recorded.
+ */
+class InputJournal {
+ public:
+  InputJournal(uint64_t seed, std::vector<JournalEntry> entries)
+      : seed_(seed), entries_(std::move(entries)) {}
+
+  /**
+   * Read the journal file written by InputJournalWriter.
+   *
+   * A truncated last record, such as from a crash, is ignored.
+   * Throws cloe::Error if the file is not a journal.
+   */
+  [[nodiscard]] static InputJournal read(const std::filesystem::path& filepath);
+
+  [[nodiscard]] uint64_t seed() const { return seed_; }
+  [[nodiscard]] const std::vector<JournalEntry>& entries() const { return entries_; }
+
+  /**
+   * Return the triggers recorded up to and including the given step, which
+   * have not been returned yet.
+   */
+  [[nodiscard]] std::vector<cloe::Json> pop_due(uint64_t step);
+
+  /**
+   * Return the number of triggers that have not been returned yet.
+   */
+  [[nodiscard]] size_t remaining() const { return entries_.size() - next_; }
+
+ private:
+  uint64_t seed_;
+  std::vector<JournalEntry> entries_;
+  size_t next_{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file input_journal_test.cpp
+ * \see  input_journal.hpp
+ */
+
+#include <filesystem>  // for path, temp_directory_path, resize_file, remove
+#include <fstream>     // for ofstream
+#include <string>      // for string
+
+#include <gtest/gtest.h>
+
+#include <cloe/core/error.hpp>  // for Error
+
+#include "input_journal.hpp"  // for InputJournalWriter, InputJournal
+
+using namespace engine;  // NOLINT(build/namespaces)
+
+namespace {
+
+std::filesystem::path temp_journal(const char* name) {
+  return std::filesystem::temp_directory_path() /
+         (std::string("cloe-input-journal-test-") + name + ".bin");
+}
+
+}  // anonymous namespace
+
+TEST(engine_input_journal, round_trip) {
+  auto filepath = temp_journal("round_trip");
+  cloe::Json pause{{"event", "next"}, {"action", "pause"}};
+  cloe::Json resume{{"event", "pause"}, {"action", "resume"}};
+  cloe::Json stop{{"event", "next"}, {"action", {{"name", "stop"}}}};
+  {
+    InputJournalWriter w(filepath, 0xDEADBEEF);
+    w.record(0, pause);
+    w.record(0, resume);
+    w.record(250, stop);
+    EXPECT_EQ(w.size(), 3);
+  }
+
+  auto j = InputJournal::read(filepath);
+  EXPECT_EQ(j.seed(), 0xDEADBEEF);
+  ASSERT_EQ(j.entries().size(), 3);
+  EXPECT_EQ(j.entries()[2].step, 250);
+
+  auto due = j.pop_due(0);
+  ASSERT_EQ(due.size(), 2);
+  EXPECT_EQ(due[0], pause);
+  EXPECT_EQ(due[1], resume);
+  EXPECT_TRUE(j.pop_due(249).empty());
+  EXPECT_EQ(j.remaining(), 1);
+  EXPECT_EQ(j.pop_due(300).at(0), stop);
+  EXPECT_EQ(j.remaining(), 0);
+
+  // A truncated last record is ignored.
+  std::filesystem::resize_file(filepath, std::filesystem::file_size(filepath) - 1);
+  EXPECT_EQ(InputJournal::read(filepath).entries().size(), 2);
+  std::filesystem::remove(filepath);
+}
+
+TEST(engine_input_journal, invalid) {
+  auto filepath = temp_journal("invalid");
+  std::ofstream(filepath) << "not a journal";
+  EXPECT_THROW(InputJournal::read(filepath), cloe::Error);
+  std::filesystem::remove(filepath);
+  EXPECT_THROW(InputJournal::read(filepath), cloe::Error);
+}
@@ -334,6 +334,9 @@ void setup_lua(sol::state_view lua, const LuaOptions& opt, Stack& stack) {
   );
   lua.set_exception_handler(&lua_exception_handler);
   // clang-format on
+  if (opt.random_seed) {
+    lua["math"]["randomseed"](static_cast<lua_Integer>(*opt.random_seed));
+  }
 
   register_package_path(lua, opt);
   register_cloe_engine(lua, stack);
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>   // for uint64_t
 #include <iostream>  // for ostream, cerr
 #include <memory>    // for shared_ptr<>
 #include <optional>  // for optional<>
@@ -45,6 +46,10 @@ struct LuaOptions {
   std::vector<std::string> lua_paths;
   bool no_system_lua = false;
   bool auto_require_cloe = false;
+
+  /// Seed for math.random, so that Lua scripts behave the same when a
+  /// simulation is replayed. If not set, Lua picks a seed itself.
+  std::optional<uint64_t> random_seed;
 };
 
 /**
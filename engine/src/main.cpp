@@ -17,6 +17,7 @@
  */
 
 #include <iostream>  // for cerr
+#include <memory>    // for make_shared
 #include <string>    // for string
 #include <utility>   // for swap
 
@@ -24,7 +25,9 @@
 
 #include <cloe/core/error.hpp>
 #include <cloe/core/logger.hpp>
+#include <cloe/plugin_cache.hpp>
 #include <cloe/stack_config.hpp>
+#include <cloe/utility/xdg.hpp>
 
 #include "main_commands.hpp"
 
@@ -87,12 +90,44 @@ int main(int argc, char** argv) {
   run->add_flag("--require-success,!--no-require-success", run_options.require_success,
                 "Require simulation success")
       ->envname("CLOE_REQUIRE_SUCCESS");
+  run->add_option("--from-checkpoint", run_options.from_checkpoint,
+                  "Continue simulation from checkpoint file")
+      ->check(CLI::ExistingFile);
+  run->add_option("--journal", run_options.journal_path,
+                  "Record network triggers and random seed to journal file");
+  run->add_option("--replay", run_options.replay_path,
+                  "Replay journal file at unlimited speed")
+      ->check(CLI::ExistingFile);
   run->add_flag("--debug-lua", run_options.debug_lua, "Debug the Lua simulation");
   run->add_option("--debug-lua-port", run_options.debug_lua_port,
                   "Port to listen on for debugger to attach to")
       ->envname("CLOE_DEBUG_LUA_PORT");
   run->add_option("files", run_files, "Files to merge into a single stackfile")->required();
 
+  // Batch Command:
+  engine::BatchOptions batch_options{};
+  std::vector<std::string> batch_files{};
+  auto* batch = app.add_subcommand("batch", "Run many simulations in parallel.");
+  batch->add_option("-j,--jobs", batch_options.jobs,
+                    "Number of simulations to run at once (0 = number of cores)");
+  batch->add_option("-c,--common", batch_options.common_files,
+                    "Files to merge into each simulation before its stack file");
+  batch->add_option("-P,--param", batch_options.parameters,
+                    "Run each stack file once per value of KEY=VALUE1,VALUE2,...");
+  batch->add_option("-J,--json-indent", batch_options.json_indent, "JSON indentation level");
+  batch->add_flag("--allow-empty", batch_options.allow_empty, "Allow empty simulations");
+  batch->add_flag("-w,--write-output,!--no-write-output", batch_options.write_output,
+                  "Do (not) write any output files")
+      ->envname("CLOE_WRITE_OUTPUT");
+  batch->add_option("-o,--output-path", batch_options.output_path,
+                    "Write output of each simulation to a numbered subdirectory")
+      ->envname("CLOE_OUTPUT_PATH");
+  batch->add_flag("--require-success,!--no-require-success", batch_options.require_success,
+                  "Require simulation success")
+      ->envname("CLOE_REQUIRE_SUCCESS");
+  batch->add_option("files", batch_files, "Stack files to run as separate simulations")
+      ->required();
+
   // One of the above subcommands must be used.
   app.require_subcommand();
 
@@ -126,6 +161,10 @@ int main(int argc, char** argv) {
   app.add_flag("--no-system-confs", stack_options.no_system_confs,
                "Disable automatic sourcing of system configurations");
   app.add_flag("--no-hooks", stack_options.no_hooks, "Disable execution of hooks");
+  bool no_plugin_cache = false;
+  app.add_flag("--no-plugin-cache", no_plugin_cache,
+               "Load all plugins instead of using the plugin cache")
+      ->envname("CLOE_NO_PLUGIN_CACHE");
   app.add_flag("!--no-interpolate", stack_options.interpolate_vars,
                "Interpolate variables of the form ${XYZ} in stack files");
   app.add_flag("--interpolate-undefined", stack_options.interpolate_undefined,
@@ -171,12 +210,19 @@ int main(int argc, char** argv) {
       stack_options.strict_mode = true;
       stack_options.no_hooks = true;
       stack_options.interpolate_vars = false;
+      no_plugin_cache = true;
     }
     if (stack_options.strict_mode) {
       stack_options.no_system_plugins = true;
       stack_options.no_system_confs = true;
       lua_options.no_system_lua = true;
       run_options.require_success = true;
+      batch_options.require_success = true;
+    }
+
+    if (!no_plugin_cache) {
+      stack_options.plugin_cache = std::make_shared<cloe::PluginCache>(
+          cloe::utility::user_cache(CLOE_XDG_SUFFIX "/plugin_cache.json"), CLOE_ENGINE_VERSION);
     }
 
     stack_options.environment->prefer_external(false);
@@ -205,6 +251,8 @@ int main(int argc, char** argv) {
       return engine::probe(with_global_options(probe_options), probe_files);
     } else if (*run) {
       return engine::run(with_global_options(run_options), run_files);
+    } else if (*batch) {
+      return engine::batch(with_global_options(batch_options), batch_files);
     } else if (*shell) {
       return engine::shell(with_global_options(shell_options), shell_files);
     }
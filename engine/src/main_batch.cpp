@@ -0,0 +1,277 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file main_batch.cpp
+ * \see  main_commands.hpp
+ *
+ * The batch command runs many simulations from one engine process.
+ *
+ * The parent process loads the plugins once and then forks a child for each
+ * simulation, so that the children share the loaded plugins copy-on-write
+ * instead of loading them again. Each child runs the simulation just like
+ * the run command does and writes the result to a file in a private
+ * temporary directory, from which the parent aggregates the report.
+ */
+
+#include <sys/types.h>  // for pid_t
+#include <sys/wait.h>   // for waitpid, WIFEXITED, ...
+#include <unistd.h>     // for fork
+
+#include <algorithm>     // for max
+#include <cerrno>        // for errno, EINTR
+#include <chrono>        // for steady_clock, duration<>
+#include <csignal>       // for signal, sig_atomic_t
+#include <cstdlib>       // for _Exit, mkdtemp, setenv, unsetenv
+#include <exception>     // for exception
+#include <filesystem>    // for path, temp_directory_path, remove_all
+#include <fstream>       // for ifstream, ofstream
+#include <iostream>      // for cout, cerr
+#include <map>           // for map<>
+#include <string>        // for string
+#include <system_error>  // for system_error, generic_category
+#include <thread>        // for thread::hardware_concurrency
+#include <tuple>         // for ignore
+#include <utility>       // for pair<>
+#include <vector>        // for vector<>
+
+#include <boost/algorithm/string/predicate.hpp>  // for ends_with
+#include <fmt/format.h>                          // for format
+
+#include <cloe/core.hpp>           // for Json, logger::get
+#include <cloe/stack.hpp>          // for Stack
+#include <cloe/stack_config.hpp>   // for CLOE_SIMULATION_UUID_VAR
+#include <cloe/stack_factory.hpp>  // for new_stack, merge_stack
+
+#include "batch_job.hpp"      // for BatchJob, make_jobs
+#include "error_handler.hpp"  // for conclude_error
+#include "main_commands.hpp"  // for BatchOptions, RunOptions, run
+#include "utility/defer.hpp"  // for Defer
+
+namespace engine {
+
+namespace {
+
+volatile std::sig_atomic_t BATCH_INTERRUPTED = 0;  // NOLINT
+
+void handle_batch_signal(int) { BATCH_INTERRUPTED = 1; }
+
+/**
+ * Run the job in the current process and return the exit code.
+ *
+ * This is called in the forked child, so it may freely modify the process
+ * environment.
+ */
+int run_job(const BatchOptions& opt, const BatchJob& job) {
+  for (const auto& kv : job.parameters) {
+    opt.stack_options.environment->set(kv.first, kv.second);
+    setenv(kv.first.c_str(), kv.second.c_str(), 1);
+  }
+
+  // Each simulation needs its own UUID.
+  unsetenv(CLOE_SIMULATION_UUID_VAR);
+
+  std::ofstream ofs(job.result_file, std::ios::trunc);
+  RunOptions r;
+  r.stack_options = opt.stack_options;
+  r.lua_options = opt.lua_options;
+  r.output = &ofs;
+  r.error = opt.error;
+  r.json_indent = -1;
+  r.allow_empty = opt.allow_empty;
+  r.write_output = opt.write_output;
+  r.require_success = opt.require_success;
+  r.report_progress = false;
+  if (!opt.output_path.empty()) {
+    r.output_path = (std::filesystem::path(opt.output_path) / fmt::format("{:04}", job.index))
+                        .native();
+  }
+  return run(r, job.files);
+}
+
+pid_t start_job(const BatchOptions& opt, BatchJob& job) {
+  std::cout << std::flush;
+  std::cerr << std::flush;
+  auto pid = fork();
+  if (pid < 0) {
+    throw std::system_error(errno, std::generic_category(), "cannot fork batch job");
+  }
+  if (pid == 0) {
+    std::ignore = std::signal(SIGINT, SIG_DFL);
+    int code = EXIT_FAILURE;
+    try {
+      code = run_job(opt, job);
+    } catch (std::exception& e) {
+      *opt.error << "Error: " << e.what() << std::endl;
+    }
+    std::cout << std::flush;
+    std::cerr << std::flush;
+
+    // Skip the destructors and exit handlers, which belong to the parent.
+    std::_Exit(code);
+  }
+  job.started = true;
+  return pid;
+}
+
+void finish_job(BatchJob& job, int status) {
+  if (WIFEXITED(status)) {
+    job.exit_code = WEXITSTATUS(status);
+  } else if (WIFSIGNALED(status)) {
+    job.exit_code = 128 + WTERMSIG(status);
+    job.crashed = true;
+  }
+
+  std::ifstream ifs(job.result_file);
+  if (ifs && ifs.peek() != std::ifstream::traits_type::eof()) {
+    try {
+      job.result = cloe::Json::parse(ifs);
+    } catch (std::exception& e) {
+      cloe::logger::get("cloe")->error("Cannot read result of {}: {}", job.name, e.what());
+    }
+  }
+  ifs.close();
+  std::error_code ec;
+  std::filesystem::remove(job.result_file, ec);
+}
+
+/**
+ * Create a new directory that only the current user can access, so that
+ * other users can neither predict nor tamper with the result files.
+ */
+std::filesystem::path make_private_directory() {
+  auto tmpl = (std::filesystem::temp_directory_path() / "cloe-batch-XXXXXX").native();
+  if (mkdtemp(tmpl.data()) == nullptr) {
+    throw std::system_error(errno, std::generic_category(), "cannot create batch directory");
+  }
+  return tmpl;
+}
+
+}  // anonymous namespace
+
+int batch(const BatchOptions& opt, const std::vector<std::string>& filepaths) {
+  auto log = cloe::logger::get("cloe");
+  log->info("Cloe {}", CLOE_ENGINE_VERSION);
+
+  std::filesystem::path tmpdir;
+  std::vector<BatchJob> jobs;
+  try {
+    tmpdir = make_private_directory();
+    jobs = make_jobs(opt.parameters, opt.common_files, filepaths, tmpdir);
+  } catch (std::exception& e) {
+    *opt.error << "Error: " << e.what() << std::endl;
+    if (!tmpdir.empty()) {
+      std::error_code ec;
+      std::filesystem::remove_all(tmpdir, ec);
+    }
+    return EXIT_FAILURE;
+  }
+
+  // The forked children never return here, so only the parent removes it.
+  Defer cleanup([&tmpdir]() {
+    std::error_code ec;
+    std::filesystem::remove_all(tmpdir, ec);
+  });
+
+  // Load the plugins once, so that the children only need to look them up.
+  // Plugins can only be loaded from the common stack files, since the other
+  // files may depend on the parameters. Plugins in the plugin cache are
+  // registered without opening them, so they are opened explicitly here;
+  // otherwise every child would open them itself.
+  cloe::Stack preload;
+  try {
+    preload = cloe::conclude_error(*opt.stack_options.error,
+                                   [&]() { return cloe::new_stack(opt.stack_options); });
+  } catch (cloe::ConcludedError&) {
+    return EXIT_FAILURE;
+  }
+  for (const auto& file : opt.common_files) {
+    if (boost::algorithm::ends_with(file, ".lua")) {
+      continue;
+    }
+    try {
+      cloe::merge_stack(opt.stack_options, preload, file);
+    } catch (std::exception& e) {
+      log->debug("Cannot preload plugins from {}: {}", file, e.what());
+    }
+  }
+  for (const auto& kv : preload.get_all_plugins()) {
+    try {
+      kv.second->ensure_loaded();
+    } catch (std::exception& e) {
+      log->debug("Cannot preload plugin {}: {}", kv.first, e.what());
+    }
+  }
+
+  auto workers = opt.jobs > 0 ? opt.jobs : std::max(1U, std::thread::hardware_concurrency());
+  log->info("Running {} simulations with {} workers", jobs.size(), workers);
+
+  auto prev_handler = std::signal(SIGINT, handle_batch_signal);
+  auto begin = std::chrono::steady_clock::now();
+  std::map<pid_t, std::pair<BatchJob*, std::chrono::steady_clock::time_point>> running;
+  size_t next = 0;
+  size_t done = 0;
+  while (true) {
+    while (!BATCH_INTERRUPTED && next < jobs.size() && running.size() < workers) {
+      auto& job = jobs[next++];
+      auto pid = start_job(opt, job);
+      running.emplace(pid, std::make_pair(&job, std::chrono::steady_clock::now()));
+    }
+    if (running.empty()) {
+      break;
+    }
+
+    int status = 0;
+    auto pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "cannot wait for batch job");
+    }
+    auto it = running.find(pid);
+    if (it == running.end()) {
+      continue;
+    }
+    auto& job = *it->second.first;
+    job.elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - it->second.second)
+            .count();
+    running.erase(it);
+    finish_job(job, status);
+    log->info("[{}/{}] {}: {}", ++done, jobs.size(), job.name, job.outcome());
+  }
+  std::ignore = std::signal(SIGINT, prev_handler);
+
+  bool ok = !jobs.empty();
+  std::map<std::string, size_t> outcomes;
+  for (const auto& job : jobs) {
+    outcomes[job.outcome()]++;
+    ok = ok && job.started && job.exit_code == EXIT_SUCCESS;
+  }
+  cloe::Json report{
+      {"success", ok},
+      {"elapsed", std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()},
+      {"workers", workers},
+      {"outcomes", outcomes},
+      {"jobs", jobs},
+  };
+  *opt.output << report.dump(opt.json_indent) << "\n" << std::flush;
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}  // namespace engine
@@ -89,6 +89,9 @@ struct RunOptions {
   // Options
   std::string uuid;
   std::string output_path;
+  std::string from_checkpoint;
+  std::string journal_path;
+  std::string replay_path;
 
   // Flags:
   int json_indent = 2;
@@ -103,6 +106,28 @@ struct RunOptions {
 
 int run(const RunOptions& opt, const std::vector<std::string>& filepaths);
 
+struct BatchOptions {
+  cloe::StackOptions stack_options;
+  cloe::LuaOptions lua_options;
+
+  std::ostream* output = &std::cout;
+  std::ostream* error = &std::cerr;
+
+  // Options:
+  std::vector<std::string> common_files;
+  std::vector<std::string> parameters;
+  std::string output_path;
+  size_t jobs = 0;
+
+  // Flags:
+  int json_indent = 2;
+  bool allow_empty = false;
+  bool write_output = true;
+  bool require_success = false;
+};
+
+int batch(const BatchOptions& opt, const std::vector<std::string>& filepaths);
+
 struct ShellOptions {
   cloe::StackOptions stack_options;
   cloe::LuaOptions lua_options;
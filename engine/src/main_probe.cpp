@@ -18,6 +18,8 @@
 
 #include <csignal>  // for signal
 
+#include <cloe/utility/timer.hpp>  // for DurationTimer
+
 #include "error_handler.hpp"     // for conclude_error
 #include "main_commands.hpp"     // for ProbeOptions, handle_*
 #include "simulation.hpp"        // for Simulation
@@ -32,11 +34,14 @@ std::tuple<cloe::Stack, sol::state> handle_config(const ProbeOptions& opt, const
 int probe(const ProbeOptions& opt, const std::vector<std::string>& filepaths) {
   try {
     auto uuid = handle_uuid(opt);
+    timer::DurationTimer<cloe::Duration> configure_timer;
     auto [stack, lua] = handle_config(opt, filepaths);
     auto lua_view = sol::state_view(lua.lua_state());
+    auto configure_time = configure_timer.elapsed();
 
     // Create simulation:
     Simulation sim(std::move(stack), lua_view, uuid);
+    sim.add_startup_phase("configure", configure_time);
     GLOBAL_SIMULATION_INSTANCE = &sim;
     std::ignore = std::signal(SIGINT, handle_signal);
 
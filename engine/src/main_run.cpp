@@ -17,11 +17,16 @@
  */
 
 #include <csignal>  // for signal
+#include <memory>   // for shared_ptr<>, make_shared
+#include <random>   // for random_device
 #include <tuple>    // for tuple
 
-#include <cloe/stack.hpp>  // for Stack
+#include <cloe/core/logger.hpp>    // for logger::get
+#include <cloe/stack.hpp>          // for Stack
+#include <cloe/utility/timer.hpp>  // for DurationTimer
 
 #include "error_handler.hpp"      // for conclude_error
+#include "input_journal.hpp"      // for InputJournal, InputJournalWriter
 #include "main_commands.hpp"      // for RunOptions, handle_*
 #include "simulation.hpp"         // for Simulation
 #include "simulation_result.hpp"  // for SimulationResult
@@ -35,8 +40,29 @@ std::tuple<cloe::Stack, sol::state> handle_config(const RunOptions& opt,
 int run(const RunOptions& opt, const std::vector<std::string>& filepaths) {
   try {
     auto uuid = handle_uuid(opt);
-    auto [stack, lua] = handle_config(opt, filepaths);
+
+    // The journal determines the random seed, which must be known before
+    // any Lua script runs.
+    std::shared_ptr<InputJournal> replay;
+    std::shared_ptr<InputJournalWriter> journal;
+    RunOptions o = opt;
+    cloe::conclude_error(*opt.stack_options.error, [&]() {
+      if (!opt.replay_path.empty()) {
+        replay = std::make_shared<InputJournal>(InputJournal::read(opt.replay_path));
+        o.lua_options.random_seed = replay->seed();
+      } else if (!opt.journal_path.empty()) {
+        o.lua_options.random_seed = std::random_device{}();
+      }
+      if (!opt.journal_path.empty()) {
+        journal = std::make_shared<InputJournalWriter>(opt.journal_path,
+                                                       *o.lua_options.random_seed);
+      }
+    });
+
+    timer::DurationTimer<cloe::Duration> configure_timer;
+    auto [stack, lua] = handle_config(o, filepaths);
     auto lua_view = sol::state_view(lua.lua_state());
+    auto configure_time = configure_timer.elapsed();
 
     if (!opt.allow_empty) {
       stack.check_completeness();
@@ -51,7 +77,13 @@ int run(const RunOptions& opt, const std::vector<std::string>& filepaths) {
     std::ignore = std::signal(SIGINT, handle_signal);
 
     // Set options:
+    sim.add_startup_phase("configure", configure_time);
     sim.set_report_progress(opt.report_progress);
+    if (!opt.from_checkpoint.empty()) {
+      sim.set_from_checkpoint(opt.from_checkpoint);
+    }
+    sim.set_journal(journal);
+    sim.set_replay(replay);
 
     // Run simulation:
     auto result = cloe::conclude_error(*opt.stack_options.error, [&]() { return sim.run(); });
@@ -60,6 +92,15 @@ int run(const RunOptions& opt, const std::vector<std::string>& filepaths) {
       // statistics or write any files, just go home.
       return EXIT_FAILURE;
     }
+    if (journal) {
+      cloe::logger::get("cloe")->info("Recorded {} triggers to journal: {}", journal->size(),
+                                      opt.journal_path);
+    }
+    if (replay && replay->remaining() != 0) {
+      cloe::logger::get("cloe")->warn(
+          "Simulation ended before {} triggers from the journal could be replayed",
+          replay->remaining());
+    }
 
     // Write results:
     if (opt.write_output) {
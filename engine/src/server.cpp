@@ -32,6 +32,8 @@
 
 #include <oak/server.hpp>  // for Server, StaticRegistrar, ...
 
+#include "utility/tracer.hpp"  // for TraceSpan
+
 namespace engine {
 
 class ServerRegistrarImpl : public ServerRegistrar {
@@ -165,9 +167,11 @@ class ServerImpl : public Server {
 
   void refresh_buffer() override {
     if (is_listening() || is_streaming()) {
+      TraceSpan span(tracer_, "server", "refresh_buffer");
       buffer_api_registrar_.refresh_buffer();
     }
     if (is_streaming()) {
+      TraceSpan span(tracer_, "server", "write_data_stream");
       write_data_stream(locked_api_registrar_.endpoints());
       write_data_stream(buffer_api_registrar_.endpoints());
     }
@@ -31,6 +31,8 @@
 
 namespace engine {
 
+class Tracer;  // from utility/tracer.hpp
+
 /**
  * Server registrar interface.
  *
@@ -135,9 +137,18 @@ class Server {
    */
   [[nodiscard]] virtual Defer lock() = 0;
 
+  /**
+   * Record refreshing the buffer and streaming data in the tracer.
+   *
+   * The tracer is not owned and must outlive the server, or be reset with
+   * nullptr.
+   */
+  void set_tracer(Tracer* tracer) { tracer_ = tracer; }
+
  protected:
   cloe::Logger logger() const { return cloe::logger::get("cloe"); }
   cloe::ServerConf config_;
+  Tracer* tracer_{nullptr};
 };
 
 /**
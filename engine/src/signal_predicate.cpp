@@ -0,0 +1,381 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file signal_predicate.cpp
+ * \see  signal_predicate.hpp
+ */
+
+#include "signal_predicate.hpp"
+
+#include <algorithm>  // for max
+#include <cctype>     // for isalnum, isalpha, isdigit, isspace
+#include <cstdlib>    // for strtod
+#include <map>        // for map<>
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+#include <fmt/format.h>              // for format
+#include <fable/utility/chrono.hpp>  // for parse_duration
+
+namespace engine {
+
+namespace {
+
+struct Token {
+  enum class Kind { End, Number, Duration, Name, Quoted, Symbol };
+
+  Kind kind;
+  std::string text;
+  size_t pos;
+};
+
+bool is_name_char(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '/' ||
+         c == ':';
+}
+
+std::vector<Token> tokenize(const std::string& s) {
+  static const std::vector<std::string> symbols{
+      "==", "!=", "<=", ">=", "&&", "||", "<", ">", "!", "(", ")", "-",
+  };
+
+  std::vector<Token> tokens;
+  size_t i = 0;
+  while (i < s.size()) {
+    auto c = static_cast<unsigned char>(s[i]);
+    if (std::isspace(c)) {
+      i++;
+    } else if (std::isdigit(c) || (c == '.' && i + 1 < s.size() && std::isdigit(s[i + 1]))) {
+      char* end = nullptr;
+      std::strtod(s.c_str() + i, &end);
+      size_t j = static_cast<size_t>(end - s.c_str());
+      auto kind = Token::Kind::Number;
+      while (j < s.size() && std::isalpha(static_cast<unsigned char>(s[j]))) {
+        kind = Token::Kind::Duration;
+        j++;
+      }
+      tokens.push_back(Token{kind, s.substr(i, j - i), i});
+      i = j;
+    } else if (std::isalpha(c) || c == '_') {
+      size_t j = i;
+      while (j < s.size() && is_name_char(s[j])) {
+        j++;
+      }
+      tokens.push_back(Token{Token::Kind::Name, s.substr(i, j - i), i});
+      i = j;
+    } else if (c == '\'') {
+      auto j = s.find('\'', i + 1);
+      if (j == std::string::npos) {
+        throw std::invalid_argument(
+            fmt::format("unterminated signal name at position {} in predicate: {}", i, s));
+      }
+      tokens.push_back(Token{Token::Kind::Quoted, s.substr(i + 1, j - i - 1), i});
+      i = j + 1;
+    } else {
+      auto it = std::find_if(symbols.begin(), symbols.end(),
+                             [&](const std::string& x) { return s.compare(i, x.size(), x) == 0; });
+      if (it == symbols.end()) {
+        throw std::invalid_argument(
+            fmt::format("unexpected character '{}' at position {} in predicate: {}", s[i], i, s));
+      }
+      tokens.push_back(Token{Token::Kind::Symbol, *it, i});
+      i += it->size();
+    }
+  }
+  tokens.push_back(Token{Token::Kind::End, "", s.size()});
+  return tokens;
+}
+
+bool is_keyword(const std::string& s) {
+  return s == "and" || s == "or" || s == "not" || s == "for" || s == "hysteresis" ||
+         s == "true" || s == "false";
+}
+
+inline bool truth(double x) { return x != 0.0; }
+
+}  // anonymous namespace
+
+/**
+ * Compiler translates the expression by recursive descent into a program
+ * for a stack machine, in which each instruction consumes its operands from
+ * the stack and pushes its result.
+ */
+class SignalPredicate::Compiler {
+ public:
+  Compiler(SignalPredicate& p, const Resolver& resolve)
+      : p_(p), resolve_(resolve), tokens_(tokenize(p.expr_)) {}
+
+  void compile() {
+    parse_expr();
+    if (peek().kind != Token::Kind::End) {
+      fail("unexpected '" + peek().text + "'");
+    }
+    p_.stack_.resize(max_depth_);
+  }
+
+ private:
+  const Token& peek() const { return tokens_[pos_]; }
+
+  /**
+   * Consume the next token if it is the symbol or the optional keyword.
+   */
+  bool accept(const char* symbol, const char* keyword = nullptr) {
+    const auto& t = peek();
+    if ((symbol != nullptr && t.kind == Token::Kind::Symbol && t.text == symbol) ||
+        (keyword != nullptr && t.kind == Token::Kind::Name && t.text == keyword)) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  [[noreturn]] void fail(const std::string& msg) const {
+    throw std::invalid_argument(
+        fmt::format("{} at position {} in predicate: {}", msg, peek().pos, p_.expr_));
+  }
+
+  void emit(Instruction i) {
+    switch (i.op) {
+      case Opcode::Const:
+      case Opcode::Signal:
+        depth_++;
+        break;
+      case Opcode::Not:
+      case Opcode::Hold:
+        break;
+      default:
+        depth_--;
+        break;
+    }
+    max_depth_ = std::max(max_depth_, depth_);
+    p_.program_.emplace_back(std::move(i));
+  }
+
+  void parse_expr() {
+    parse_and();
+    while (accept("||", "or")) {
+      parse_and();
+      emit(Instruction{Opcode::Or});
+    }
+  }
+
+  void parse_and() {
+    parse_unary();
+    while (accept("&&", "and")) {
+      parse_unary();
+      emit(Instruction{Opcode::And});
+    }
+  }
+
+  void parse_unary() {
+    if (accept("!", "not")) {
+      parse_unary();
+      emit(Instruction{Opcode::Not});
+    } else {
+      parse_held();
+    }
+  }
+
+  void parse_held() {
+    parse_compare();
+    if (accept(nullptr, "for")) {
+      const auto& t = peek();
+      if (t.kind != Token::Kind::Duration) {
+        fail("expected duration with unit, such as 500ms,");
+      }
+      Instruction i{Opcode::Hold};
+      try {
+        i.duration = fable::parse_duration<cloe::Duration>(t.text);
+      } catch (std::exception&) {
+        fail(fmt::format("invalid duration '{}'", t.text));
+      }
+      pos_++;
+      emit(std::move(i));
+    }
+  }
+
+  void parse_compare() {
+    static const std::map<std::string, Opcode> ops{
+        {"==", Opcode::Eq}, {"!=", Opcode::Ne}, {"<", Opcode::Lt},
+        {"<=", Opcode::Le}, {">", Opcode::Gt},  {">=", Opcode::Ge},
+    };
+
+    parse_operand();
+    const auto& t = peek();
+    if (t.kind != Token::Kind::Symbol || ops.count(t.text) == 0) {
+      return;
+    }
+    Instruction i{ops.at(t.text)};
+    pos_++;
+    parse_operand();
+    if (accept(nullptr, "hysteresis")) {
+      if (i.op == Opcode::Eq || i.op == Opcode::Ne) {
+        fail("hysteresis requires an ordering comparison");
+      }
+      if (peek().kind != Token::Kind::Number) {
+        fail("expected hysteresis width");
+      }
+      i.value = std::stod(peek().text);
+      pos_++;
+    }
+    emit(std::move(i));
+  }
+
+  void parse_operand() {
+    const auto& t = peek();
+    switch (t.kind) {
+      case Token::Kind::Number:
+        pos_++;
+        emit(Instruction{Opcode::Const, std::stod(t.text)});
+        return;
+      case Token::Kind::Quoted:
+        pos_++;
+        emit_signal(t.text);
+        return;
+      case Token::Kind::Name:
+        if (t.text == "true" || t.text == "false") {
+          pos_++;
+          emit(Instruction{Opcode::Const, t.text == "true" ? 1.0 : 0.0});
+          return;
+        } else if (!is_keyword(t.text)) {
+          pos_++;
+          emit_signal(t.text);
+          return;
+        }
+        break;
+      case Token::Kind::Symbol:
+        if (accept("(")) {
+          parse_expr();
+          if (!accept(")")) {
+            fail("expected ')'");
+          }
+          return;
+        } else if (accept("-")) {
+          if (peek().kind != Token::Kind::Number) {
+            fail("expected number after '-'");
+          }
+          emit(Instruction{Opcode::Const, -std::stod(peek().text)});
+          pos_++;
+          return;
+        }
+        break;
+      default:
+        break;
+    }
+    fail(t.kind == Token::Kind::End ? "unexpected end" : "unexpected '" + t.text + "'");
+  }
+
+  void emit_signal(const std::string& name) {
+    auto it = indexes_.find(name);
+    if (it == indexes_.end()) {
+      it = indexes_.emplace(name, p_.readers_.size()).first;
+      p_.signals_.emplace_back(name);
+      p_.readers_.emplace_back(resolve_(name));
+    }
+    Instruction i{Opcode::Signal};
+    i.index = it->second;
+    emit(std::move(i));
+  }
+
+ private:
+  SignalPredicate& p_;
+  const Resolver& resolve_;
+  std::vector<Token> tokens_;
+  size_t pos_{0};
+  size_t depth_{0};
+  size_t max_depth_{0};
+  std::map<std::string, size_t> indexes_;
+};
+
+SignalPredicate::SignalPredicate(std::string expr, const Resolver& resolve)
+    : expr_(std::move(expr)) {
+  Compiler(*this, resolve).compile();
+}
+
+bool SignalPredicate::operator()(cloe::Duration now) {
+  double* st = stack_.data();
+  size_t n = 0;
+  for (auto& i : program_) {
+    switch (i.op) {
+      case Opcode::Const:
+        st[n++] = i.value;
+        break;
+      case Opcode::Signal:
+        st[n++] = readers_[i.index]();
+        break;
+      case Opcode::Not:
+        st[n - 1] = truth(st[n - 1]) ? 0.0 : 1.0;
+        break;
+      case Opcode::And:
+        n--;
+        st[n - 1] = (truth(st[n - 1]) && truth(st[n])) ? 1.0 : 0.0;
+        break;
+      case Opcode::Or:
+        n--;
+        st[n - 1] = (truth(st[n - 1]) || truth(st[n])) ? 1.0 : 0.0;
+        break;
+      case Opcode::Eq:
+        n--;
+        st[n - 1] = st[n - 1] == st[n] ? 1.0 : 0.0;
+        break;
+      case Opcode::Ne:
+        n--;
+        st[n - 1] = st[n - 1] != st[n] ? 1.0 : 0.0;
+        break;
+      case Opcode::Lt:
+      case Opcode::Le: {
+        // While active, the threshold is raised by the hysteresis width.
+        n--;
+        double rhs = i.active ? st[n] + i.value : st[n];
+        i.active = i.op == Opcode::Lt ? st[n - 1] < rhs : st[n - 1] <= rhs;
+        st[n - 1] = i.active ? 1.0 : 0.0;
+        break;
+      }
+      case Opcode::Gt:
+      case Opcode::Ge: {
+        // While active, the threshold is lowered by the hysteresis width.
+        n--;
+        double rhs = i.active ? st[n] - i.value : st[n];
+        i.active = i.op == Opcode::Gt ? st[n - 1] > rhs : st[n - 1] >= rhs;
+        st[n - 1] = i.active ? 1.0 : 0.0;
+        break;
+      }
+      case Opcode::Hold:
+        if (!truth(st[n - 1])) {
+          i.active = false;
+          break;
+        }
+        if (!i.active) {
+          i.active = true;
+          i.since = now;
+        }
+        st[n - 1] = (now - i.since >= i.duration) ? 1.0 : 0.0;
+        break;
+    }
+  }
+  return truth(st[0]);
+}
+
+void SignalPredicate::reset() {
+  for (auto& i : program_) {
+    i.active = false;
+    i.since = cloe::Duration{0};
+  }
+}
+
+}  // namespace engine
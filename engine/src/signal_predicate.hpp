@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file signal_predicate.hpp
+ * \see  signal_predicate.cpp
+ * \see  signal_predicate_test.cpp
+ *
+ * This file defines a small predicate language over signals, which is
+ * compiled once and then evaluated natively in every step.
+ *
+ * The grammar is as follows, with keywords being case-sensitive:
+ *
+ *     expr     := and { ("||" | "or") and }
+ *     and      := unary { ("&&" | "and") unary }
+ *     unary    := ("!" | "not") unary | held
+ *     held     := compare [ "for" DURATION ]
+ *     compare  := operand [ CMP operand [ "hysteresis" NUMBER ] ]
+ *     operand  := ["-"] NUMBER | "true" | "false" | SIGNAL | "(" expr ")"
+ *     CMP      := "==" | "!=" | "<" | "<=" | ">" | ">="
+ *
+ * Signals are written as identifiers that may contain dots, slashes, and
+ * colons, such as `vehicles.default.sensor.speed`, or in single quotes if
+ * they contain any other characters or clash with a keyword. All values are
+ * compared as double, and any non-zero operand is true on its own.
+ *
+ * A held condition `x > 5 for 1s` is only true once the condition has been
+ * true for the given duration without interruption. Since a hold binds
+ * tighter than negation and conjunction, `a && !b for 1s` holds only `b`;
+ * use parentheses such as `(a && !b) for 1s` to hold more. A comparison with
+ * hysteresis `x > 5 hysteresis 1` becomes true when x exceeds 5, but only
+ * becomes false again when x is at most 4.
+ */
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <functional>  // for function<>
+#include <string>      // for string
+#include <vector>      // for vector<>
+
+#include <cloe/core.hpp>  // for Duration
+
+namespace engine {
+
+class SignalPredicate {
+ public:
+  /**
+   * Reader returns the current value of a signal.
+   */
+  using Reader = std::function<double()>;
+
+  /**
+   * Resolver returns a Reader for the signal with the given name.
+   *
+   * It should throw an exception if the signal does not exist or has a type
+   * that cannot be compared.
+   */
+  using Resolver = std::function<Reader(const std::string&)>;
+
+  /**
+   * Compile the expression and resolve all signals it refers to.
+   *
+   * - Throws std::invalid_argument if the expression is invalid.
+   * - Throws whatever the resolver throws.
+   */
+  SignalPredicate(std::string expr, const Resolver& resolve);
+
+  /**
+   * Return the expression the predicate was compiled from.
+   */
+  const std::string& expression() const { return expr_; }
+
+  /**
+   * Return the names of the signals that the predicate reads.
+   */
+  const std::vector<std::string>& signals() const { return signals_; }
+
+  /**
+   * Evaluate the predicate at the given simulation time.
+   *
+   * This should be called once each step, since held conditions and
+   * comparisons with hysteresis keep state between evaluations. All of the
+   * expression is evaluated every time, so that the state of each part is
+   * kept up-to-date regardless of the other parts.
+   */
+  bool operator()(cloe::Duration now);
+
+  /**
+   * Forget the state of held conditions and comparisons with hysteresis.
+   */
+  void reset();
+
+ private:
+  enum class Opcode { Const, Signal, Not, And, Or, Eq, Ne, Lt, Le, Gt, Ge, Hold };
+
+  struct Instruction {
+    Opcode op;
+    double value{0.0};  // constant value or hysteresis width
+    size_t index{0};    // index of signal reader
+    cloe::Duration duration{0};
+
+    // State of comparisons with hysteresis and held conditions:
+    bool active{false};
+    cloe::Duration since{0};
+  };
+
+  class Compiler;
+
+ private:
+  std::string expr_;
+  std::vector<std::string> signals_;
+  std::vector<Reader> readers_;
+  std::vector<Instruction> program_;
+  std::vector<double> stack_;
+};
+
+}  // namespace engine
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file signal_predicate_test.cpp
+ * \see  signal_predicate.hpp
+ */
+
+#include <map>        // for map<>
+#include <stdexcept>  // for invalid_argument, out_of_range
+#include <string>     // for string
+
+#include <gtest/gtest.h>
+
+#include "signal_predicate.hpp"  // for SignalPredicate
+using engine::SignalPredicate;
+
+namespace {
+
+class SignalPredicateTest : public ::testing::Test {
+ protected:
+  SignalPredicate compile(const std::string& expr) {
+    return SignalPredicate(expr, [this](const std::string& name) -> SignalPredicate::Reader {
+      if (values.count(name) == 0) {
+        throw std::out_of_range("signal not found: " + name);
+      }
+      return [this, name]() { return values.at(name); };
+    });
+  }
+
+  static cloe::Duration ms(int x) { return cloe::Duration(x * 1'000'000LL); }
+
+  std::map<std::string, double> values{
+      {"a", 1.0},
+      {"b", 0.0},
+      {"vehicles.default.speed", 10.0},
+      {"and", 1.0},
+  };
+};
+
+}  // anonymous namespace
+
+TEST_F(SignalPredicateTest, compare) {
+  auto eval = [this](const std::string& expr) { return compile(expr)(ms(0)); };
+  EXPECT_TRUE(eval("a"));
+  EXPECT_FALSE(eval("b"));
+  EXPECT_TRUE(eval("a == 1"));
+  EXPECT_TRUE(eval("a != b"));
+  EXPECT_TRUE(eval("vehicles.default.speed >= 10"));
+  EXPECT_FALSE(eval("vehicles.default.speed > 10"));
+  EXPECT_TRUE(eval("b > -1.5"));
+  EXPECT_TRUE(eval("a > b && !b"));
+  EXPECT_TRUE(eval("b or not b and a < 2"));
+  EXPECT_FALSE(eval("!(a || b)"));
+  EXPECT_TRUE(eval("'and' == true"));
+
+  auto p = compile("a > b || a == vehicles.default.speed || b");
+  EXPECT_EQ(p.signals(), (std::vector<std::string>{"a", "b", "vehicles.default.speed"}));
+  values["a"] = -1.0;
+  EXPECT_FALSE(p(ms(0)));
+}
+
+TEST_F(SignalPredicateTest, invalid) {
+  for (auto expr : {"", "a >", "a = b", "(a", "a b", "a > 1 for 5", "a == 1 hysteresis 1", "and",
+                    "'a", "a # b", "a for 1xs"}) {
+    EXPECT_THROW(compile(expr), std::invalid_argument) << expr;
+  }
+  EXPECT_THROW(compile("a > unknown"), std::out_of_range);
+}
+
+TEST_F(SignalPredicateTest, hold) {
+  auto p = compile("vehicles.default.speed > 5 for 100ms");
+  EXPECT_FALSE(p(ms(0)));
+  EXPECT_FALSE(p(ms(80)));
+  EXPECT_TRUE(p(ms(100)));
+  EXPECT_TRUE(p(ms(120)));
+
+  // Any interruption restarts the duration.
+  values["vehicles.default.speed"] = 0.0;
+  EXPECT_FALSE(p(ms(140)));
+  values["vehicles.default.speed"] = 10.0;
+  EXPECT_FALSE(p(ms(160)));
+  EXPECT_TRUE(p(ms(260)));
+
+  // A copy keeps the state, but a reset forgets it.
+  auto q = p;
+  EXPECT_TRUE(q(ms(280)));
+  q.reset();
+  EXPECT_FALSE(q(ms(300)));
+  EXPECT_TRUE(p(ms(300)));
+}
+
+TEST_F(SignalPredicateTest, hold_precedence) {
+  // A hold binds tighter than negation and conjunction, so here it only
+  // applies to the comparison, and the negated hold is true right away.
+  auto p = compile("a > 0 && !(b > 0) for 1s");
+  EXPECT_TRUE(p(ms(0)));
+
+  // To hold the whole condition, it must be in parentheses.
+  auto q = compile("(a > 0 && !(b > 0)) for 1s");
+  EXPECT_FALSE(q(ms(0)));
+  EXPECT_FALSE(q(ms(500)));
+  EXPECT_TRUE(q(ms(1000)));
+
+  // Negation applies to the held comparison.
+  auto r = compile("!a > 0 for 1s");
+  EXPECT_TRUE(r(ms(0)));
+  EXPECT_FALSE(r(ms(1000)));
+}
+
+TEST_F(SignalPredicateTest, hysteresis) {
+  auto& x = values["a"];
+  auto p = compile("a > 5 hysteresis 2");
+  auto q = compile("a <= 5 hysteresis 2");
+  x = 5.0;
+  EXPECT_FALSE(p(ms(0)));
+  EXPECT_TRUE(q(ms(0)));
+  x = 6.0;
+  EXPECT_TRUE(p(ms(0)));
+  EXPECT_TRUE(q(ms(0)));
+  x = 7.5;
+  EXPECT_FALSE(q(ms(0)));
+  x = 4.0;
+  EXPECT_TRUE(p(ms(0)));
+  EXPECT_TRUE(q(ms(0)));
+  x = 3.0;
+  EXPECT_FALSE(p(ms(0)));
+  x = 4.0;
+  EXPECT_FALSE(p(ms(0)));
+}
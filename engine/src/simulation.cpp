@@ -78,11 +78,13 @@
 #include <filesystem>  // for filesystem::path
 #include <fstream>     // for ofstream
 #include <string>      // for string
+#include <tuple>       // for ignore
 #include <vector>      // for vector<>
 
-#include <cloe/data_broker.hpp>   // for DataBroker
-#include <fable/utility.hpp>      // for pretty_print
-#include <fable/utility/sol.hpp>  // for sol::object to_json
+#include <cloe/data_broker.hpp>    // for DataBroker
+#include <cloe/utility/timer.hpp>  // for DurationTimer
+#include <fable/utility.hpp>       // for pretty_print
+#include <fable/utility/sol.hpp>   // for sol::object to_json
 
 #include "coordinator.hpp"         // for Coordinator usage
 #include "lua_api.hpp"             // for luat_cloe_engine_state
@@ -92,6 +94,8 @@
 #include "simulation_probe.hpp"    // for SimulationProbe
 #include "simulation_result.hpp"   // for SimulationResult
 #include "utility/command.hpp"     // for CommandExecuter usage
+#include "utility/realtime.hpp"    // for set_thread_affinity, ...
+#include "utility/tracer.hpp"      // for Tracer
 
 namespace engine {
 
@@ -175,7 +179,18 @@ void Simulation::set_abort_handler(
   };
 }
 
+SimulationStartup Simulation::startup() const {
+  auto s = startup_;
+  for (const auto& kv : config_.get_all_plugins()) {
+    if (!kv.second->path().empty()) {
+      s.plugins[kv.second->path()] = kv.second->load_time();
+    }
+  }
+  return s;
+}
+
 SimulationResult Simulation::run() {
+  timer::DurationTimer<cloe::Duration> initialize_timer;
   auto machine = SimulationMachine();
   auto ctx = SimulationContext(config_, lua_.lua_state());
   auto errors = std::vector<std::string>();
@@ -186,11 +201,49 @@ SimulationResult Simulation::run() {
   try {
     ctx.uuid = uuid_;
     ctx.report_progress = report_progress_;
+    if (from_checkpoint_) {
+      ctx.from_checkpoint = from_checkpoint_->native();
+    }
+    ctx.coordinator->set_journal(journal_);
+    ctx.coordinator->set_replay(replay_);
+    if (replay_) {
+      ctx.replay = true;
+      ctx.sync.set_realtime_factor(-1.0);
+    }
+    if (config_.engine.output_file_trace) {
+      tracer_ = std::make_shared<Tracer>(config_.engine.trace_buffer_size);
+      ctx.tracer = tracer_;
+      ctx.coordinator->set_tracer(tracer_.get());
+      ctx.server->set_tracer(tracer_.get());
+    }
 
     // Start the server if enabled
+    const bool realtime = config_.engine.realtime_enable;
     if (config_.server.listen) {
+      // The server threads inherit the CPU affinity of this thread.
+      auto affinity = thread_affinity();
+      if (realtime) {
+        pin_thread("server", config_.engine.realtime_server_cpus);
+      }
       ctx.server->start();
+      if (realtime) {
+        pin_thread("simulation", affinity);
+      }
     }
+
+    // Pin and prioritize this thread, which runs the simulation states
+    if (realtime) {
+      ctx.pacer.emplace(config_.engine.realtime_spin_time);
+      pin_thread("simulation", config_.engine.realtime_cpus);
+      if (config_.engine.realtime_fifo_priority > 0) {
+        auto ec = set_thread_fifo_priority(config_.engine.realtime_fifo_priority);
+        if (ec) {
+          logger()->warn("Cannot schedule simulation thread with SCHED_FIFO priority {}: {}",
+                         config_.engine.realtime_fifo_priority, ec.message());
+        }
+      }
+    }
+
     // Stream data to the requested file
     if (config_.engine.output_file_data_stream) {
       auto filepath = get_output_filepath(*config_.engine.output_file_data_stream);
@@ -205,6 +258,8 @@ SimulationResult Simulation::run() {
     ctx.commander->set_enabled(config_.engine.security_enable_commands);
 
     // Run the simulation
+    ctx.startup = startup();
+    ctx.startup.add_phase("initialize", initialize_timer.elapsed());
     cloe::luat_cloe_engine_state(lua_)["is_running"] = true;
     machine.run(ctx);
     cloe::luat_cloe_engine_state(lua_)["is_running"] = false;
@@ -216,6 +271,11 @@ SimulationResult Simulation::run() {
     ctx.outcome = SimulationOutcome::Aborted;
   }
 
+  // The hooks and output after the simulation need no realtime priority.
+  if (config_.engine.realtime_enable && config_.engine.realtime_fifo_priority > 0) {
+    std::ignore = set_thread_fifo_priority(0);
+  }
+
   try {
     // Run post-disconnect hooks
     ctx.commander->set_enabled(config_.engine.security_enable_hooks);
@@ -235,10 +295,22 @@ SimulationResult Simulation::run() {
   result.outcome = ctx.outcome.value_or(SimulationOutcome::Aborted);
   assert(result.errors.empty()); // Not currently used in simulation.
   result.errors = errors;
+  result.startup = ctx.startup;
   return result;
 }
 
+void Simulation::pin_thread(const char* name, const std::vector<int>& cpus) const {
+  if (cpus.empty()) {
+    return;
+  }
+  auto ec = set_thread_affinity(cpus);
+  if (ec) {
+    logger()->warn("Cannot pin {} thread to configured CPUs: {}", name, ec.message());
+  }
+}
+
 SimulationProbe Simulation::probe() {
+  timer::DurationTimer<cloe::Duration> initialize_timer;
   auto machine = SimulationMachine();
   auto ctx = SimulationContext(config_, lua_.lua_state());
   auto errors = std::vector<std::string>();
@@ -260,6 +332,8 @@ SimulationProbe Simulation::probe() {
     ctx.commander->run_all(config_.engine.hooks_pre_connect);
 
     ctx.probe_simulation = true;
+    ctx.startup = startup();
+    ctx.startup.add_phase("initialize", initialize_timer.elapsed());
     machine.run(ctx);
   } catch (cloe::ConcludedError& e) {
     errors.emplace_back(e.what());
@@ -282,6 +356,7 @@ SimulationProbe Simulation::probe() {
   result.outcome = ctx.outcome.value_or(SimulationOutcome::Aborted);
   assert(result.errors.empty()); // Not currently used in simulation.
   result.errors = errors;
+  result.startup = ctx.startup;
   return result;
 }
 
@@ -305,6 +380,11 @@ size_t Simulation::write_output(const SimulationResult& r) const {
   write_file(config_.engine.output_file_result, r);
   write_file(config_.engine.output_file_config, config_);
   write_file(config_.engine.output_file_triggers, r.triggers);
+  if (config_.engine.output_file_trace && tracer_) {
+    if (write_trace_file(get_output_filepath(*config_.engine.output_file_trace))) {
+      files_written++;
+    }
+  }
   // write_file(config_.engine.output_file_signals, .signals);
   // write_file(config_.engine.output_file_signals_autocompletion, r.signals_autocompletion);
   logger()->info("Wrote {} output files.", files_written);
@@ -312,6 +392,24 @@ size_t Simulation::write_output(const SimulationResult& r) const {
   return files_written;
 }
 
+bool Simulation::write_trace_file(const std::filesystem::path& filepath) const {
+  if (!is_writable(filepath)) {
+    return false;
+  }
+  auto native = filepath.native();
+  std::ofstream ofs(native);
+  if (ofs.fail()) {
+    logger()->error("Error opening file for writing: {}", native);
+    return false;
+  }
+  logger()->debug("Writing file: {}", native);
+  if (auto n = tracer_->dropped(); n != 0) {
+    logger()->warn("Trace is missing the {} oldest events, see engine.trace.buffer_size", n);
+  }
+  tracer_->write_chrome_json(ofs);
+  return true;
+}
+
 bool Simulation::write_output_file(const std::filesystem::path& filepath,
                                    const cloe::Json& j) const {
   if (!is_writable(filepath)) {
@@ -24,17 +24,26 @@
 
 #include <filesystem>  // for path
 #include <functional>  // for function<>
+#include <memory>      // for shared_ptr<>
 #include <optional>    // for optional<>
+#include <string>      // for string
+#include <utility>     // for move
+#include <vector>      // for vector<>
 
 #include <cloe/stack.hpp>      // for Stack
 #include <sol/state_view.hpp>  // for state_view
 
+#include "simulation_startup.hpp"  // for SimulationStartup
+
 namespace engine {
 
 class SimulationContext;
 class SimulationMachine;
 class SimulationResult;
 class SimulationProbe;
+class InputJournal;
+class InputJournalWriter;
+class Tracer;
 
 class Simulation {
  public:
@@ -75,6 +84,11 @@ class Simulation {
    */
   bool write_output_file(const std::filesystem::path& filepath, const cloe::Json& j) const;
 
+  /**
+   * Write the trace of the last run into the file. Return true if successful.
+   */
+  bool write_trace_file(const std::filesystem::path& filepath) const;
+
   /**
    * Check if the given filepath may be opened, respecting clobber options.
    */
@@ -85,6 +99,36 @@ class Simulation {
    */
   void set_report_progress(bool value) { report_progress_ = value; }
 
+  /**
+   * Record the time of a startup phase that took place before the
+   * simulation was created, such as reading the configuration.
+   */
+  void add_startup_phase(std::string name, cloe::Duration d) {
+    startup_.add_phase(std::move(name), d);
+  }
+
+  /**
+   * Continue the simulation from the checkpoint file instead of starting it
+   * from the beginning.
+   *
+   * The stack must contain the same models as the simulation from which the
+   * checkpoint was taken.
+   */
+  void set_from_checkpoint(const std::filesystem::path& filepath) { from_checkpoint_ = filepath; }
+
+  /**
+   * Record the triggers inserted via the network in the journal.
+   */
+  void set_journal(std::shared_ptr<InputJournalWriter> journal) { journal_ = std::move(journal); }
+
+  /**
+   * Replay the triggers of the journal at unlimited speed.
+   *
+   * The stack and Lua scripts must be the same as those of the simulation
+   * from which the journal was recorded.
+   */
+  void set_replay(std::shared_ptr<InputJournal> replay) { replay_ = std::move(replay); }
+
   /**
    * Abort the simulation from a separate thread.
    *
@@ -125,6 +169,20 @@ class Simulation {
   void set_abort_handler(SimulationMachine& machine, SimulationContext& ctx,
                          std::function<void()> hook);
 
+  /**
+   * Restrict the calling thread to the given CPUs, unless empty.
+   *
+   * If this is not possible, a warning is logged and the simulation
+   * continues without.
+   */
+  void pin_thread(const char* name, const std::vector<int>& cpus) const;
+
+  /**
+   * Return the startup phases so far, including the time to load each
+   * plugin.
+   */
+  SimulationStartup startup() const;
+
   /**
    * Reset the abort handler before it becomes invalid.
    */
@@ -140,6 +198,13 @@ class Simulation {
 
   // Options:
   bool report_progress_{false};
+  std::optional<std::filesystem::path> from_checkpoint_;
+  std::shared_ptr<InputJournalWriter> journal_;
+  std::shared_ptr<InputJournal> replay_;
+  SimulationStartup startup_;
+
+  // Output:
+  std::shared_ptr<Tracer> tracer_;
 };
 
 }  // namespace engine
@@ -63,4 +63,9 @@ DEFINE_SET_DATA_ACTION(RealtimeFactor, "realtime_factor", "modify the simulation
                          ptr_->set_realtime_factor(value_);
                        })
 
+DEFINE_SET_DATA_ACTION(Checkpoint, "checkpoint", "write simulation checkpoint after this step",
+                       SimulationContext, "path", std::string, {
+                         ptr_->checkpoint_requests.push_back(value_);
+                       })
+
 }  // namespace engine::actions
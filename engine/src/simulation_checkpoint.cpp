@@ -0,0 +1,229 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file simulation_checkpoint.cpp
+ * \see  simulation_checkpoint.hpp
+ */
+
+#include "simulation_checkpoint.hpp"
+
+#include <fstream>     // for ifstream, ofstream
+#include <functional>  // for function<>
+#include <iterator>    // for istreambuf_iterator<>
+#include <set>         // for set<>
+#include <utility>     // for move
+
+#include <fable/utility/sol.hpp>  // for into_sol_object, to_json
+#include <sol/object.hpp>         // for object
+#include <sol/table.hpp>          // for table
+
+#include <cloe/checkpoint.hpp>  // for CheckpointWriter, CheckpointReader, CheckpointError
+#include <cloe/component.hpp>   // for Component
+#include <cloe/controller.hpp>  // for Controller
+#include <cloe/simulator.hpp>   // for Simulator
+#include <cloe/vehicle.hpp>     // for Vehicle
+
+#include "coordinator.hpp"         // for Coordinator::pending_triggers, ...
+#include "lua_api.hpp"             // for luat_cloe_engine_state
+#include "simulation_context.hpp"  // for SimulationContext
+
+namespace engine {
+
+namespace {
+
+constexpr std::string_view MAGIC = "CLOECKPT";
+
+/**
+ * Call f for each model whose state is part of a checkpoint, together with
+ * its path in the checkpoint.
+ *
+ * Simulators and controllers are always part of a checkpoint. Components are
+ * only part of it if they support checkpoints, and only once if they are
+ * available by several aliases.
+ */
+void foreach_checkpoint_model(SimulationContext& ctx,
+                              const std::function<void(const std::string&, cloe::Model&)>& f) {
+  for (auto& kv : ctx.simulators) {
+    f("simulators/" + kv.first, *kv.second);
+  }
+  for (auto& kv : ctx.vehicles) {
+    std::set<uint64_t> ids;
+    for (const auto& key : kv.second->component_names()) {
+      auto c = kv.second->get<cloe::Component>(key);
+      if (c->is_checkpointable() && ids.insert(c->id()).second) {
+        f("vehicles/" + kv.first + "/components/" + key, *c);
+      }
+    }
+  }
+  for (auto& kv : ctx.controllers) {
+    f("controllers/" + kv.first, *kv.second);
+  }
+}
+
+}  // anonymous namespace
+
+std::string SimulationCheckpoint::serialize() const {
+  cloe::CheckpointWriter w;
+  w.write_bytes(MAGIC.data(), MAGIC.size());
+  w.write(FORMAT_VERSION);
+  w.write(step);
+  w.write(time.count());
+  w.write(eta.count());
+  w.write(realtime_factor);
+  w.write<uint64_t>(models.size());
+  for (const auto& kv : models) {
+    w.write(kv.first);
+    w.write(kv.second);
+  }
+  w.write(triggers.dump());
+  w.write(report.dump());
+  return w.release();
+}
+
+SimulationCheckpoint SimulationCheckpoint::deserialize(std::string_view blob) {
+  cloe::CheckpointReader r(blob);
+  std::string magic(MAGIC.size(), '\0');
+  r.read_bytes(magic.data(), magic.size());
+  if (magic != MAGIC) {
+    throw cloe::CheckpointError("not a simulation checkpoint");
+  }
+  auto version = r.read<uint32_t>();
+  if (version != FORMAT_VERSION) {
+    throw cloe::CheckpointError("unsupported checkpoint format version {}, expected {}", version,
+                                FORMAT_VERSION);
+  }
+
+  SimulationCheckpoint c;
+  r.read(c.step);
+  c.time = cloe::Duration(r.read<cloe::Duration::rep>());
+  c.eta = cloe::Duration(r.read<cloe::Duration::rep>());
+  r.read(c.realtime_factor);
+  auto n = r.read<uint64_t>();
+  for (uint64_t i = 0; i < n; ++i) {
+    std::string path, state;
+    r.read(path);
+    r.read(state);
+    c.models.emplace(std::move(path), std::move(state));
+  }
+  std::string tmp;
+  r.read(tmp);
+  c.triggers = cloe::Json::parse(tmp);
+  r.read(tmp);
+  c.report = cloe::Json::parse(tmp);
+  if (!r.at_end()) {
+    throw cloe::CheckpointError("checkpoint has {} unexpected trailing bytes", r.remaining());
+  }
+  return c;
+}
+
+void to_json(cloe::Json& j, const SimulationCheckpoint& c) {
+  std::vector<std::string> models;
+  for (const auto& kv : c.models) {
+    models.emplace_back(kv.first);
+  }
+  j = cloe::Json{
+      {"step", c.step},
+      {"time", cloe::to_convenient_json(c.time)},
+      {"models", models},
+      {"num_triggers", c.triggers.size()},
+  };
+}
+
+SimulationCheckpoint capture_checkpoint(SimulationContext& ctx) {
+  SimulationCheckpoint c;
+  c.step = ctx.sync.step();
+  c.time = ctx.sync.time();
+  c.eta = ctx.sync.eta();
+  c.realtime_factor = ctx.sync.realtime_factor();
+  foreach_checkpoint_model(ctx, [&c](const std::string& path, cloe::Model& m) {
+    if (!m.is_checkpointable()) {
+      throw cloe::CheckpointError("cannot checkpoint {}: model does not support checkpoints",
+                                  path);
+    }
+    cloe::CheckpointWriter w;
+    m.save_state(w);
+    c.models.emplace(path, w.release());
+  });
+  c.triggers = ctx.coordinator->pending_triggers();
+  c.report = sol::object(cloe::luat_cloe_engine_state(ctx.lua)["report"]);
+  return c;
+}
+
+void restore_checkpoint(SimulationContext& ctx, const SimulationCheckpoint& c) {
+  ctx.sync.set_step(c.step, c.time);
+  ctx.sync.set_eta(c.eta);
+  ctx.sync.set_realtime_factor(c.realtime_factor);
+
+  size_t restored = 0;
+  foreach_checkpoint_model(ctx, [&](const std::string& path, cloe::Model& m) {
+    auto it = c.models.find(path);
+    if (it == c.models.end()) {
+      throw cloe::CheckpointError("cannot restore {}: model not in checkpoint", path);
+    }
+    cloe::CheckpointReader r(it->second);
+    m.load_state(r);
+    if (!r.at_end()) {
+      throw cloe::CheckpointError("cannot restore {}: model did not read {} bytes of its state",
+                                  path, r.remaining());
+    }
+    restored++;
+  });
+  if (restored != c.models.size()) {
+    throw cloe::CheckpointError("cannot restore checkpoint: {} of its models are not in simulation",
+                                c.models.size() - restored);
+  }
+
+  auto n = ctx.coordinator->restore_triggers(c.triggers, ctx.sync);
+  if (n != c.triggers.size()) {
+    ctx.logger()->warn("Restored {} of {} pending triggers from checkpoint", n,
+                       c.triggers.size());
+  }
+
+  // Lua code may hold references to the report table, so it is updated in
+  // place instead of being replaced.
+  sol::table report = cloe::luat_cloe_engine_state(ctx.lua)["report"];
+  report.clear();
+  if (c.report.is_object()) {
+    for (const auto& kv : c.report.items()) {
+      report[kv.key()] = fable::into_sol_object(ctx.lua, kv.value());
+    }
+  }
+}
+
+void write_checkpoint_file(const std::filesystem::path& filepath, const SimulationCheckpoint& c) {
+  std::ofstream ofs(filepath, std::ios::binary | std::ios::trunc);
+  if (!ofs) {
+    throw cloe::CheckpointError("cannot open checkpoint file for writing: {}", filepath.native());
+  }
+  auto blob = c.serialize();
+  ofs.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+  if (!ofs) {
+    throw cloe::CheckpointError("cannot write checkpoint file: {}", filepath.native());
+  }
+}
+
+SimulationCheckpoint read_checkpoint_file(const std::filesystem::path& filepath) {
+  std::ifstream ifs(filepath, std::ios::binary);
+  if (!ifs) {
+    throw cloe::CheckpointError("cannot open checkpoint file: {}", filepath.native());
+  }
+  std::string blob{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+  return SimulationCheckpoint::deserialize(blob);
+}
+
+}  // namespace engine
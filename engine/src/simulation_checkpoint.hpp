@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file simulation_checkpoint.hpp
+ * \see  simulation_checkpoint.cpp
+ * \see  simulation_checkpoint_test.cpp
+ *
+ * This file defines simulation checkpoints, from which several variants of
+ * a simulation can be continued without simulating the common lead-in again.
+ */
+
+#pragma once
+
+#include <cstdint>      // for uint32_t, uint64_t
+#include <filesystem>   // for path
+#include <map>          // for map<>
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include <cloe/core.hpp>  // for Duration, Json
+
+namespace engine {
+
+class SimulationContext;
+
+/**
+ * SimulationCheckpoint is the state of a simulation between two steps.
+ *
+ * It consists of the simulation sync, the state of each model as saved by
+ * Model::save_state, the pending triggers, and the Lua report table.
+ */
+struct SimulationCheckpoint {
+  /// Incremented whenever the serialized format changes.
+  static constexpr uint32_t FORMAT_VERSION = 1;
+
+  // Sync:
+  uint64_t step{0};
+  cloe::Duration time{0};
+  cloe::Duration eta{0};
+  double realtime_factor{1.0};
+
+  /// Model states by path, such as "simulators/minimator" or
+  /// "vehicles/default/components/cloe::default_world_sensor".
+  std::map<std::string, std::string> models;
+
+  /// Pending triggers, as returned by Coordinator::pending_triggers.
+  cloe::Json triggers;
+
+  /// Contents of the Lua table cloe.state.report.
+  cloe::Json report;
+
+  /**
+   * Return the checkpoint as binary blob.
+   */
+  [[nodiscard]] std::string serialize() const;
+
+  /**
+   * Return the checkpoint from the binary blob created by serialize.
+   *
+   * Throws CheckpointError if the blob is not a valid checkpoint.
+   */
+  [[nodiscard]] static SimulationCheckpoint deserialize(std::string_view blob);
+
+  friend void to_json(cloe::Json& j, const SimulationCheckpoint& c);
+};
+
+/**
+ * Return a checkpoint of the simulation.
+ *
+ * This must be called between two steps. Throws CheckpointError if a
+ * simulator or controller does not support checkpoints.
+ */
+SimulationCheckpoint capture_checkpoint(SimulationContext& ctx);
+
+/**
+ * Continue the simulation from the checkpoint.
+ *
+ * This must be called after all models have been started. Throws
+ * CheckpointError if the models of the simulation do not match those of the
+ * checkpoint.
+ */
+void restore_checkpoint(SimulationContext& ctx, const SimulationCheckpoint& c);
+
+void write_checkpoint_file(const std::filesystem::path& filepath, const SimulationCheckpoint& c);
+
+[[nodiscard]] SimulationCheckpoint read_checkpoint_file(const std::filesystem::path& filepath);
+
+}  // namespace engine
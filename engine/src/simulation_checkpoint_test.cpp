@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file simulation_checkpoint_test.cpp
+ * \see  simulation_checkpoint.hpp
+ */
+
+#include <string>  // for string
+
+#include <gtest/gtest.h>
+
+#include <cloe/checkpoint.hpp>  // for CheckpointError
+
+#include "simulation_checkpoint.hpp"  // for SimulationCheckpoint
+
+using engine::SimulationCheckpoint;
+
+TEST(engine_simulation_checkpoint, serialize) {
+  SimulationCheckpoint c;
+  c.step = 251;
+  c.time = cloe::Duration(5'020'000'000);
+  c.eta = cloe::Duration(60'000'000'000);
+  c.realtime_factor = -1.0;
+  c.models["simulators/minimator"] = std::string("\0\1\2", 3);
+  c.models["controllers/nop"] = "";
+  c.triggers = cloe::Json::array({{{"event", "time=10"}, {"action", "stop"}}});
+  c.report = cloe::Json{{"checks", 3}};
+
+  auto d = SimulationCheckpoint::deserialize(c.serialize());
+  EXPECT_EQ(d.step, c.step);
+  EXPECT_EQ(d.time, c.time);
+  EXPECT_EQ(d.eta, c.eta);
+  EXPECT_EQ(d.realtime_factor, c.realtime_factor);
+  EXPECT_EQ(d.models, c.models);
+  EXPECT_EQ(d.triggers, c.triggers);
+  EXPECT_EQ(d.report, c.report);
+}
+
+TEST(engine_simulation_checkpoint, deserialize_invalid) {
+  EXPECT_THROW(SimulationCheckpoint::deserialize("not a checkpoint"), cloe::CheckpointError);
+
+  auto blob = SimulationCheckpoint{}.serialize();
+  EXPECT_THROW(SimulationCheckpoint::deserialize(blob.substr(0, blob.size() - 1)),
+               cloe::CheckpointError);
+  EXPECT_THROW(SimulationCheckpoint::deserialize(blob + "x"), cloe::CheckpointError);
+}
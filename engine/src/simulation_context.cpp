@@ -18,17 +18,19 @@
 
 #include "simulation_context.hpp"
 
-#include <memory>  // for make_unique<>
+#include <algorithm>  // for min
+#include <memory>     // for make_unique<>
 
 #include <cloe/controller.hpp>   // for Controller
 #include <cloe/data_broker.hpp>  // for DataBroker
 #include <cloe/simulator.hpp>    // for Simulator
 #include <cloe/vehicle.hpp>      // for Vehicle
 
-#include "coordinator.hpp"      // for Coordinator
-#include "registrar.hpp"        // for Registrar
-#include "server.hpp"           // for Server
-#include "utility/command.hpp"  // for CommandExecuter
+#include "coordinator.hpp"        // for Coordinator
+#include "registrar.hpp"          // for Registrar
+#include "server.hpp"             // for Server
+#include "simulation_events.hpp"  // for LoopCallback, TimeCallback
+#include "utility/command.hpp"    // for CommandExecuter
 
 namespace engine {
 
@@ -196,4 +198,31 @@ bool SimulationContext::foreach_controller(std::function<bool(const cloe::Contro
   return true;
 }
 
+cloe::Duration SimulationContext::next_model_wakeup() const {
+  auto wakeup = cloe::Duration::max();
+  for (const auto& kv : simulators) {
+    wakeup = std::min(wakeup, kv.second->next_wakeup(sync));
+  }
+  for (const auto& kv : vehicles) {
+    wakeup = std::min(wakeup, kv.second->next_wakeup(sync));
+  }
+  for (const auto& kv : controllers) {
+    const auto& ctrl = *kv.second;
+    if (!ctrl.has_vehicle()) {
+      continue;
+    }
+    const auto& sched = controller_schedulers.at(&ctrl);
+    wakeup = std::min(wakeup, sched.next_wakeup(ctrl.next_wakeup(sync)));
+  }
+  return wakeup;
+}
+
+cloe::Duration SimulationContext::next_trigger_wakeup() const {
+  // Loop and predicate triggers are evaluated in every step.
+  if (!callback_loop->empty() || !callback_predicate->empty()) {
+    return sync.time();
+  }
+  return callback_time->next_time();
+}
+
 }  // namespace engine
@@ -32,6 +32,7 @@
 #include <sol/state_view.hpp>  // for state_view
 
 #include <cloe/cloe_fwd.hpp>       // for Simulator, Controller, Registrar, Vehicle, Duration
+#include <cloe/schedule.hpp>       // for Scheduler
 #include <cloe/stack.hpp>          // for Stack
 #include <cloe/utility/timer.hpp>  // for DurationTimer
 
@@ -40,8 +41,10 @@
 #include "simulation_probe.hpp"       // for SimulationProbe
 #include "simulation_progress.hpp"    // for SimulationProgress
 #include "simulation_result.hpp"      // for SimulationResult
+#include "simulation_startup.hpp"     // for SimulationStartup
 #include "simulation_statistics.hpp"  // for SimulationStatistics
 #include "simulation_sync.hpp"        // for SimulationSync
+#include "utility/realtime.hpp"       // for Pacer
 
 namespace engine {
 
@@ -52,6 +55,7 @@ class Coordinator;
 class Server;
 class SimulationResult;
 class SimulationProbe;
+class Tracer;
 
 /**
  * SimulationContext represents the entire context of a running simulation
@@ -88,6 +92,14 @@ struct SimulationContext {
   /// here though, so make sure they are handled.
   bool probe_simulation{false};
 
+  /// Continue the simulation from the checkpoint file at this path instead
+  /// of starting it from the beginning.
+  std::optional<std::string> from_checkpoint;
+
+  /// Replay the simulation from an input journal at unlimited speed,
+  /// regardless of any realtime factor set during the simulation.
+  bool replay{false};
+
   // Setup -------------------------------------------------------------------
   //
   // These are functional parts of the simulation framework that mostly come
@@ -102,6 +114,9 @@ struct SimulationContext {
   /// Configurable system command executer for triggers.
   std::unique_ptr<CommandExecuter> commander;
 
+  /// Timeline of the simulation, if tracing is enabled.
+  std::shared_ptr<Tracer> tracer;
+
   // State -------------------------------------------------------------------
   //
   // These are the types that represent the simulation state and have no
@@ -125,16 +140,31 @@ struct SimulationContext {
   std::map<std::string, std::shared_ptr<cloe::Vehicle>> vehicles;
   std::map<std::string, std::unique_ptr<cloe::Controller>> controllers;
 
+  /// Schedulers of the controllers, which decide in which steps each
+  /// controller is processed.
+  std::map<const cloe::Controller*, cloe::Scheduler> controller_schedulers;
+
   timer::DurationTimer<cloe::Duration> cycle_duration;
 
+  /// Pace steps with absolute deadlines, if realtime mode is enabled.
+  std::optional<Pacer> pacer;
+
   /// Tell the simulation that we want to transition into the PAUSE state.
   ///
   /// We can't do this directly via an interrupt because we can only go
   /// into the PAUSE state after STEP_END.
   bool pause_execution{false};
 
+  /// Paths to which a checkpoint should be written at the end of the
+  /// current step.
+  ///
+  /// Checkpoints can only be taken between steps, so the checkpoint action
+  /// only stores the request here, and STEP_END writes it.
+  std::vector<std::string> checkpoint_requests;
+
   // Output ------------------------------------------------------------------
   SimulationStatistics statistics;
+  SimulationStartup startup;
   std::optional<SimulationOutcome> outcome;
   std::optional<SimulationResult> result;
   std::optional<SimulationProbe> probe;
@@ -155,6 +185,7 @@ struct SimulationContext {
   std::shared_ptr<events::FailureCallback> callback_failure;
   std::shared_ptr<events::ResetCallback> callback_reset;
   std::shared_ptr<events::TimeCallback> callback_time;
+  std::shared_ptr<events::PredicateCallback> callback_predicate;
 
  public:
   // Helper Methods ----------------------------------------------------------
@@ -182,6 +213,23 @@ struct SimulationContext {
   bool foreach_controller(std::function<bool(const cloe::Controller&)> f) const;
   bool foreach_vehicle(std::function<bool(cloe::Vehicle&)> f);
   bool foreach_vehicle(std::function<bool(const cloe::Vehicle&)> f) const;
+
+  /**
+   * Return the earliest time at which any model needs to be processed again,
+   * after all models have processed the current step.
+   *
+   * \see cloe::Model::next_wakeup
+   */
+  cloe::Duration next_model_wakeup() const;
+
+  /**
+   * Return the earliest time at which a trigger of the engine may need to
+   * be executed.
+   *
+   * Triggers of other events are executed by the models that own them, and
+   * are thus covered by next_model_wakeup.
+   */
+  cloe::Duration next_trigger_wakeup() const;
 };
 
 }  // namespace engine
@@ -18,20 +18,30 @@
 /**
  * \file simulation_events.hpp
  *
- * This file defines the "time" and "next" events.
+ * This file defines the "time", "next", and "predicate" events.
  */
 
 #pragma once
 
-#include <chrono>  // for duration_cast<>
-#include <memory>  // for unique_ptr<>, make_unique<>
-#include <queue>   // for priority_queue<>
+#include <chrono>     // for duration_cast<>, round<>
+#include <cstdint>    // for int8_t, ..., uint64_t
+#include <list>       // for list<>
+#include <memory>     // for unique_ptr<>, make_unique<>
+#include <optional>   // for optional<>
+#include <queue>      // for priority_queue<>
+#include <stdexcept>  // for invalid_argument
+#include <string>     // for string
+#include <typeinfo>   // for typeid
+#include <utility>    // for move
 
 #include <cloe/core.hpp>               // for Json, Duration, Seconds
+#include <cloe/data_broker.hpp>        // for DataBroker, SignalPtr
 #include <cloe/sync.hpp>               // for Sync
 #include <cloe/trigger.hpp>            // for Trigger, Event, EventFactory, ...
 #include <cloe/trigger/nil_event.hpp>  // for DEFINE_NIL_EVENT
 
+#include "signal_predicate.hpp"  // for SignalPredicate
+
 namespace engine::events {
 
 DEFINE_NIL_EVENT(Start, "start", "start of simulation")
@@ -130,6 +140,12 @@ class TimeCallback : public cloe::Callback {
     storage_.emplace(std::make_shared<TimeTrigger>(when, std::move(t)));
   }
 
+  void clear() override {
+    while (!storage_.empty()) {
+      storage_.pop();
+    }
+  }
+
   void to_json(cloe::Json& j) const override {
     // Make a copy of the storage, and then empty it.
     decltype(storage_) st_copy{storage_};
@@ -139,6 +155,14 @@ class TimeCallback : public cloe::Callback {
     }
   }
 
+  /**
+   * Return the time of the earliest trigger, or Duration::max() if there
+   * are none.
+   */
+  cloe::Duration next_time() const {
+    return storage_.empty() ? cloe::Duration::max() : storage_.top()->time;
+  }
+
   void trigger(const cloe::Sync& sync) {
     auto now = sync.time();
     while (!storage_.empty() && storage_.top()->time <= now) {
@@ -210,4 +234,201 @@ class NextCallback : public cloe::AliasCallback {
   }
 };
 
+/**
+ * PredicateEvent is true when its signal predicate is true, or when the
+ * optional timeout has passed.
+ *
+ * The predicate is compiled once when the trigger is created and then
+ * evaluated natively each step, which is much cheaper than evaluating the
+ * same condition in a Lua "loop" trigger.
+ *
+ * Events can be put in a named group, of which only the first to be true
+ * fires; see PredicateCallback.
+ */
+class PredicateEvent : public cloe::Event {
+ public:
+  PredicateEvent(const std::string& name, SignalPredicate p, std::optional<cloe::Duration> timeout,
+                 std::string group = "")
+      : Event(name), predicate_(std::move(p)), timeout_(timeout), group_(std::move(group)) {}
+  cloe::EventPtr clone() const override { return std::make_unique<PredicateEvent>(*this); }
+  void to_json(cloe::Json& j) const override {
+    j = cloe::Json{
+        {"expression", predicate_.expression()},
+    };
+    if (timeout_) {
+      j["timeout"] = cloe::Seconds{*timeout_}.count();
+    }
+    if (!group_.empty()) {
+      j["group"] = group_;
+    }
+  }
+
+  const std::string& group() const { return group_; }
+
+  bool operator()(const cloe::Sync& sync) {
+    // The predicate is evaluated first so that its held conditions stay
+    // up-to-date, and so that it wins over a timeout in the same step.
+    auto now = sync.time();
+    if (predicate_(now)) {
+      return true;
+    }
+    return timeout_ && now > *timeout_;
+  }
+
+ private:
+  SignalPredicate predicate_;
+  std::optional<cloe::Duration> timeout_;
+  std::string group_;
+};
+
+class PredicateFactory : public cloe::EventFactory {
+ public:
+  using EventType = PredicateEvent;
+
+  explicit PredicateFactory(const cloe::DataBroker* db)
+      : cloe::EventFactory("predicate", "when signal predicate is true"), db_(db) {}
+
+  cloe::TriggerSchema schema() const override {
+    using namespace cloe::schema;  // NOLINT(build/namespaces)
+    static const char* desc = "predicate over signals, such as 'x > 5 for 1s'";
+    return cloe::TriggerSchema{
+        this->name(),
+        this->description(),
+        cloe::InlineSchema(desc, "expression", true),
+        cloe::Schema{
+            {"expression", String(nullptr, desc).require()},
+            {"timeout", Number<double>(nullptr, "absolute number of seconds in simulation time "
+                                                "after which the event is true regardless")},
+            {"group", String(nullptr, "name of group in which only the first event fires")},
+        },
+    };
+  }
+
+  cloe::EventPtr make(const cloe::Conf& c) const override {
+    try {
+      std::optional<cloe::Duration> timeout;
+      if (c.has("timeout")) {
+        timeout = std::chrono::round<cloe::Duration>(cloe::Seconds{c.get<double>("timeout")});
+      }
+      SignalPredicate p(c.get<std::string>("expression"),
+                        [this](const std::string& signal) { return reader(signal); });
+      return std::make_unique<PredicateEvent>(name(), std::move(p), timeout,
+                                              c.get_or<std::string>("group", ""));
+    } catch (std::exception& e) {
+      throw cloe::TriggerInvalid(c, e.what());
+    }
+  }
+
+  cloe::EventPtr make(const std::string& s) const override {
+    return make(cloe::Conf{cloe::Json{
+        {"expression", s},
+    }});
+  }
+
+ private:
+  /**
+   * Set r to read the signal if it has type T and return true.
+   *
+   * A signal without a getter is rejected here, since reading it would
+   * otherwise throw in every step. The caller turns this into
+   * TriggerInvalid.
+   */
+  template <typename T>
+  static bool make_reader(const cloe::SignalPtr& s, SignalPredicate::Reader& r) {
+    if (*s->type() != typeid(T)) {
+      return false;
+    }
+    const auto* getter = s->getter<T>();
+    if (getter == nullptr || !*getter) {
+      throw std::invalid_argument("signal does not have a getter: " + s->name());
+    }
+    r = [s]() { return static_cast<double>(s->value<T>()); };
+    return true;
+  }
+
+  SignalPredicate::Reader reader(const std::string& signal) const {
+    auto s = db_->signal(signal);
+    SignalPredicate::Reader r;
+    if (s->type() == nullptr ||
+        !(make_reader<bool>(s, r) || make_reader<double>(s, r) || make_reader<float>(s, r) ||
+          make_reader<int8_t>(s, r) || make_reader<int16_t>(s, r) ||
+          make_reader<int32_t>(s, r) || make_reader<int64_t>(s, r) ||
+          make_reader<uint8_t>(s, r) || make_reader<uint16_t>(s, r) ||
+          make_reader<uint32_t>(s, r) || make_reader<uint64_t>(s, r))) {
+      throw std::invalid_argument("signal does not have a numeric or boolean type: " + signal);
+    }
+    return r;
+  }
+
+ private:
+  const cloe::DataBroker* db_;
+};
+
+/**
+ * PredicateCallback works like DirectCallback, except that when an event in
+ * a group fires, all other triggers of the same group are removed.
+ *
+ * This lets a condition and a timeout be inserted as two triggers of which
+ * only one fires, and since triggers are evaluated in the order they were
+ * inserted, the first one wins if both are true in the same step.
+ */
+class PredicateCallback : public cloe::Callback {
+ public:
+  size_t size() const { return triggers_.size(); }
+  bool empty() const { return triggers_.empty(); }
+
+  void emplace(cloe::TriggerPtr&& t, const cloe::Sync&) override {
+    triggers_.emplace_back(std::move(t));
+  }
+  void clear() override { triggers_.clear(); }
+  void to_json(cloe::Json& j) const override { j = triggers_; }
+
+  void trigger(const cloe::Sync& sync) {
+    auto it = triggers_.begin();
+    while (it != triggers_.end()) {
+      auto& condition = dynamic_cast<PredicateEvent&>((*it)->event());
+      if (!condition(sync)) {
+        ++it;
+        continue;
+      }
+
+      // Remove the rest of the group before executing the action, since the
+      // action may insert new triggers with the same group.
+      if (!condition.group().empty()) {
+        remove_group(condition.group(), it);
+      }
+      if ((*it)->is_sticky()) {
+        auto result = this->execute((*it)->clone(), sync);
+        if (result == cloe::CallbackResult::Unpin) {
+          it = triggers_.erase(it);
+          continue;
+        }
+      } else {
+        // Remove from trigger list and advance.
+        this->execute(std::move(*it), sync);
+        it = triggers_.erase(it);
+        continue;
+      }
+      ++it;
+    }
+  }
+
+ private:
+  using Iterator = std::list<cloe::TriggerPtr>::iterator;
+
+  void remove_group(const std::string& group, Iterator keep) {
+    auto it = triggers_.begin();
+    while (it != triggers_.end()) {
+      if (it != keep && dynamic_cast<PredicateEvent&>((*it)->event()).group() == group) {
+        it = triggers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+ private:
+  std::list<cloe::TriggerPtr> triggers_;
+};
+
 }  // namespace engine::events
@@ -74,12 +74,18 @@
 
 #pragma once
 
-#include <future>  // for future<>, async
+#include <chrono>         // for milliseconds
+#include <cstdlib>        // for abort
+#include <optional>       // for optional<>
+#include <stdexcept>      // for logic_error
+#include <unordered_map>  // for unordered_map<>
 
 #include <cloe/core/abort.hpp>  // for AsyncAbort
 
 #include "simulation_context.hpp"     // for SimulationContext
 #include "utility/state_machine.hpp"  // for State, StateMachine
+#include "utility/tracer.hpp"         // for TraceSpan
+#include "utility/watchdog.hpp"       // for Watchdog
 
 namespace engine {
 
@@ -139,6 +145,21 @@ class SimulationMachine
     StateId id = initial;
     std::optional<StateId> interrupt;
 
+    // The watchdog monitors the states from its own thread, while the states
+    // keep running in this thread.
+    std::optional<Watchdog> watchdog;
+    if (ctx.config.engine.watchdog_mode != cloe::WatchdogMode::Off) {
+      watchdog.emplace(ctx.config.engine.polling_interval,
+                       [this, &ctx](StateId timed_out, std::chrono::milliseconds timeout) {
+                         this->handle_watchdog_timeout(timed_out, timeout, ctx);
+                       });
+    }
+    auto arm_watchdog = [&](StateId next) {
+      if (watchdog) {
+        watchdog->arm(next, this->watchdog_timeout(next, ctx));
+      }
+    };
+
     // Keep processing states as long as they are coming either from
     // an interrupt or from normal execution.
     while ((interrupt = pop_interrupt()) || id != nullptr) {
@@ -149,17 +170,15 @@ class SimulationMachine
         // If one interrupt follows another, the handler is responsible
         // for restoring nominal flow after all is done.
         if (interrupt) {
+          arm_watchdog(*interrupt);
+          TraceSpan span(ctx.tracer.get(), "state", *interrupt);
           id = handle_interrupt(id, *interrupt, ctx);
           continue;
         }
 
-        if (ctx.config.engine.watchdog_mode == cloe::WatchdogMode::Off) {
-          // Run state in this thread synchronously.
-          id = run_state(id, ctx);
-          continue;
-        }
-
-        id = run_state_async(id, ctx);
+        arm_watchdog(id);
+        TraceSpan span(ctx.tracer.get(), "state", id);
+        id = run_state(id, ctx);
       } catch (cloe::AsyncAbort&) {
         this->push_interrupt(ABORT);
       } catch (cloe::ModelReset& e) {
@@ -182,49 +201,48 @@ class SimulationMachine
   }
 
   /**
-   * Run state in a separate thread asynchronously and abort if
-   * watchdog_timeout is exceeded.
+   * Return the watchdog timeout for the state id.
+   *
+   * The timeouts are looked up once per state, since the configuration
+   * is keyed by string.
    *
    * See configuration: stack.hpp
    * See documentation: doc/reference/watchdog.rst
    */
-  StateId run_state_async(StateId id, SimulationContext& ctx) {
-    std::chrono::milliseconds timeout = ctx.config.engine.watchdog_default_timeout;
-    if (ctx.config.engine.watchdog_state_timeouts.count(id)) {
-      auto maybe = ctx.config.engine.watchdog_state_timeouts[id];
-      if (maybe) {
-        timeout = *maybe;
-      }
+  std::chrono::milliseconds watchdog_timeout(StateId id, const SimulationContext& ctx) {
+    auto it = watchdog_timeouts_.find(id);
+    if (it != watchdog_timeouts_.end()) {
+      return it->second;
     }
-    auto interval = timeout.count() > 0 ? timeout : ctx.config.engine.polling_interval;
-
-    // Launch state
-    std::future<StateId> f =
-        std::async(std::launch::async, [this, id, &ctx]() { return run_state(id, ctx); });
 
-    std::future_status status;
-    for (;;) {
-      status = f.wait_for(interval);
-      if (status == std::future_status::ready) {
-        return f.get();
-      } else if (status == std::future_status::deferred) {
-        if (timeout.count() > 0) {
-          logger()->warn("Watchdog waiting on deferred execution.");
-        }
-      } else if (status == std::future_status::timeout) {
-        if (timeout.count() > 0) {
-          logger()->critical("Watchdog timeout of {} ms exceeded for state: {}", timeout.count(),
-                             id);
+    std::chrono::milliseconds timeout = ctx.config.engine.watchdog_default_timeout;
+    auto maybe = ctx.config.engine.watchdog_state_timeouts.find(id);
+    if (maybe != ctx.config.engine.watchdog_state_timeouts.end() && maybe->second) {
+      timeout = *maybe->second;
+    }
+    watchdog_timeouts_.emplace(id, timeout);
+    return timeout;
+  }
 
-          if (ctx.config.engine.watchdog_mode == cloe::WatchdogMode::Abort) {
-            logger()->critical("Aborting simulation... this might take a while...");
-            return ABORT;
-          } else if (ctx.config.engine.watchdog_mode == cloe::WatchdogMode::Kill) {
-            logger()->critical("Killing program... this is going to be messy...");
-            std::abort();
-          }
-        }
+  /**
+   * Escalate a watchdog timeout according to the watchdog mode.
+   *
+   * This is called from the watchdog thread while the state is still
+   * running in the simulation thread.
+   */
+  void handle_watchdog_timeout(StateId id, std::chrono::milliseconds timeout,
+                               const SimulationContext& ctx) {
+    logger()->critical("Watchdog timeout of {} ms exceeded for state: {}", timeout.count(), id);
+    if (ctx.config.engine.watchdog_mode == cloe::WatchdogMode::Abort) {
+      logger()->critical("Aborting simulation... this might take a while...");
+      try {
+        this->push_interrupt(ABORT);
+      } catch (std::logic_error& e) {
+        logger()->error("Watchdog cannot abort simulation: {}", e.what());
       }
+    } else if (ctx.config.engine.watchdog_mode == cloe::WatchdogMode::Kill) {
+      logger()->critical("Killing program... this is going to be messy...");
+      std::abort();
     }
   }
 
@@ -279,6 +297,9 @@ class SimulationMachine
   DEFINE_STATE(KEEP_ALIVE, KeepAlive);
   DEFINE_STATE(DISCONNECT, Disconnect);
 #undef DEFINE_STATE
+
+ private:
+  std::unordered_map<StateId, std::chrono::milliseconds> watchdog_timeouts_;
 };
 
 }  // namespace engine
@@ -28,6 +28,7 @@
 #include <fable/json.hpp>
 
 #include "simulation_outcome.hpp"
+#include "simulation_startup.hpp"
 
 namespace engine {
 
@@ -74,6 +75,9 @@ struct SimulationProbe {
   /// - user-supplied metadata
   fable::Json test_metadata;
 
+  /// Time it took to start the simulation up to the probe.
+  SimulationStartup startup;
+
   friend void to_json(fable::Json& j, const SimulationProbe& r) {
     j = fable::Json{
         {"uuid", r.uuid},
@@ -84,6 +88,7 @@ struct SimulationProbe {
         {"http_endpoints", r.http_endpoints},
         {"signals", r.signal_metadata},
         {"tests", r.test_metadata},
+        {"startup", r.startup},
     };
   }
 };
@@ -27,6 +27,7 @@
 #include <fable/json.hpp>
 
 #include "simulation_outcome.hpp"
+#include "simulation_startup.hpp"
 #include "simulation_statistics.hpp"
 #include "simulation_sync.hpp"
 
@@ -50,6 +51,9 @@ struct SimulationResult {
   /// Statistics regarding the simulation performance.
   SimulationStatistics statistics;
 
+  /// Time it took to start the simulation.
+  SimulationStartup startup;
+
   /// The list of triggers run (i.e., the history).
   fable::Json triggers;
 
@@ -58,9 +62,9 @@ struct SimulationResult {
 
   friend void to_json(fable::Json& j, const SimulationResult& r) {
     j = fable::Json{
-        {"elapsed", r.elapsed}, {"errors", r.errors},   {"outcome", r.outcome},
-        {"report", r.report},   {"simulation", r.sync}, {"statistics", r.statistics},
-        {"uuid", r.uuid},
+        {"elapsed", r.elapsed},       {"errors", r.errors},   {"outcome", r.outcome},
+        {"report", r.report},         {"simulation", r.sync}, {"startup", r.startup},
+        {"statistics", r.statistics}, {"uuid", r.uuid},
     };
   }
 };
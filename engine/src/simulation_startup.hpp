@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file simulation_startup.hpp
+ */
+
+#pragma once
+
+#include <map>      // for map<>
+#include <string>   // for string
+#include <utility>  // for pair<>, move
+#include <vector>   // for vector<>
+
+#include <cloe/core/duration.hpp>  // for Duration
+#include <cloe/utility/timer.hpp>  // for Milliseconds
+#include <fable/json.hpp>          // for Json
+
+namespace engine {
+
+/**
+ * SimulationStartup contains the wall-clock time each part of starting the
+ * simulation took, from reading the configuration until the first step.
+ */
+struct SimulationStartup {
+  /// Time of each phase, in the order they occurred.
+  std::vector<std::pair<std::string, cloe::Duration>> phases;
+
+  /// Time to load each plugin, by plugin path.
+  ///
+  /// This is part of the configure phase. Since plugins may be loaded in
+  /// parallel, the sum may be greater than the phase itself.
+  std::map<std::string, cloe::Duration> plugins;
+
+  void add_phase(std::string name, cloe::Duration d) { phases.emplace_back(std::move(name), d); }
+
+  [[nodiscard]] cloe::Duration total() const {
+    cloe::Duration sum{0};
+    for (const auto& p : phases) {
+      sum += p.second;
+    }
+    return sum;
+  }
+
+  friend void to_json(fable::Json& j, const SimulationStartup& s) {
+    auto ms = [](cloe::Duration d) { return timer::Milliseconds(d).count(); };
+    auto phases = fable::Json::array();
+    for (const auto& p : s.phases) {
+      phases.push_back(fable::Json{{"name", p.first}, {"time_ms", ms(p.second)}});
+    }
+    auto plugins = fable::Json::object();
+    for (const auto& p : s.plugins) {
+      plugins[p.first] = ms(p.second);
+    }
+    j = fable::Json{
+        {"total_time_ms", ms(s.total())},
+        {"phases", phases},
+        {"plugins_ms", plugins},
+    };
+  }
+};
+
+}  // namespace engine
@@ -19,6 +19,12 @@
  * \file simulation_state_connect.cpp
  */
 
+#include <exception>  // for exception_ptr, current_exception, rethrow_exception
+#include <future>     // for async, future<>
+#include <string>     // for string
+#include <utility>    // for pair<>
+#include <vector>     // for vector<>
+
 #include <cloe/controller.hpp>                // for Controller
 #include <cloe/data_broker.hpp>               // for DataBroker
 #include <cloe/registrar.hpp>                 // for DirectCallback
@@ -26,6 +32,7 @@
 #include <cloe/trigger/example_actions.hpp>   // for CommandFactory, BundleFactory, ...
 #include <cloe/trigger/set_action.hpp>        // for DEFINE_SET_STATE_ACTION, SetDataActionFactory
 #include <cloe/utility/resource_handler.hpp>  // for INCLUDE_RESOURCE, RESOURCE_HANDLER
+#include <cloe/utility/timer.hpp>             // for DurationTimer
 #include <cloe/vehicle.hpp>                   // for Vehicle
 #include <fable/utility.hpp>                  // for indent_string
 #include <fable/utility/sol.hpp>              // for sol::object to_json
@@ -71,12 +78,80 @@ void handle_cloe_error(cloe::Logger logger, const cloe::Error& e) {
   }
 }
 
+/**
+ * Connect each of the models, either one after another or all at once.
+ *
+ * Return the names of the models that could not be connected, which is
+ * empty on success. Errors of a model are logged with its name. Exceptions
+ * other than ModelError are rethrown once all models have returned.
+ */
+std::vector<std::string> connect_models(
+    SimulationContext& ctx, const cloe::Logger& logger, const char* type,
+    const std::vector<std::pair<std::string, cloe::Model*>>& models, bool parallel) {
+  auto connect = [&logger, type](const std::string& name, cloe::Model* x) -> bool {
+    try {
+      x->connect();
+      return true;
+    } catch (cloe::ModelError& e) {
+      logger->critical("Error configuring {} {}: {}", type, name, e.what());
+      return false;
+    }
+  };
+
+  std::vector<bool> connected(models.size(), false);
+  if (!parallel || models.size() < 2) {
+    for (size_t i = 0; i < models.size(); ++i) {
+      ctx.now_initializing = models[i].second;
+      connected[i] = connect(models[i].first, models[i].second);
+      ctx.now_initializing = nullptr;
+      if (!connected[i]) {
+        break;
+      }
+    }
+  } else {
+    // When the models are connected at once, it is not known which of them
+    // is hanging, so aborting falls back to aborting all of them.
+    std::vector<std::future<bool>> connecting;
+    connecting.reserve(models.size());
+    for (const auto& [name, x] : models) {
+      connecting.emplace_back(std::async(std::launch::async, connect, name, x));
+    }
+    std::exception_ptr error;
+    for (size_t i = 0; i < models.size(); ++i) {
+      try {
+        connected[i] = connecting[i].get();
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::vector<std::string> failed;
+  for (size_t i = 0; i < models.size(); ++i) {
+    if (!connected[i]) {
+      failed.emplace_back(models[i].first);
+    }
+  }
+  return failed;
+}
+
 StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
   logger()->info("Initializing simulation...");
   assert(ctx.config.is_valid());
 
   ctx.outcome = SimulationOutcome::NoStart;
 
+  // Record how long each part of initialization takes.
+  timer::DurationTimer<cloe::Duration> phase_timer;
+  auto end_phase = [&ctx, &phase_timer](const char* name) {
+    ctx.startup.add_phase(std::string("connect/") + name, phase_timer.reset());
+  };
+
   // 1. Initialize progress tracking
   ctx.progress.init_begin(6);
   auto update_progress = [&ctx](const char* str) {
@@ -183,6 +258,8 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
     r.register_event(std::make_unique<events::TimeFactory>(), ctx.callback_time);
     r.register_event(std::make_unique<events::NextFactory>(),
                      std::make_shared<events::NextCallback>(ctx.callback_time));
+    ctx.callback_predicate =
+        r.register_event<events::PredicateFactory>(ctx.coordinator->data_broker());
 
     // Actions:
     r.register_action<actions::PauseFactory>(this->state_machine());
@@ -192,6 +269,7 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
     r.register_action<actions::FailFactory>(this->state_machine());
     r.register_action<actions::SucceedFactory>(this->state_machine());
     r.register_action<actions::KeepAliveFactory>(&ctx);
+    r.register_action<actions::CheckpointFactory>(&ctx);
     r.register_action<actions::RealtimeFactorFactory>(&ctx.sync);
     r.register_action<actions::ResetStatisticsFactory>(&ctx.statistics);
     r.register_action<actions::CommandFactory>(ctx.commander.get());
@@ -203,6 +281,7 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
     r.register_action<cloe::actions::InsertFactory>(tr);
     r.register_action<cloe::actions::LogFactory>();
     r.register_action<cloe::actions::PushReleaseFactory>(tr);
+    end_phase("setup");
   }
 
   {  // 5. Initialize simulators
@@ -217,36 +296,48 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
       for (auto d : ctx.config.get_simulator_defaults(name, f->name())) {
         f->from_conf(d.args);
       }
-      auto x = f->make(c.args);
-      ctx.now_initializing = x.get();
-
-      // Configure simulator:
-      auto r = ctx.registrar->with_trigger_prefix(name)->with_api_prefix(
-          std::string("/simulators/") + name);
-      x->connect();
-      x->enroll(*r);
-
-      ctx.now_initializing = nullptr;
-      return x;
+      return f->make(c.args);
     };
 
-    // Create and configure all simulators:
+    // Create all simulators before connecting them, so that they can be
+    // connected in parallel:
+    std::vector<std::pair<std::string, cloe::Model*>> created;
     for (const auto& c : ctx.config.simulators) {
       auto name = c.name.value_or(c.binding);
       assert(ctx.simulators.count(name) == 0);
       logger()->info("Configure simulator {}", name);
 
       try {
-        ctx.simulators[name] = new_simulator(c);
+        auto x = new_simulator(c);
+        created.emplace_back(name, x.get());
+        ctx.simulators[name] = std::move(x);
       } catch (cloe::ModelError& e) {
         logger()->critical("Error configuring simulator {}: {}", name, e.what());
+        for (const auto& kv : created) {
+          ctx.simulators.erase(kv.first);
+        }
         return ABORT;
       }
     }
+    auto failed = connect_models(ctx, logger(), "simulator", created,
+                                 ctx.config.engine.parallel_connect);
+    if (!failed.empty()) {
+      // Models that were not connected need not be disconnected.
+      for (const auto& name : failed) {
+        ctx.simulators.erase(name);
+      }
+      return ABORT;
+    }
+    for (const auto& [name, x] : created) {
+      auto r = ctx.registrar->with_trigger_prefix(name)->with_api_prefix(
+          std::string("/simulators/") + name);
+      x->enroll(*r);
+    }
 
     auto r = ctx.simulation_registrar();
     r->register_api_handler("/simulators", cloe::HandlerType::STATIC,
                             cloe::handler::StaticJson(ctx.simulator_ids()));
+    end_phase("simulators");
   }
 
   {  // 6. Initialize vehicles
@@ -343,6 +434,9 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
           auto k = new_component(*x, kv.second);
           if (k) {
             x->set_component(kv.first, std::move(k));
+            if (!kv.second.schedule.is_every_step()) {
+              x->set_schedule(kv.first, kv.second.schedule);
+            }
             configured.insert(kv.first);
           }
         }
@@ -437,6 +531,7 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
     auto r = ctx.simulation_registrar();
     r->register_api_handler("/vehicles", cloe::HandlerType::STATIC,
                             cloe::handler::StaticJson(ctx.vehicle_ids()));
+    end_phase("vehicles");
   }
 
   {  // 7. Initialize controllers
@@ -453,35 +548,51 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
         f->from_conf(d.args);
       }
       auto x = f->make(c.args);
-      ctx.now_initializing = x.get();
-
-      // Configure
-      auto r = ctx.registrar->with_trigger_prefix(name)->with_api_prefix(
-          std::string("/controllers/") + name);
       x->set_vehicle(ctx.vehicles.at(c.vehicle));
-      x->connect();
-      x->enroll(*r);
-
-      ctx.now_initializing = nullptr;
       return x;
     };
 
-    // Create and configure all controllers:
+    // Create all controllers before connecting them, so that they can be
+    // connected in parallel:
+    std::vector<std::pair<std::string, cloe::Model*>> created;
     for (const auto& c : ctx.config.controllers) {
       auto name = c.name.value_or(c.binding);
       assert(ctx.controllers.count(name) == 0);
       logger()->info("Configure controller {}", name);
       try {
-        ctx.controllers[name] = new_controller(c);
+        auto x = new_controller(c);
+        ctx.controller_schedulers.emplace(x.get(), cloe::Scheduler{c.schedule});
+        created.emplace_back(name, x.get());
+        ctx.controllers[name] = std::move(x);
       } catch (cloe::ModelError& e) {
         logger()->critical("Error configuring controller {}: {}", name, e.what());
+        for (const auto& kv : created) {
+          ctx.controller_schedulers.erase(ctx.controllers.at(kv.first).get());
+          ctx.controllers.erase(kv.first);
+        }
         return ABORT;
       }
     }
+    auto failed = connect_models(ctx, logger(), "controller", created,
+                                 ctx.config.engine.parallel_connect);
+    if (!failed.empty()) {
+      // Models that were not connected need not be disconnected.
+      for (const auto& name : failed) {
+        ctx.controller_schedulers.erase(ctx.controllers.at(name).get());
+        ctx.controllers.erase(name);
+      }
+      return ABORT;
+    }
+    for (const auto& [name, x] : created) {
+      auto r = ctx.registrar->with_trigger_prefix(name)->with_api_prefix(
+          std::string("/controllers/") + name);
+      x->enroll(*r);
+    }
 
     auto r = ctx.simulation_registrar();
     r->register_api_handler("/controllers", cloe::HandlerType::STATIC,
                             cloe::handler::StaticJson(ctx.controller_ids()));
+    end_phase("controllers");
   }
 
   {  // 8. Initialize Databroker & Lua
@@ -673,6 +784,7 @@ StateId SimulationMachine::Connect::impl(SimulationContext& ctx) {
       }
     }
   }
+  end_phase("signals");
   ctx.progress.init_end();
   ctx.server->refresh_buffer_start_stream();
   logger()->info("Simulation initialization complete.");
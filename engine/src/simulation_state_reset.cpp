@@ -38,6 +38,9 @@ StateId SimulationMachine::Reset::impl(SimulationContext& ctx) {
     }
     return true;
   });
+  for (auto& kv : ctx.controller_schedulers) {
+    kv.second.reset();
+  }
   if (ok) {
     return CONNECT;
   } else {
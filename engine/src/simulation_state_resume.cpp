@@ -35,6 +35,10 @@ StateId SimulationMachine::Resume::impl(SimulationContext& ctx) {
     ctx.server->stop();
   }
   ctx.callback_resume->trigger(ctx.sync);
+  if (ctx.pacer) {
+    // The deadlines of the steps before the pause have long passed.
+    ctx.pacer->reset();
+  }
   return STEP_BEGIN;
 }
 
@@ -19,13 +19,15 @@
  * \file simulation_state_start.cpp
  */
 
-#include <cloe/core/error.hpp>  // for ConcludedError, TriggerError
-#include <fable/error.hpp>      // for SchemaError
-#include <fable/utility.hpp>    // for pretty_print
+#include <cloe/core/duration.hpp>  // for to_string
+#include <cloe/core/error.hpp>     // for ConcludedError, TriggerError
+#include <fable/error.hpp>         // for SchemaError
+#include <fable/utility.hpp>       // for pretty_print
 
-#include "coordinator.hpp"         // for Coordinator::trigger_registrar
-#include "simulation_context.hpp"  // for SimulationContext
-#include "simulation_machine.hpp"  // for SimulationMachine
+#include "coordinator.hpp"             // for Coordinator::trigger_registrar
+#include "simulation_checkpoint.hpp"  // for read_checkpoint_file, restore_checkpoint
+#include "simulation_context.hpp"     // for SimulationContext
+#include "simulation_machine.hpp"     // for SimulationMachine
 
 namespace engine {
 
@@ -53,25 +55,52 @@ size_t insert_triggers_from_config(SimulationContext& ctx) {
   return count;
 }
 
+namespace {
+
+void start_models(SimulationContext& ctx) {
+  ctx.foreach_model([&ctx](cloe::Model& m, const char* type) {
+    ctx.logger()->trace("Start {} {}", type, m.name());
+    m.start(ctx.sync);
+    return true;  // next model
+  });
+}
+
+}  // anonymous namespace
+
 StateId SimulationMachine::Start::impl(SimulationContext& ctx) {
   logger()->info("Starting simulation...");
 
   // Begin execution progress
   ctx.progress.exec_begin();
 
-  // Process initial trigger list
-  insert_triggers_from_config(ctx);
-  ctx.coordinator->process_pending_lua_triggers(ctx.sync);
-  ctx.coordinator->process(ctx.sync);
-  ctx.callback_start->trigger(ctx.sync);
+  if (ctx.from_checkpoint) {
+    // The models are started as usual, and then the checkpoint replaces the
+    // sync, the pending triggers, and the state of each model, so that the
+    // simulation continues with the step after it.
+    start_models(ctx);
+    logger()->info("Restoring checkpoint: {}", *ctx.from_checkpoint);
+    auto checkpoint = read_checkpoint_file(*ctx.from_checkpoint);
+    restore_checkpoint(ctx, checkpoint);
 
-  // Process initial context
-  ctx.foreach_model([this, &ctx](cloe::Model& m, const char* type) {
-    logger()->trace("Start {} {}", type, m.name());
-    m.start(ctx.sync);
-    return true;  // next model
-  });
-  ctx.sync.increment_step();
+    // The triggers of the stack and from Lua are inserted in addition to the
+    // restored ones, since this is where a variant differs from the lead-in.
+    // The simulation has already started, so start triggers do not fire.
+    insert_triggers_from_config(ctx);
+    ctx.coordinator->process_pending_lua_triggers(ctx.sync);
+    ctx.coordinator->process(ctx.sync);
+    logger()->info("Continuing simulation from step {} at {}", ctx.sync.step(),
+                   cloe::to_string(ctx.sync.time()));
+  } else {
+    // Process initial trigger list
+    insert_triggers_from_config(ctx);
+    ctx.coordinator->process_pending_lua_triggers(ctx.sync);
+    ctx.coordinator->process(ctx.sync);
+    ctx.callback_start->trigger(ctx.sync);
+
+    // Process initial context
+    start_models(ctx);
+    ctx.sync.increment_step();
+  }
 
   // We can pause at the start of execution too.
   if (ctx.pause_execution) {
@@ -59,9 +59,10 @@ StateId SimulationMachine::StepBegin::impl(SimulationContext& ctx) {
   //
   ctx.server->refresh_buffer();
 
-  // Run cycle- and time-based triggers
+  // Run cycle-, time-, and signal-based triggers
   ctx.callback_loop->trigger(ctx.sync);
   ctx.callback_time->trigger(ctx.sync);
+  ctx.callback_predicate->trigger(ctx.sync);
 
   // Determine whether to continue simulating or stop
   bool all_operational = ctx.foreach_model([this](const cloe::Model& m, const char* type) {
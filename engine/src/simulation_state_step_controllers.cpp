@@ -22,6 +22,7 @@
 #include "server.hpp"              // for Server::lock, ...
 #include "simulation_context.hpp"  // for SimulationContext
 #include "simulation_machine.hpp"  // for SimulationMachine
+#include "utility/tracer.hpp"      // for TraceSpan
 
 namespace engine {
 
@@ -45,12 +46,22 @@ StateId SimulationMachine::StepControllers::impl(SimulationContext& ctx) {
       return true;
     }
 
+    // Skip controllers that are not due in this step. These are still at
+    // the time they were last processed, which is intended.
+    auto& sched = ctx.controller_schedulers.at(&ctrl);
+    if (!sched.is_due(ctx.sync)) {
+      return true;
+    }
+
     // Keep calling the ctrl until it has caught up the current time.
     cloe::Duration ctrl_time;
     try {
       int64_t retries = 0;
       for (;;) {
-        ctrl_time = ctrl.process(ctx.sync);
+        {
+          TraceSpan span(ctx.tracer.get(), "controller", ctrl.name());
+          ctrl_time = ctrl.process(sched.sync());
+        }
 
         // If we are underneath our target, sleep and try again.
         if (ctrl_time < ctx.sync.time()) {
@@ -98,6 +109,7 @@ StateId SimulationMachine::StepControllers::impl(SimulationContext& ctx) {
         this->logger()->warn("Continuing without controller {}", ctrl.name());
         ctrl.abort();
         ctrl.disconnect();
+        ctx.controller_schedulers.erase(&ctrl);
         controllers_to_erase.push_back(ctrl.name());
         return true;
       }
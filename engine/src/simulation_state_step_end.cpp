@@ -19,15 +19,18 @@
  * \file simulation_state_step_end.cpp
  */
 
-#include <chrono>   // for duration_cast
-#include <cstdint>  // uint64_t
-#include <thread>   // sleep_for
+#include <algorithm>  // for min
+#include <chrono>     // for duration_cast
+#include <cstdint>    // uint64_t
+#include <exception>  // for exception
+#include <thread>     // sleep_for
 
 #include <cloe/core/duration.hpp>  // for Duration
 
-#include "coordinator.hpp"         // for Coordinator::process
-#include "server.hpp"              // for Server::lock, ...
-#include "simulation_machine.hpp"  // for SimulationMachine
+#include "coordinator.hpp"            // for Coordinator::process
+#include "server.hpp"                 // for Server::lock, ...
+#include "simulation_checkpoint.hpp"  // for capture_checkpoint, write_checkpoint_file
+#include "simulation_machine.hpp"     // for SimulationMachine
 
 namespace engine {
 
@@ -40,18 +43,39 @@ StateId SimulationMachine::StepEnd::impl(SimulationContext& ctx) {
     ctx.sync.set_cycle_time(elapsed);
   }
 
-  if (!ctx.sync.is_realtime_factor_unlimited()) {
+  if (!ctx.replay && !ctx.sync.is_realtime_factor_unlimited()) {
     auto width = ctx.sync.step_width().count();
     auto target = cloe::Duration(static_cast<uint64_t>(width / ctx.sync.realtime_factor()));
-    padding = target - elapsed;
-    if (padding.count() > 0) {
-      std::this_thread::sleep_for(padding);
+    if (ctx.pacer) {
+      auto r = ctx.pacer->wait(target, elapsed);
+      padding = r.padding;
+      ctx.statistics.overrun_time_ms.push_back(
+          std::chrono::duration_cast<cloe::Milliseconds>(r.overrun).count());
+      if (r.overrun.count() == 0) {
+        ctx.statistics.jitter_time_ms.push_back(
+            std::chrono::duration_cast<cloe::Milliseconds>(r.jitter).count());
+      }
     } else {
+      padding = target - elapsed;
+      if (padding.count() > 0) {
+        std::this_thread::sleep_for(padding);
+      }
+    }
+    if (padding.count() <= 0) {
       logger()->trace("Failing target realtime factor: {:.2f} < {:.2f}",
                       ctx.sync.achievable_realtime_factor(), ctx.sync.realtime_factor());
     }
+  } else if (ctx.pacer) {
+    // Start with new deadlines once the realtime factor is limited again.
+    ctx.pacer->reset();
   }
 
+  // The models declare their wakeup relative to the step they just processed,
+  // so this must be determined before the step is incremented.
+  bool fast_forward =
+      ctx.config.simulation.fast_forward && ctx.sync.is_realtime_factor_unlimited();
+  cloe::Duration wakeup = fast_forward ? ctx.next_model_wakeup() : cloe::Duration{0};
+
   auto guard = ctx.server->lock();
   ctx.statistics.cycle_time_ms.push_back(
       std::chrono::duration_cast<cloe::Milliseconds>(elapsed).count());
@@ -62,6 +86,33 @@ StateId SimulationMachine::StepEnd::impl(SimulationContext& ctx) {
   // Process all inserted triggers now.
   ctx.coordinator->process(ctx.sync);
 
+  // Write requested checkpoints now that the step is complete.
+  for (const auto& path : ctx.checkpoint_requests) {
+    try {
+      write_checkpoint_file(path, capture_checkpoint(ctx));
+      logger()->info("Wrote checkpoint at step {}: {}", ctx.sync.step(), path);
+    } catch (std::exception& e) {
+      logger()->error("Cannot write checkpoint {}: {}", path, e.what());
+    }
+  }
+  ctx.checkpoint_requests.clear();
+
+  // Skip to the first step at or after the next wakeup. Triggers inserted
+  // above are taken into account, since they may need to be executed
+  // earlier. If nothing needs to wake up at all, there is no point to skip
+  // to, so the simulation continues step by step.
+  if (fast_forward) {
+    wakeup = std::min(wakeup, ctx.next_trigger_wakeup());
+    uint64_t skipped = 0;
+    if (wakeup != cloe::Duration::max() && wakeup > ctx.sync.time()) {
+      auto ahead = wakeup - ctx.sync.time();
+      auto width = ctx.sync.base_step_width();
+      skipped = static_cast<uint64_t>(ahead / width + (ahead % width != cloe::Duration{0}));
+    }
+    ctx.sync.skip_steps(skipped);
+    ctx.statistics.skipped_steps.push_back(static_cast<double>(skipped));
+  }
+
   // We can pause the simulation between STEP_END and STEP_BEGIN.
   if (ctx.pause_execution) {
     return PAUSE;
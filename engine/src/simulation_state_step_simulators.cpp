@@ -29,6 +29,7 @@
 #include "server.hpp"              // for ctx.server
 #include "simulation_context.hpp"  // for SimulationContext
 #include "simulation_machine.hpp"  // for SimulationMachine
+#include "utility/tracer.hpp"      // for TraceSpan
 
 namespace engine {
 
@@ -43,6 +44,7 @@ StateId SimulationMachine::StepSimulators::impl(SimulationContext& ctx) {
   // Call the simulator bindings:
   ctx.foreach_simulator([&ctx](cloe::Simulator& simulator) {
     try {
+      TraceSpan span(ctx.tracer.get(), "simulator", simulator.name());
       cloe::Duration sim_time = simulator.process(ctx.sync);
       if (!simulator.is_operational()) {
         throw cloe::ModelStop("simulator {} no longer operational", simulator.name());
@@ -68,6 +70,7 @@ StateId SimulationMachine::StepSimulators::impl(SimulationContext& ctx) {
 
   // Clear vehicle cache
   ctx.foreach_vehicle([this, &ctx](cloe::Vehicle& v) {
+    TraceSpan span(ctx.tracer.get(), "vehicle", v.name());
     auto t = v.process(ctx.sync);
     if (t < ctx.sync.time()) {
       logger()->error("Vehicle ({}, {}) not progressing; simulation compromised!", v.id(),
@@ -33,6 +33,9 @@ struct SimulationStatistics {
   cloe::utility::Accumulator controller_time_ms;
   cloe::utility::Accumulator padding_time_ms;
   cloe::utility::Accumulator controller_retries;
+  cloe::utility::Accumulator skipped_steps;
+  cloe::utility::Accumulator overrun_time_ms;
+  cloe::utility::Accumulator jitter_time_ms;
 
   void reset() {
     engine_time_ms.reset();
@@ -41,6 +44,9 @@ struct SimulationStatistics {
     controller_time_ms.reset();
     padding_time_ms.reset();
     controller_retries.reset();
+    skipped_steps.reset();
+    overrun_time_ms.reset();
+    jitter_time_ms.reset();
   }
 
   friend void to_json(fable::Json& j, const SimulationStatistics& s) {
@@ -48,6 +54,8 @@ struct SimulationStatistics {
         {"engine_time_ms", s.engine_time_ms},         {"simulator_time_ms", s.simulator_time_ms},
         {"controller_time_ms", s.controller_time_ms}, {"padding_time_ms", s.padding_time_ms},
         {"cycle_time_ms", s.cycle_time_ms},           {"controller_retries", s.controller_retries},
+        {"skipped_steps", s.skipped_steps},           {"overrun_time_ms", s.overrun_time_ms},
+        {"jitter_time_ms", s.jitter_time_ms},
     };
   }
 };
@@ -40,10 +40,24 @@ class SimulationSync : public cloe::Sync {
   SimulationSync &operator=(SimulationSync &&) = delete;
   virtual ~SimulationSync() = default;
 
-  explicit SimulationSync(const cloe::Duration &step_width) : step_width_(step_width) {}
+  explicit SimulationSync(const cloe::Duration &step_width)
+      : step_width_(step_width), elapsed_(step_width) {}
 
   uint64_t step() const override { return step_; }
-  cloe::Duration step_width() const override { return step_width_; }
+
+  /**
+   * Return the simulation time since the previous step.
+   *
+   * This is the configured step width, unless steps were skipped by
+   * fast-forwarding, in which case it spans all skipped steps.
+   */
+  cloe::Duration step_width() const override { return elapsed_; }
+
+  /**
+   * Return the configured step width, which all step times are a multiple of.
+   */
+  cloe::Duration base_step_width() const override { return step_width_; }
+
   cloe::Duration time() const override { return time_; }
   cloe::Duration eta() const override { return eta_; }
 
@@ -67,13 +81,24 @@ class SimulationSync : public cloe::Sync {
   /**
    * Increase the step number for the simulation.
    *
-   * - It increases the step by one.
-   * - It moves the simulation time forward by the step width.
-   * - It stores the real time difference from the last time IncrementStep was called.
+   * - It increases the step by n, which is one unless steps are skipped.
+   * - It moves the simulation time forward by n times the step width.
    */
-  void increment_step() {
-    step_ += 1;
-    time_ += step_width_;
+  void increment_step(uint64_t n = 1) {
+    step_ += n;
+    elapsed_ = step_width_ * static_cast<int64_t>(n);
+    time_ += elapsed_;
+  }
+
+  /**
+   * Skip n steps after the step was incremented, such as when
+   * fast-forwarding, so that the step width of the next step includes them.
+   */
+  void skip_steps(uint64_t n) {
+    auto skipped = step_width_ * static_cast<int64_t>(n);
+    step_ += n;
+    time_ += skipped;
+    elapsed_ += skipped;
   }
 
   /**
@@ -84,9 +109,19 @@ class SimulationSync : public cloe::Sync {
 
   void set_eta(cloe::Duration d) { eta_ = d; }
 
+  /**
+   * Set the step number and simulation time, such as when continuing a
+   * simulation from a checkpoint.
+   */
+  void set_step(uint64_t step, cloe::Duration time) {
+    step_ = step;
+    time_ = time;
+  }
+
   void reset() {
     time_ = cloe::Duration(0);
     step_ = 0;
+    elapsed_ = step_width_;
   }
 
   void set_cycle_time(cloe::Duration d) { cycle_time_ = d; }
@@ -101,6 +136,7 @@ class SimulationSync : public cloe::Sync {
   // Simulation Configuration
   double realtime_factor_{1.0};            // realtime
   cloe::Duration step_width_{20'000'000};  // should be 20ms
+  cloe::Duration elapsed_{20'000'000};     // since the previous step
 };
 
 }  // namespace engine
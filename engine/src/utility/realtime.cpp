@@ -0,0 +1,116 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/realtime.cpp
+ * \see  utility/realtime.hpp
+ */
+
+#include "utility/realtime.hpp"
+
+#include <pthread.h>  // for pthread_self, pthread_setaffinity_np, ...
+#include <sched.h>    // for cpu_set_t, CPU_SET, sched_param, SCHED_FIFO
+#include <time.h>     // for clock_nanosleep, timespec
+
+#include <cerrno>  // for EINTR, EINVAL
+#include <thread>  // for this_thread::yield
+
+namespace engine {
+
+std::vector<int> thread_affinity() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  std::vector<int> cpus;
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+      if (CPU_ISSET(i, &set)) {
+        cpus.push_back(i);
+      }
+    }
+  }
+  return cpus;
+}
+
+std::error_code set_thread_affinity(const std::vector<int>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return std::error_code(EINVAL, std::generic_category());
+    }
+    CPU_SET(cpu, &set);
+  }
+  return std::error_code(pthread_setaffinity_np(pthread_self(), sizeof(set), &set),
+                         std::generic_category());
+}
+
+std::error_code set_thread_fifo_priority(int priority) {
+  sched_param param{};
+  param.sched_priority = priority;
+  int policy = priority > 0 ? SCHED_FIFO : SCHED_OTHER;
+  return std::error_code(pthread_setschedparam(pthread_self(), policy, &param),
+                         std::generic_category());
+}
+
+namespace {
+
+/**
+ * Sleep until the given time point of the steady clock.
+ *
+ * The steady clock is CLOCK_MONOTONIC on Linux, so this can sleep until an
+ * absolute time instead of for a duration, which would be extended by the
+ * time it takes to compute it.
+ */
+void sleep_until(Pacer::Clock::time_point t) {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+  timespec ts{};
+  ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+  ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);  // NOLINT(runtime/int)
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+  }
+}
+
+}  // anonymous namespace
+
+PacingResult Pacer::wait(std::chrono::nanoseconds period, std::chrono::nanoseconds elapsed) {
+  const auto begin = Clock::now();
+  if (!deadline_) {
+    deadline_ = begin - elapsed;
+  }
+  *deadline_ += period;
+
+  PacingResult result;
+  if (begin >= *deadline_) {
+    result.overrun = begin - *deadline_;
+    deadline_ = begin;
+    return result;
+  }
+
+  if (*deadline_ - begin > spin_time_) {
+    sleep_until(*deadline_ - spin_time_);
+  }
+  auto now = Clock::now();
+  while (now < *deadline_) {
+    std::this_thread::yield();
+    now = Clock::now();
+  }
+  result.padding = now - begin;
+  result.jitter = now - *deadline_;
+  return result;
+}
+
+}  // namespace engine
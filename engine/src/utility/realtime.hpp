@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/realtime.hpp
+ * \see  utility/realtime.cpp
+ * \see  utility/realtime_test.cpp
+ *
+ * This file contains the thread scheduling and pacing used to run
+ * simulations in realtime, such as for hardware-in-the-loop tests.
+ */
+
+#pragma once
+
+#include <chrono>        // for steady_clock, nanoseconds
+#include <optional>      // for optional<>
+#include <system_error>  // for error_code
+#include <vector>        // for vector<>
+
+namespace engine {
+
+/**
+ * Return the CPUs that the calling thread may run on.
+ */
+std::vector<int> thread_affinity();
+
+/**
+ * Restrict the calling thread to run on the given CPUs.
+ *
+ * Threads that are created by the calling thread afterwards inherit this.
+ * Return an error if the affinity cannot be set, such as when a CPU does not
+ * exist.
+ */
+std::error_code set_thread_affinity(const std::vector<int>& cpus);
+
+/**
+ * Schedule the calling thread with the SCHED_FIFO policy and the given
+ * priority, or with the default policy if the priority is zero.
+ *
+ * Threads that are created by the calling thread afterwards inherit this.
+ * Return an error if the policy cannot be set, which is usually because the
+ * process lacks the CAP_SYS_NICE capability.
+ */
+std::error_code set_thread_fifo_priority(int priority);
+
+/**
+ * PacingResult describes how one step was paced.
+ */
+struct PacingResult {
+  /// Time that was waited until the deadline.
+  std::chrono::nanoseconds padding{0};
+
+  /// Time by which the step missed its deadline, in which case there was no
+  /// waiting.
+  std::chrono::nanoseconds overrun{0};
+
+  /// Time by which waking up missed the deadline.
+  std::chrono::nanoseconds jitter{0};
+};
+
+/**
+ * Pacer paces a loop to a period with absolute deadlines.
+ *
+ * The deadline of each step is the deadline of the previous step plus the
+ * period, so that the error of waking up late does not accumulate. Waiting
+ * sleeps until shortly before the deadline and then spins for the rest,
+ * since sleeping alone wakes up too late by an amount that depends on the
+ * kernel.
+ *
+ * When a step overruns its deadline, the pacer does not try to catch up, but
+ * continues with deadlines relative to the time of the overrun.
+ */
+class Pacer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit Pacer(std::chrono::nanoseconds spin_time) : spin_time_(spin_time) {}
+
+  /**
+   * Wait until the deadline of the current step, which began the given time
+   * ago if this is the first step.
+   */
+  PacingResult wait(std::chrono::nanoseconds period, std::chrono::nanoseconds elapsed);
+
+  /**
+   * Forget the last deadline, such as after pausing.
+   */
+  void reset() { deadline_.reset(); }
+
+ private:
+  std::chrono::nanoseconds spin_time_;
+  std::optional<Clock::time_point> deadline_;
+};
+
+}  // namespace engine
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/realtime_test.cpp
+ * \see  utility/realtime.hpp
+ */
+
+#include <chrono>  // for milliseconds
+#include <thread>  // for thread, this_thread::sleep_for
+#include <vector>  // for vector<>
+
+#include <gtest/gtest.h>
+
+#include "utility/realtime.hpp"  // for Pacer, set_thread_affinity, ...
+
+using namespace std::chrono_literals;  // NOLINT(build/namespaces)
+
+// The pacer never returns before a deadline, but it may return arbitrarily
+// late when the test is preempted, so these tests only check lower bounds.
+
+TEST(engine_realtime, pacer_absolute_deadlines) {
+  engine::Pacer pacer(200us);
+  auto begin = engine::Pacer::Clock::now();
+  for (int i = 0; i < 5; ++i) {
+    // Work that takes varying time does not shift the deadlines.
+    std::this_thread::sleep_for(std::chrono::milliseconds(i % 3));
+    auto r = pacer.wait(5ms, 0ms);
+    EXPECT_GE(r.jitter.count(), 0);
+    if (r.overrun.count() == 0) {
+      EXPECT_GT(r.padding.count(), 0);
+    }
+  }
+  auto elapsed = engine::Pacer::Clock::now() - begin;
+  EXPECT_GE(elapsed, 25ms);
+}
+
+TEST(engine_realtime, pacer_overrun) {
+  engine::Pacer pacer(0us);
+  pacer.wait(1ms, 0ms);
+  std::this_thread::sleep_for(5ms);
+  auto before = engine::Pacer::Clock::now();
+  auto r = pacer.wait(1ms, 0ms);
+  EXPECT_GE(r.overrun, 4ms);
+  EXPECT_EQ(r.padding.count(), 0);
+
+  // After an overrun, the pacer does not try to catch up, so the next
+  // deadline is a full period after the overrun was detected.
+  pacer.wait(1ms, 0ms);
+  EXPECT_GE(engine::Pacer::Clock::now() - before, 1ms);
+}
+
+TEST(engine_realtime, thread_affinity) {
+  auto cpus = engine::thread_affinity();
+  ASSERT_FALSE(cpus.empty());
+  std::thread([&cpus]() {
+    EXPECT_FALSE(engine::set_thread_affinity({cpus.front()}));
+    EXPECT_EQ(engine::thread_affinity(), std::vector<int>{cpus.front()});
+    EXPECT_TRUE(engine::set_thread_affinity({-1}));
+  }).join();
+}
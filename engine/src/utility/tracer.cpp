@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/tracer.cpp
+ * \see  utility/tracer.hpp
+ */
+
+#include "utility/tracer.hpp"
+
+#include <algorithm>  // for max
+#include <utility>    // for pair<>
+
+#include <cloe/core.hpp>  // for Json
+
+namespace engine {
+
+std::atomic<uint64_t> Tracer::next_id_{1};
+
+Tracer::Tracer(size_t buffer_size)
+    : id_(next_id_++), buffer_size_(std::max<size_t>(buffer_size, 1)), epoch_(Clock::now()) {}
+
+Tracer::ThreadBuffer& Tracer::local_buffer() {
+  // Each thread caches its buffer of the tracer it last recorded to. Tracers
+  // are identified by a unique id, since a new tracer may reuse the address
+  // of an old one.
+  thread_local uint64_t cached_id = 0;
+  thread_local ThreadBuffer* cached_buffer = nullptr;
+  if (cached_id != id_) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto buf = std::make_unique<ThreadBuffer>();
+    buf->tid = static_cast<uint32_t>(buffers_.size());
+    buf->ring.reserve(std::min<size_t>(buffer_size_, 4096));
+    cached_buffer = buf.get();
+    cached_id = id_;
+    buffers_.emplace_back(std::move(buf));
+  }
+  return *cached_buffer;
+}
+
+void Tracer::record(const char* category, std::string_view name, Clock::time_point begin,
+                    Clock::time_point end) {
+  auto& buf = local_buffer();
+  if (buf.ring.size() < buffer_size_) {
+    buf.ring.emplace_back(TraceEvent{category, std::string(name), begin, end - begin});
+  } else {
+    // Reuse the slot, including the capacity of its name.
+    auto& ev = buf.ring[buf.next];
+    ev.category = category;
+    ev.name.assign(name);
+    ev.begin = begin;
+    ev.duration = end - begin;
+  }
+  buf.next = (buf.next + 1) % buffer_size_;
+  buf.total++;
+}
+
+size_t Tracer::size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  size_t n = 0;
+  for (const auto& buf : buffers_) {
+    n += buf->ring.size();
+  }
+  return n;
+}
+
+size_t Tracer::dropped() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  size_t n = 0;
+  for (const auto& buf : buffers_) {
+    n += buf->total - buf->ring.size();
+  }
+  return n;
+}
+
+std::vector<std::pair<uint32_t, const TraceEvent*>> Tracer::events() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::vector<std::pair<uint32_t, const TraceEvent*>> result;
+  for (const auto& buf : buffers_) {
+    // Once the ring is full, the oldest event is the next one to overwrite.
+    auto n = buf->ring.size();
+    auto first = n < buffer_size_ ? 0 : buf->next;
+    for (size_t i = 0; i < n; ++i) {
+      result.emplace_back(buf->tid, &buf->ring[(first + i) % n]);
+    }
+  }
+  return result;
+}
+
+void Tracer::write_chrome_json(std::ostream& os) const {
+  using Micros = std::chrono::duration<double, std::micro>;
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& [tid, ev] : events()) {
+    // Complete events ("X") need only one record per span.
+    cloe::Json j{
+        {"name", ev->name},
+        {"cat", ev->category},
+        {"ph", "X"},
+        {"ts", Micros(ev->begin - epoch_).count()},
+        {"dur", Micros(ev->duration).count()},
+        {"pid", 1},
+        {"tid", tid},
+    };
+    os << (first ? "\n" : ",\n") << j.dump();
+    first = false;
+  }
+  os << "\n]}\n";
+}
+
+}  // namespace engine
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/tracer.hpp
+ * \see  utility/tracer.cpp
+ * \see  utility/tracer_test.cpp
+ *
+ * This file defines a tracer, which records a timeline of what the engine
+ * does in each step, for viewing in chrome://tracing or ui.perfetto.dev.
+ */
+
+#pragma once
+
+#include <atomic>       // for atomic<>
+#include <chrono>       // for steady_clock
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <memory>       // for unique_ptr<>
+#include <mutex>        // for mutex
+#include <ostream>      // for ostream
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector<>
+
+namespace engine {
+
+/**
+ * TraceEvent is a span of time in which the engine did something, such as
+ * running a state or processing a model.
+ */
+struct TraceEvent {
+  const char* category;
+  std::string name;
+  std::chrono::steady_clock::time_point begin;
+  std::chrono::steady_clock::duration duration;
+};
+
+/**
+ * Tracer records trace events from any number of threads.
+ *
+ * Each thread records into its own ring buffer, so recording needs no
+ * locks. When a ring buffer is full, the oldest events of that thread are
+ * overwritten, which bounds memory use for long simulations.
+ *
+ * The events can only be written once no thread is recording anymore.
+ */
+class Tracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Create a tracer that keeps the last buffer_size events of each thread.
+   */
+  explicit Tracer(size_t buffer_size);
+
+  void record(const char* category, std::string_view name, Clock::time_point begin,
+              Clock::time_point end);
+
+  /**
+   * Return the number of events that are kept.
+   */
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * Return the number of events that were overwritten.
+   */
+  [[nodiscard]] size_t dropped() const;
+
+  /**
+   * Return all events kept, ordered by thread and then by time of ending.
+   *
+   * Each pair contains the thread number and the event.
+   */
+  [[nodiscard]] std::vector<std::pair<uint32_t, const TraceEvent*>> events() const;
+
+  /**
+   * Write the events in Chrome trace event JSON format.
+   *
+   * See: https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+   */
+  void write_chrome_json(std::ostream& os) const;
+
+ private:
+  struct ThreadBuffer {
+    uint32_t tid;
+    std::vector<TraceEvent> ring;
+    size_t next{0};
+    size_t total{0};
+  };
+
+  ThreadBuffer& local_buffer();
+
+  uint64_t id_;
+  size_t buffer_size_;
+  Clock::time_point epoch_;
+
+  // The mutex only guards registering threads, not recording events.
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  static std::atomic<uint64_t> next_id_;
+};
+
+/**
+ * TraceSpan records an event from its construction to its destruction.
+ *
+ * If the tracer is nullptr, nothing is recorded. The name must outlive the
+ * span.
+ *
+ * Example:
+ *
+ *     {
+ *       TraceSpan span(ctx.tracer.get(), "simulator", simulator.name());
+ *       simulator.process(ctx.sync);
+ *     }
+ */
+class TraceSpan {
+ public:
+  TraceSpan(Tracer* tracer, const char* category, std::string_view name)
+      : tracer_(tracer), category_(category), name_(name) {
+    if (tracer_ != nullptr) {
+      begin_ = Tracer::Clock::now();
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  ~TraceSpan() {
+    if (tracer_ != nullptr) {
+      tracer_->record(category_, name_, begin_, Tracer::Clock::now());
+    }
+  }
+
+ private:
+  Tracer* tracer_;
+  const char* category_;
+  std::string_view name_;
+  Tracer::Clock::time_point begin_;
+};
+
+}  // namespace engine
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/tracer_test.cpp
+ * \see  utility/tracer.hpp
+ */
+
+#include <sstream>  // for stringstream
+#include <string>   // for string
+#include <thread>   // for thread
+#include <vector>   // for vector<>
+
+#include <gtest/gtest.h>
+
+#include <cloe/core.hpp>  // for Json
+
+#include "utility/tracer.hpp"  // for Tracer, TraceSpan
+
+using engine::Tracer;
+using engine::TraceSpan;
+
+TEST(engine_tracer, ring_buffer) {
+  Tracer t(3);
+  for (int i = 0; i < 5; ++i) {
+    TraceSpan span(&t, "test", std::to_string(i));
+  }
+  EXPECT_EQ(t.size(), 3);
+  EXPECT_EQ(t.dropped(), 2);
+
+  // The oldest events are dropped, the rest stay in order.
+  auto events = t.events();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].second->name, "2");
+  EXPECT_EQ(events[1].second->name, "3");
+  EXPECT_EQ(events[2].second->name, "4");
+}
+
+TEST(engine_tracer, null_span) {
+  TraceSpan span(nullptr, "test", "nothing");
+}
+
+TEST(engine_tracer, threads) {
+  Tracer t(1000);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&t]() {
+      for (int k = 0; k < 100; ++k) {
+        TraceSpan span(&t, "test", "work");
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  EXPECT_EQ(t.size(), 400);
+  EXPECT_EQ(t.dropped(), 0);
+
+  // A new tracer in the same thread does not reuse the buffer of the old one.
+  Tracer u(10);
+  { TraceSpan span(&u, "test", "a"); }
+  { TraceSpan span(&t, "test", "b"); }
+  EXPECT_EQ(u.size(), 1);
+  EXPECT_EQ(t.size(), 401);
+}
+
+TEST(engine_tracer, chrome_json) {
+  Tracer t(10);
+  {
+    TraceSpan outer(&t, "state", "StepBegin");
+    TraceSpan inner(&t, "simulator", "nop \"quoted\"");
+  }
+
+  std::stringstream ss;
+  t.write_chrome_json(ss);
+  auto j = cloe::Json::parse(ss.str());
+  const auto& events = j["traceEvents"];
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0]["name"], "nop \"quoted\"");
+  EXPECT_EQ(events[0]["cat"], "simulator");
+  EXPECT_EQ(events[0]["ph"], "X");
+  EXPECT_EQ(events[1]["name"], "StepBegin");
+  EXPECT_LE(events[1]["ts"].get<double>(), events[0]["ts"].get<double>());
+  EXPECT_GE(events[1]["dur"].get<double>(), events[0]["dur"].get<double>());
+}
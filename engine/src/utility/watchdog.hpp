@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/watchdog.hpp
+ * \see  utility/watchdog_test.cpp
+ * \see  simulation_machine.hpp
+ */
+
+#pragma once
+
+#include <algorithm>           // for min
+#include <atomic>              // for atomic<>
+#include <chrono>              // for steady_clock, milliseconds
+#include <condition_variable>  // for condition_variable
+#include <cstdint>             // for int64_t
+#include <functional>          // for function<>
+#include <mutex>               // for mutex, unique_lock<>
+#include <thread>              // for thread
+#include <utility>             // for move
+
+#include "utility/state_machine.hpp"  // for StateId
+
+namespace engine {
+
+/**
+ * Watchdog monitors the time that states of the state machine take from a
+ * single long-lived thread.
+ *
+ * The monitored thread publishes a deadline for the state it is about to run
+ * with arm(), which only consists of a few atomic stores, so that the states
+ * can keep running inline. When the deadline passes before the next state is
+ * armed or the watchdog is disarmed, the timeout callback is called once from
+ * the watchdog thread.
+ *
+ * The watchdog thread wakes up at least every max_sleep, so that a deadline
+ * that is earlier than the one it is waiting for is noticed in time.
+ */
+class Watchdog {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using TimeoutCallback = std::function<void(StateId, std::chrono::milliseconds)>;
+
+  Watchdog(std::chrono::milliseconds max_sleep, TimeoutCallback on_timeout)
+      : max_sleep_(max_sleep), on_timeout_(std::move(on_timeout)) {
+    if (max_sleep_.count() <= 0) {
+      max_sleep_ = std::chrono::milliseconds(100);
+    }
+    thread_ = std::thread([this]() { this->run(); });
+  }
+
+  Watchdog(const Watchdog&) = delete;
+  Watchdog& operator=(const Watchdog&) = delete;
+
+  ~Watchdog() {
+    {
+      std::lock_guard<std::mutex> guard(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+  /**
+   * Start monitoring the state id, which must complete within timeout.
+   *
+   * A non-positive timeout disarms the watchdog.
+   */
+  void arm(StateId id, std::chrono::milliseconds timeout) {
+    // The deadline is cleared first and set last, so that the watchdog
+    // thread can detect that it read the state of another deadline.
+    deadline_ = 0;
+    if (timeout.count() <= 0) {
+      return;
+    }
+    state_ = id;
+    timeout_ms_ = timeout.count();
+    deadline_ = (Clock::now() + timeout).time_since_epoch().count();
+  }
+
+  /**
+   * Stop monitoring the current state.
+   */
+  void disarm() { deadline_ = 0; }
+
+ private:
+  void run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    int64_t fired = 0;
+    while (!stop_) {
+      auto now = Clock::now();
+      auto wake = now + max_sleep_;
+      int64_t d = deadline_;
+      if (d != 0 && d != fired) {
+        auto deadline = Clock::time_point(Clock::duration(d));
+        if (now < deadline) {
+          wake = std::min(wake, deadline);
+        } else {
+          StateId id = state_;
+          std::chrono::milliseconds timeout(timeout_ms_);
+          if (deadline_ == d) {
+            fired = d;
+            lock.unlock();
+            on_timeout_(id, timeout);
+            lock.lock();
+          }
+          continue;
+        }
+      }
+      cv_.wait_until(lock, wake, [this]() { return stop_; });
+    }
+  }
+
+ private:
+  std::chrono::milliseconds max_sleep_;
+  TimeoutCallback on_timeout_;
+
+  // Published by the monitored thread:
+  std::atomic<int64_t> deadline_{0};  // time since clock epoch, or 0 if disarmed
+  std::atomic<StateId> state_{nullptr};
+  std::atomic<int64_t> timeout_ms_{0};
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  std::thread thread_;
+};
+
+}  // namespace engine
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file utility/watchdog_test.cpp
+ * \see  utility/watchdog.hpp
+ */
+
+#include <atomic>  // for atomic<>
+#include <chrono>  // for milliseconds
+#include <thread>  // for this_thread
+
+#include <gtest/gtest.h>
+
+#include "utility/watchdog.hpp"  // for Watchdog
+
+using namespace std::chrono_literals;  // NOLINT(build/namespaces)
+
+namespace {
+
+constexpr engine::StateId SLOW = "SLOW";
+constexpr engine::StateId FAST = "FAST";
+
+}  // anonymous namespace
+
+TEST(engine_watchdog, timeout_fires_once) {
+  std::atomic<int> count{0};
+  std::atomic<engine::StateId> timed_out{nullptr};
+  engine::Watchdog w(5ms, [&](engine::StateId id, std::chrono::milliseconds timeout) {
+    EXPECT_EQ(timeout, 10ms);
+    timed_out = id;
+    count++;
+  });
+
+  w.arm(SLOW, 10ms);
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(timed_out, SLOW);
+  w.disarm();
+}
+
+TEST(engine_watchdog, no_timeout_when_rearmed_or_disarmed) {
+  std::atomic<int> count{0};
+  engine::Watchdog w(5ms, [&](engine::StateId, std::chrono::milliseconds) { count++; });
+
+  // Each state completes well within its timeout.
+  for (int i = 0; i < 10; ++i) {
+    w.arm(FAST, 50ms);
+    std::this_thread::sleep_for(2ms);
+  }
+  w.disarm();
+  std::this_thread::sleep_for(80ms);
+
+  // A timeout of zero means no timeout.
+  w.arm(SLOW, 0ms);
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(count, 0);
+}
+
+TEST(engine_watchdog, earlier_deadline_is_noticed) {
+  std::atomic<int> count{0};
+  engine::Watchdog w(5ms, [&](engine::StateId id, std::chrono::milliseconds) {
+    EXPECT_EQ(id, FAST);
+    count++;
+  });
+
+  // The watchdog thread is waiting for the long deadline when the short
+  // one is armed.
+  w.arm(SLOW, 10'000ms);
+  std::this_thread::sleep_for(10ms);
+  w.arm(FAST, 10ms);
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(count, 1);
+}
@@ -257,7 +257,7 @@ class FactoryBase : public Base<CRTP> {
    * Add or replace a factory with the given key, schema, and function.
    */
   void set_factory(const std::string& key, Box&& s, MakeFunc f) {
-    if (!available_.count(key)) {
+    if (available_.count(key)) {
       available_.erase(key);
     }
     available_.insert(std::make_pair(key, TypeFactory{std::move(s), std::move(f)}));
@@ -370,25 +370,33 @@ class FactoryBase : public Base<CRTP> {
     std::vector<Box> out;
     out.reserve(available_.size());
     for (auto& kv : available_) {
-      Struct base{
-          {factory_key_, make_const_schema(kv.first, "name of factory").require()},
-      };
-      if (args_key_.empty()) {
-        base.set_properties_from(kv.second.schema);
-      } else {
-        base.set_property(args_key_, kv.second.schema.clone());
-      }
-      base.reset_ptr();
-
-      if (transform_func_) {
-        out.emplace_back(transform_func_(std::move(base)));
-      } else {
-        out.emplace_back(std::move(base));
-      }
+      out.emplace_back(factory_schema(kv));
     }
     return out;
   }
 
+  /**
+   * Return the schema of the input for a single factory, which is one of
+   * the variants of the schema of this factory.
+   */
+  [[nodiscard]] Box factory_schema(const typename FactoryMap::value_type& kv) const {
+    Struct base{
+        {factory_key_, make_const_schema(kv.first, "name of factory").require()},
+    };
+    if (args_key_.empty()) {
+      base.set_properties_from(kv.second.schema);
+    } else {
+      base.set_property(args_key_, kv.second.schema.clone());
+    }
+    base.reset_ptr();
+
+    if (transform_func_) {
+      return transform_func_(std::move(base));
+    } else {
+      return base;
+    }
+  }
+
   [[nodiscard]] std::vector<Json> factory_json_schemas() const {
     auto schemas = factory_schemas();
     std::vector<Json> out;
@@ -22,15 +22,15 @@
 
 #pragma once
 
-#include <map>     // for map
-#include <vector>  // for vector
-
-#include <Eigen/Geometry>  // for Vector3d
+#include <boost/container/flat_map.hpp>  // for flat_map<>
+#include <Eigen/Geometry>                 // for Vector3d
 
 #include <fable/confable.hpp> // for Confable
 #include <fable/fable_fwd.hpp> // for Schema
 #include <fable/enum.hpp> // for ENUM_SERIALIZATION
 
+#include <cloe/utility/cow_vector.hpp>  // for CowVector
+
 namespace cloe {
 
 class LaneBoundary : public fable::Confable {
@@ -69,10 +69,24 @@ class LaneBoundary : public fable::Confable {
   Type type{Type::Unknown};
   Color color{Color::Unknown};
 
-  std::vector<Eigen::Vector3d> points;
+  /**
+   * Polyline of the lane boundary.
+   *
+   * The points are shared between copies of a LaneBoundary until they are
+   * modified, so lane boundaries can be copied cheaply from one sensor
+   * component to the next.
+   */
+  utility::CowVector<Eigen::Vector3d> points;
 };
 
-using LaneBoundaries = std::map<int, LaneBoundary>;
+/**
+ * LaneBoundaries maps lane boundary ids to lane boundaries, sorted by id.
+ *
+ * A flat map is used because lane boundaries are inserted once per step,
+ * mostly in order, and then only iterated over. When filling it in order,
+ * prefer emplace_hint with end() and reuse the container across steps.
+ */
+using LaneBoundaries = boost::container::flat_map<int, LaneBoundary>;
 void to_json(fable::Json& j, const LaneBoundaries& lbs);
 
 // clang-format off
@@ -88,11 +88,10 @@ class LaneBoundarySensorFilter : public LaneBoundarySensor {
    */
   const LaneBoundaries& sensed_lane_boundaries() const override {
     if (!cached_) {
+      // Lane boundaries share their points, so copying them is cheap.
       for (const auto& kv : sensor_->sensed_lane_boundaries()) {
-        auto lb = kv.second;
-        auto id = kv.first;
-        if (filter_func_(lb)) {
-          lbs_.insert(std::pair<int, LaneBoundary>(id, lb));
+        if (filter_func_(kv.second)) {
+          lbs_.emplace_hint(lbs_.end(), kv.first, kv.second);
         }
       }
       cached_ = true;
@@ -144,7 +143,7 @@ class LaneBoundarySensorFilter : public LaneBoundarySensor {
   }
 
  private:
-  mutable bool cached_;
+  mutable bool cached_{false};
   mutable LaneBoundaries lbs_;
   std::shared_ptr<LaneBoundarySensor> sensor_;
   LaneBoundaryFilter filter_func_;
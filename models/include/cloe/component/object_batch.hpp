@@ -0,0 +1,208 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/component/object_batch.hpp
+ * \see  cloe/component/object_batch.cpp
+ * \see  cloe/component/object.hpp
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr<>
+#include <utility>  // for move
+#include <vector>   // for vector<>
+
+#include <Eigen/Geometry>  // for Isometry3d, Matrix
+
+#include <cloe/component/object.hpp>  // for Object, Objects
+
+namespace cloe {
+
+/**
+ * ObjectBatch stores a collection of objects as a structure of arrays.
+ *
+ * Each vector-valued field of Object is stored as a column-major N x 3
+ * matrix, so that the x, y, and z values of all objects are contiguous in
+ * memory. This allows operations on all objects, such as transformations,
+ * to be vectorized instead of chasing a pointer per object.
+ *
+ * The orientation of each object is stored as the 9 coefficients of its
+ * rotation matrix (in column-major order), in the same way.
+ *
+ * Storage is kept when the batch is cleared or reassigned, so a batch that
+ * is reused every step does not allocate once it has reached its peak size.
+ *
+ * For compatibility with components that work with Objects, a batch can be
+ * created from and converted back to Objects.
+ */
+class ObjectBatch {
+ public:
+  using Column = Eigen::Matrix<double, Eigen::Dynamic, 3>;
+  using ColumnRef = Column::RowsBlockXpr;
+  using ConstColumnRef = Column::ConstRowsBlockXpr;
+  using RotationColumn = Eigen::Matrix<double, Eigen::Dynamic, 9>;
+  using RotationColumnRef = RotationColumn::RowsBlockXpr;
+  using ConstRotationColumnRef = RotationColumn::ConstRowsBlockXpr;
+
+  ObjectBatch() = default;
+  explicit ObjectBatch(const Objects& objects) { assign(objects); }
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /**
+   * Make sure that there is space for n objects without reallocating.
+   */
+  void reserve(size_t n);
+
+  /**
+   * Remove all objects, but keep the storage.
+   */
+  void clear() { resize(0); }
+
+  /**
+   * Replace the contents of the batch with the given objects.
+   */
+  void assign(const Objects& objects);
+
+  /**
+   * Append a copy of the object.
+   */
+  void push_back(const Object& o);
+
+  /**
+   * Return a copy of the i-th object.
+   */
+  [[nodiscard]] Object object(size_t i) const {
+    Object o;
+    store(i, o);
+    return o;
+  }
+
+  /**
+   * Write all objects into out, which is resized to the size of the batch.
+   *
+   * Objects in out that are not shared with anyone else are reused, so
+   * that converting a batch every step to the same Objects does not
+   * allocate either.
+   */
+  void to_objects(Objects& out) const;
+
+  /**
+   * Write all objects into out, which is cleared first, using make to
+   * create each object.
+   *
+   * This allows the objects to be allocated from a step arena:
+   *
+   *     batch.to_objects(out, [this]() { return make_step_shared<Object>(); });
+   */
+  template <typename MakeObject>
+  void to_objects(Objects& out, MakeObject make) const {
+    out.clear();
+    out.reserve(size_);
+    for (size_t i = 0; i < size_; ++i) {
+      std::shared_ptr<Object> o = make();
+      store(i, *o);
+      out.emplace_back(std::move(o));
+    }
+  }
+
+  /**
+   * Return all objects as new Objects.
+   */
+  [[nodiscard]] Objects to_objects() const {
+    Objects out;
+    to_objects(out);
+    return out;
+  }
+
+  /**
+   * Transform all objects by the given isometry, which is equivalent to
+   *
+   *     o.pose = t * o.pose;
+   *     o.velocity = t.rotation() * o.velocity;
+   *     o.acceleration = t.rotation() * o.acceleration;
+   *     o.angular_velocity = t.rotation() * o.angular_velocity;
+   *
+   * for each object o.
+   */
+  void transform(const Eigen::Isometry3d& t);
+
+  /**
+   * Keep only the objects with the given indices, which must be in
+   * ascending order, and remove all others.
+   */
+  void keep(const size_t* indices, size_t n);
+  void keep(const std::vector<size_t>& indices) { keep(indices.data(), indices.size()); }
+
+  /**
+   * Return the yaw of the i-th object in [rad].
+   */
+  [[nodiscard]] double yaw(size_t i) const;
+
+  // Columns --------------------------------------------------------------
+  std::vector<int>& ids() { return ids_; }
+  const std::vector<int>& ids() const { return ids_; }
+  std::vector<double>& exist_probs() { return exist_probs_; }
+  const std::vector<double>& exist_probs() const { return exist_probs_; }
+  std::vector<Object::Type>& types() { return types_; }
+  const std::vector<Object::Type>& types() const { return types_; }
+  std::vector<Object::Class>& classifications() { return classifications_; }
+  const std::vector<Object::Class>& classifications() const { return classifications_; }
+
+  ColumnRef positions() { return positions_.topRows(size_); }
+  ConstColumnRef positions() const { return positions_.topRows(size_); }
+  RotationColumnRef rotations() { return rotations_.topRows(size_); }
+  ConstRotationColumnRef rotations() const { return rotations_.topRows(size_); }
+  ColumnRef dimensions() { return dimensions_.topRows(size_); }
+  ConstColumnRef dimensions() const { return dimensions_.topRows(size_); }
+  ColumnRef cog_offsets() { return cog_offsets_.topRows(size_); }
+  ConstColumnRef cog_offsets() const { return cog_offsets_.topRows(size_); }
+  ColumnRef velocities() { return velocities_.topRows(size_); }
+  ConstColumnRef velocities() const { return velocities_.topRows(size_); }
+  ColumnRef accelerations() { return accelerations_.topRows(size_); }
+  ConstColumnRef accelerations() const { return accelerations_.topRows(size_); }
+  ColumnRef angular_velocities() { return angular_velocities_.topRows(size_); }
+  ConstColumnRef angular_velocities() const { return angular_velocities_.topRows(size_); }
+
+ private:
+  void resize(size_t n);
+  void load(size_t i, const Object& o);
+  void store(size_t i, Object& o) const;
+
+ private:
+  size_t size_{0};
+  size_t capacity_{0};
+
+  std::vector<int> ids_;
+  std::vector<double> exist_probs_;
+  std::vector<Object::Type> types_;
+  std::vector<Object::Class> classifications_;
+
+  Column positions_;
+  RotationColumn rotations_;
+  Column dimensions_;
+  Column cog_offsets_;
+  Column velocities_;
+  Column accelerations_;
+  Column angular_velocities_;
+};
+
+}  // namespace cloe
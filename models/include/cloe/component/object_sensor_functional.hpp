@@ -29,6 +29,7 @@
 #include <functional>  // for function
 #include <memory>      // for shared_ptr<>
 #include <string>      // for string
+#include <utility>     // for move
 
 #include <cloe/component/object.hpp>         // for Object
 #include <cloe/component/object_sensor.hpp>  // for ObjectSensor
@@ -48,9 +49,20 @@ using ObjectFilter = std::function<bool(const Object&)>;
  * - If it yields the object with changes, it should create a clone of the
  *   Object with `std::make_shared` first, and then make the changes.
  * - If it should skip the object, it should return nullptr.
+ *
+ * If most objects are changed, prefer ObjectMap, which does not allocate a
+ * clone of each object every step.
  */
 using ObjectFilterMap = std::function<std::shared_ptr<Object>(const std::shared_ptr<Object>&)>;
 
+/**
+ * ObjectMap may modify a copy of an object in place.
+ *
+ * - The copy is created from the step arena of the vehicle.
+ * - If it should skip the object, it should return false.
+ */
+using ObjectMap = std::function<bool(Object&)>;
+
 /**
  * ObjectSensorFilter filters objects from an ObjectSensor, and can be used in
  * place of the original ObjectSensor.
@@ -152,7 +164,7 @@ class ObjectSensorFilter : public ObjectSensor {
   }
 
  private:
-  mutable bool cached_;
+  mutable bool cached_{false};
   mutable Objects objects_;
   std::shared_ptr<ObjectSensor> sensor_;
   ObjectFilter filter_func_;
@@ -165,6 +177,10 @@ class ObjectSensorFilter : public ObjectSensor {
  * This class can be used in a very functional way, and the use of C++11
  * lambdas is highly highly recommended!
  *
+ * When constructed with an ObjectMap, the copies that are mapped are created
+ * with make_step_shared, so that mapping objects does not allocate memory
+ * every step once the sensor is part of a vehicle.
+ *
  * Warning: Do not rely on volatile state that can change within a step for the
  * filter function.  This ObjectSensor filter class caches the resulting vector
  * of filtered objects till clear_cache is called.
@@ -175,14 +191,24 @@ class ObjectSensorFilterMap : public ObjectSensor {
                         ObjectFilterMap f)
       : ObjectSensor(name), sensor_(obs), map_func_(f) {}
 
+  ObjectSensorFilterMap(const std::string& name, std::shared_ptr<ObjectSensor> obs, ObjectMap f)
+      : ObjectSensor(name), sensor_(obs), map_in_place_(std::move(f)) {}
+
   virtual ~ObjectSensorFilterMap() noexcept = default;
 
   const Objects& sensed_objects() const override {
     if (!cached_) {
-      for (auto o : sensor_->sensed_objects()) {
-        auto obj = map_func_(o);
-        if (obj) {
-          objects_.push_back(obj);
+      for (const auto& o : sensor_->sensed_objects()) {
+        if (map_in_place_) {
+          auto obj = make_step_shared<Object>(*o);
+          if (map_in_place_(*obj)) {
+            objects_.push_back(std::move(obj));
+          }
+        } else {
+          auto obj = map_func_(o);
+          if (obj) {
+            objects_.push_back(std::move(obj));
+          }
         }
       }
       cached_ = true;
@@ -234,10 +260,11 @@ class ObjectSensorFilterMap : public ObjectSensor {
   }
 
  protected:
-  mutable bool cached_;
+  mutable bool cached_{false};
   mutable Objects objects_;
   std::shared_ptr<ObjectSensor> sensor_;
   ObjectFilterMap map_func_;
+  ObjectMap map_in_place_;
 };
 
 }  // namespace cloe
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/cow_vector.hpp
+ * \see  cloe/utility/cow_vector_test.cpp
+ * \see  cloe/component/lane_boundary.hpp
+ */
+
+#pragma once
+
+#include <cstddef>           // for size_t
+#include <initializer_list>  // for initializer_list<>
+#include <memory>            // for shared_ptr<>, make_shared
+#include <utility>           // for move, forward
+#include <vector>            // for vector<>
+
+#include <fable/json.hpp>  // for Json
+
+namespace cloe::utility {
+
+/**
+ * CowVector is a vector with shared, copy-on-write storage.
+ *
+ * Copying a CowVector only copies a reference to the storage, so values that
+ * contain large vectors, such as lane boundary polylines, can be passed
+ * through a chain of components cheaply. The storage is copied on the first
+ * modification of a CowVector that shares it with another.
+ *
+ * Only const access is provided through the vector interface, so that reading
+ * never causes a copy. Use mutate() to get a reference to the vector for
+ * modification.
+ *
+ * Like shared_ptr, different CowVector instances may be used concurrently,
+ * but the same instance may not be modified concurrently.
+ */
+template <typename T>
+class CowVector {
+ public:
+  using vector_type = std::vector<T>;
+  using value_type = T;
+  using size_type = typename vector_type::size_type;
+  using const_reference = typename vector_type::const_reference;
+  using const_iterator = typename vector_type::const_iterator;
+  using iterator = const_iterator;
+
+  CowVector() = default;
+  CowVector(vector_type v) : data_(std::make_shared<vector_type>(std::move(v))) {}  // NOLINT
+  CowVector(std::initializer_list<T> xs) : data_(std::make_shared<vector_type>(xs)) {}
+
+  CowVector& operator=(vector_type v) {
+    if (data_ && data_.use_count() == 1) {
+      *data_ = std::move(v);
+    } else {
+      data_ = std::make_shared<vector_type>(std::move(v));
+    }
+    return *this;
+  }
+
+  CowVector& operator=(std::initializer_list<T> xs) { return *this = vector_type(xs); }
+
+  /**
+   * Return a reference to the underlying vector.
+   */
+  [[nodiscard]] const vector_type& get() const { return data_ ? *data_ : empty_vector(); }
+  operator const vector_type&() const { return get(); }  // NOLINT
+
+  /**
+   * Return a reference to the underlying vector for modification.
+   *
+   * If the storage is shared with another CowVector, it is copied first.
+   * The reference is invalidated when this CowVector is copied.
+   */
+  vector_type& mutate() {
+    if (!data_) {
+      data_ = std::make_shared<vector_type>();
+    } else if (data_.use_count() != 1) {
+      data_ = std::make_shared<vector_type>(*data_);
+    }
+    return *data_;
+  }
+
+  /**
+   * Return true if this CowVector shares its storage with another.
+   */
+  [[nodiscard]] bool is_shared() const { return data_ && data_.use_count() != 1; }
+
+  [[nodiscard]] bool empty() const { return get().empty(); }
+  [[nodiscard]] size_type size() const { return get().size(); }
+  [[nodiscard]] const T* data() const { return get().data(); }
+  [[nodiscard]] const_iterator begin() const { return get().begin(); }
+  [[nodiscard]] const_iterator end() const { return get().end(); }
+  [[nodiscard]] const_reference operator[](size_type i) const { return get()[i]; }
+  [[nodiscard]] const_reference at(size_type i) const { return get().at(i); }
+  [[nodiscard]] const_reference front() const { return get().front(); }
+  [[nodiscard]] const_reference back() const { return get().back(); }
+
+  void reserve(size_type n) { mutate().reserve(n); }
+  void push_back(const T& x) { mutate().push_back(x); }
+  void push_back(T&& x) { mutate().push_back(std::move(x)); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    return mutate().emplace_back(std::forward<Args>(args)...);
+  }
+
+  /**
+   * Remove all elements, keeping the capacity if the storage is not shared.
+   */
+  void clear() {
+    if (data_ && data_.use_count() == 1) {
+      data_->clear();
+    } else {
+      data_.reset();
+    }
+  }
+
+  friend bool operator==(const CowVector& a, const CowVector& b) {
+    return a.data_ == b.data_ || a.get() == b.get();
+  }
+  friend bool operator!=(const CowVector& a, const CowVector& b) { return !(a == b); }
+
+  friend void to_json(fable::Json& j, const CowVector& v) { j = v.get(); }
+
+ private:
+  static const vector_type& empty_vector() {
+    static const vector_type v;
+    return v;
+  }
+
+ private:
+  std::shared_ptr<vector_type> data_;
+};
+
+}  // namespace cloe::utility
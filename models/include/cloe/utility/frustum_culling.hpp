@@ -21,7 +21,11 @@
 
 #pragma once
 
-#include <cmath>  // for cos, sin
+#include <cmath>      // for cos, sin
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t
+#include <stdexcept>  // for runtime_error
+#include <vector>     // for vector<>
 
 #include <fmt/format.h>                // for format
 #include <Eigen/Geometry>              // for Vector3d
@@ -102,50 +106,188 @@ bool is_inside_fov(double fov, bool is_left_0_p1, bool is_left_0_p2, std::string
   return is_inside_fov;
 }
 
-bool is_point_inside_frustum(const cloe::Frustum& frustum, const Eigen::Vector3d& point) {
-  bool ret_val{false};
-
-  // calculate points in "frustum" sensor coordinate system, which starts at the frustum root
-  // and has x in viewing direction, and y to the left and z in the up direction.
-  auto corner_points_x_y_plane =
-      calc_corner_points(frustum.fov_h, frustum.offset_h, frustum.clip_far);
-  auto corner_points_x_z_plane =
-      calc_corner_points(frustum.fov_v, frustum.offset_v, frustum.clip_far);
-
-  // calculate for xy plane
-  bool is_left_0_p1 =
-      is_left(corner_points_x_y_plane[0], corner_points_x_y_plane[1], Point{point.x(), point.y()});
-  bool is_left_0_p2 =
-      is_left(corner_points_x_y_plane[0], corner_points_x_y_plane[2], Point{point.x(), point.y()});
-
-  bool is_inside_fov_xy =
-      is_inside_fov(frustum.fov_h, is_left_0_p1, is_left_0_p2,
-                    fmt::format("The field of view in horizontal direction of your function is not "
-                                "in the expected range of (0, 2*PI]. The value we got was {}",
-                                frustum.fov_h));
-
-  // now calculate for xz plane
-  is_left_0_p1 =
-      is_left(corner_points_x_z_plane[0], corner_points_x_z_plane[1], Point{point.z(), point.x()});
-  is_left_0_p2 =
-      is_left(corner_points_x_z_plane[0], corner_points_x_z_plane[2], Point{point.z(), point.x()});
-
-  bool is_inside_fov_xz =
-      is_inside_fov(frustum.fov_v, is_left_0_p1, is_left_0_p2,
-                    fmt::format("The field of view in vertical direction of your function is not "
-                                "in the expected range of (0, 2*PI]. The value we got was {}",
-                                frustum.fov_v));
-
-  // if we are inside the fovs, we still need to check if the distance is within clip_near and clip_far
-  if (is_inside_fov_xy && is_inside_fov_xz) {
-    double distance =
-        std::sqrt(std::pow(point.x(), 2) + std::pow(point.y(), 2) + std::pow(point.z(), 2));
-
-    if (distance >= frustum.clip_near && distance < frustum.clip_far) {
-      ret_val = true;
+/**
+ * CompiledFrustum is a precomputed representation of a Frustum, which can
+ * be used to efficiently test many points against the same frustum.
+ *
+ * The field of view is validated once on construction, and the containment
+ * tests do not allocate. The results are the same as those of the free
+ * functions above, with the exception that distances are compared squared.
+ *
+ * The compiled frustum does not track changes to the Frustum it was created
+ * from; use compiled_from() to check whether it needs to be recreated.
+ */
+class CompiledFrustum {
+ public:
+  CompiledFrustum() : CompiledFrustum(cloe::Frustum{}) {}
+
+  /**
+   * Compile the given frustum.
+   *
+   * A `std::runtime_error` is thrown if either field of view is not in the
+   * range (0, 2*PI].
+   */
+  explicit CompiledFrustum(const cloe::Frustum& frustum)
+      : fov_h_(frustum.fov_h)
+      , offset_h_(frustum.offset_h)
+      , fov_v_(frustum.fov_v)
+      , offset_v_(frustum.offset_v)
+      , clip_near_(frustum.clip_near)
+      , clip_far_(frustum.clip_far) {
+    if (!(fov_h_ > 0.0 && fov_h_ <= 2 * M_PI)) {
+      throw std::runtime_error(
+          fmt::format("The field of view in horizontal direction of your function is not "
+                      "in the expected range of (0, 2*PI]. The value we got was {}",
+                      fov_h_));
+    }
+    if (!(fov_v_ > 0.0 && fov_v_ <= 2 * M_PI)) {
+      throw std::runtime_error(
+          fmt::format("The field of view in vertical direction of your function is not "
+                      "in the expected range of (0, 2*PI]. The value we got was {}",
+                      fov_v_));
+    }
+    h_ = Plane::compile(fov_h_, offset_h_, clip_far_);
+    v_ = Plane::compile(fov_v_, offset_v_, clip_far_);
+    clip_near_sq_ = clip_near_ * clip_near_;
+    clip_far_sq_ = clip_far_ * clip_far_;
+  }
+
+  /**
+   * Return true if this was compiled from a frustum with the same values.
+   */
+  [[nodiscard]] bool compiled_from(const cloe::Frustum& frustum) const {
+    return fov_h_ == frustum.fov_h && offset_h_ == frustum.offset_h && fov_v_ == frustum.fov_v &&
+           offset_v_ == frustum.offset_v && clip_near_ == frustum.clip_near &&
+           clip_far_ == frustum.clip_far;
+  }
+
+  /**
+   * Return true if the point, given in the frustum coordinate system, is
+   * inside the frustum.
+   */
+  [[nodiscard]] bool contains(const Eigen::Vector3d& point) const noexcept {
+    return contains(point.x(), point.y(), point.z());
+  }
+
+  /**
+   * Return true if the point (x, y, z), given in the frustum coordinate
+   * system, is inside the frustum.
+   */
+  [[nodiscard]] bool contains(double x, double y, double z) const noexcept {
+    if (!h_.contains(x, y) || !v_.contains(z, x)) {
+      return false;
+    }
+    double distance_sq = x * x + y * y + z * z;
+    return distance_sq >= clip_near_sq_ && distance_sq < clip_far_sq_;
+  }
+
+  /**
+   * Test n points and store the results in result, which must have space
+   * for n values.
+   *
+   * Return the number of points inside the frustum.
+   */
+  size_t contains(const Eigen::Vector3d* points, size_t n, uint8_t* result) const noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+      bool inside = contains(points[i]);
+      result[i] = inside;
+      count += inside;
+    }
+    return count;
+  }
+
+  /**
+   * Test n points and store the indices of those inside the frustum in
+   * indices, which must have space for n values.
+   *
+   * Return the number of points inside the frustum.
+   */
+  size_t select(const Eigen::Vector3d* points, size_t n, size_t* indices) const noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+      // Always write, so that the loop has no data-dependent branch.
+      indices[count] = i;
+      count += contains(points[i]);
     }
+    return count;
   }
-  return ret_val;
+
+  /**
+   * Same as above, but for n points stored as separate arrays of x, y, and
+   * z coordinates, such as the columns of an ObjectBatch.
+   */
+  size_t select(const double* x, const double* y, const double* z, size_t n,
+                size_t* indices) const noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+      indices[count] = i;
+      count += contains(x[i], y[i], z[i]);
+    }
+    return count;
+  }
+
+  /**
+   * Return the indices of those points inside the frustum.
+   */
+  std::vector<size_t> select(const std::vector<Eigen::Vector3d>& points) const {
+    std::vector<size_t> indices(points.size());
+    indices.resize(select(points.data(), points.size(), indices.data()));
+    return indices;
+  }
+
+ private:
+  /**
+   * Plane holds the normals of the two lines bounding the field of view
+   * in one plane.
+   *
+   * \see calc_corner_points
+   * \see is_left
+   * \see is_inside_fov
+   */
+  struct Plane {
+    Point n1;
+    Point n2;
+    bool wide;
+
+    static Plane compile(double fov, double offset, double clip_far) {
+      // Same as calc_corner_points, but without allocating.
+      Point p1 = rotate_point(
+          Point{clip_far * std::cos(-fov / 2.0), clip_far * std::sin(-fov / 2.0)}, offset);
+      Point p2 = rotate_point(
+          Point{clip_far * std::cos(fov / 2.0), clip_far * std::sin(fov / 2.0)}, offset);
+      return Plane{Point{-p1.y, p1.x}, Point{-p2.y, p2.x}, fov >= M_PI};
+    }
+
+    bool contains(double a, double b) const noexcept {
+      bool is_left_p1 = n1.x * a + n1.y * b > 0;
+      bool is_left_p2 = n2.x * a + n2.y * b > 0;
+      return wide ? (is_left_p1 || !is_left_p2) : (is_left_p1 && !is_left_p2);
+    }
+  };
+
+ private:
+  double fov_h_;
+  double offset_h_;
+  double fov_v_;
+  double offset_v_;
+  double clip_near_;
+  double clip_far_;
+
+  Plane h_;
+  Plane v_;
+  double clip_near_sq_;
+  double clip_far_sq_;
+};
+
+/**
+ * Return true if the point is inside the frustum.
+ *
+ * If many points need to be tested against the same frustum, use
+ * CompiledFrustum instead.
+ */
+inline bool is_point_inside_frustum(const cloe::Frustum& frustum, const Eigen::Vector3d& point) {
+  return CompiledFrustum(frustum).contains(point);
 }
 
 }  // namespace cloe::utility
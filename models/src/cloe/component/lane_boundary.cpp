@@ -74,7 +74,7 @@ fable::Schema LaneBoundary::schema_impl() {
 }
 
 void to_json(fable::Json& j, const LaneBoundaries& lbs) {
-  for (auto lb_pair : lbs) {
+  for (const auto& lb_pair : lbs) {
     j[std::to_string(lb_pair.first)] = lb_pair.second;
   }
 }
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/component/object_batch.cpp
+ * \see  cloe/component/object_batch.hpp
+ */
+
+#include <cloe/component/object_batch.hpp>
+
+#include <algorithm>  // for max
+#include <cassert>    // for assert
+#include <cmath>      // for atan2
+#include <memory>     // for make_shared
+
+namespace cloe {
+
+void ObjectBatch::reserve(size_t n) {
+  if (n <= capacity_) {
+    return;
+  }
+  auto rows = static_cast<Eigen::Index>(n);
+  ids_.reserve(n);
+  exist_probs_.reserve(n);
+  types_.reserve(n);
+  classifications_.reserve(n);
+  positions_.conservativeResize(rows, Eigen::NoChange);
+  rotations_.conservativeResize(rows, Eigen::NoChange);
+  dimensions_.conservativeResize(rows, Eigen::NoChange);
+  cog_offsets_.conservativeResize(rows, Eigen::NoChange);
+  velocities_.conservativeResize(rows, Eigen::NoChange);
+  accelerations_.conservativeResize(rows, Eigen::NoChange);
+  angular_velocities_.conservativeResize(rows, Eigen::NoChange);
+  capacity_ = n;
+}
+
+void ObjectBatch::resize(size_t n) {
+  if (n > capacity_) {
+    reserve(std::max(n, 2 * capacity_));
+  }
+  ids_.resize(n);
+  exist_probs_.resize(n);
+  types_.resize(n);
+  classifications_.resize(n);
+  size_ = n;
+}
+
+void ObjectBatch::assign(const Objects& objects) {
+  resize(objects.size());
+  for (size_t i = 0; i < size_; ++i) {
+    assert(objects[i] != nullptr);
+    load(i, *objects[i]);
+  }
+}
+
+void ObjectBatch::push_back(const Object& o) {
+  resize(size_ + 1);
+  load(size_ - 1, o);
+}
+
+void ObjectBatch::load(size_t i, const Object& o) {
+  auto row = static_cast<Eigen::Index>(i);
+  ids_[i] = o.id;
+  exist_probs_[i] = o.exist_prob;
+  types_[i] = o.type;
+  classifications_[i] = o.classification;
+  positions_.row(row) = o.pose.translation().transpose();
+  for (int c = 0; c < 3; ++c) {
+    for (int r = 0; r < 3; ++r) {
+      rotations_(row, 3 * c + r) = o.pose.linear()(r, c);
+    }
+  }
+  dimensions_.row(row) = o.dimensions.transpose();
+  cog_offsets_.row(row) = o.cog_offset.transpose();
+  velocities_.row(row) = o.velocity.transpose();
+  accelerations_.row(row) = o.acceleration.transpose();
+  angular_velocities_.row(row) = o.angular_velocity.transpose();
+}
+
+void ObjectBatch::store(size_t i, Object& o) const {
+  assert(i < size_);
+  auto row = static_cast<Eigen::Index>(i);
+  o.id = ids_[i];
+  o.exist_prob = exist_probs_[i];
+  o.type = types_[i];
+  o.classification = classifications_[i];
+  for (int c = 0; c < 3; ++c) {
+    for (int r = 0; r < 3; ++r) {
+      o.pose.linear()(r, c) = rotations_(row, 3 * c + r);
+    }
+  }
+  o.pose.translation() = positions_.row(row).transpose();
+  o.pose.makeAffine();
+  o.dimensions = dimensions_.row(row).transpose();
+  o.cog_offset = cog_offsets_.row(row).transpose();
+  o.velocity = velocities_.row(row).transpose();
+  o.acceleration = accelerations_.row(row).transpose();
+  o.angular_velocity = angular_velocities_.row(row).transpose();
+}
+
+void ObjectBatch::to_objects(Objects& out) const {
+  out.resize(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    if (out[i] == nullptr || out[i].use_count() != 1) {
+      out[i] = std::make_shared<Object>();
+    }
+    store(i, *out[i]);
+  }
+}
+
+void ObjectBatch::transform(const Eigen::Isometry3d& t) {
+  // Each row is a vector v, so R * v is computed as v^T * R^T for all rows.
+  const Eigen::Matrix3d rt = t.linear().transpose();
+  positions() = (positions() * rt).rowwise() + t.translation().transpose();
+  velocities() = velocities() * rt;
+  accelerations() = accelerations() * rt;
+  angular_velocities() = angular_velocities() * rt;
+
+  // Each rotation matrix is transformed column by column.
+  auto rot = rotations();
+  for (int c = 0; c < 3; ++c) {
+    rot.middleCols<3>(3 * c) = rot.middleCols<3>(3 * c) * rt;
+  }
+}
+
+void ObjectBatch::keep(const size_t* indices, size_t n) {
+  assert(n <= size_);
+  for (size_t k = 0; k < n; ++k) {
+    size_t i = indices[k];
+    assert(i >= k && i < size_);
+    assert(k == 0 || i > indices[k - 1]);
+    if (i == k) {
+      continue;
+    }
+    auto src = static_cast<Eigen::Index>(i);
+    auto dst = static_cast<Eigen::Index>(k);
+    ids_[k] = ids_[i];
+    exist_probs_[k] = exist_probs_[i];
+    types_[k] = types_[i];
+    classifications_[k] = classifications_[i];
+    positions_.row(dst) = positions_.row(src);
+    rotations_.row(dst) = rotations_.row(src);
+    dimensions_.row(dst) = dimensions_.row(src);
+    cog_offsets_.row(dst) = cog_offsets_.row(src);
+    velocities_.row(dst) = velocities_.row(src);
+    accelerations_.row(dst) = accelerations_.row(src);
+    angular_velocities_.row(dst) = angular_velocities_.row(src);
+  }
+  resize(n);
+}
+
+double ObjectBatch::yaw(size_t i) const {
+  auto row = static_cast<Eigen::Index>(i);
+  // Same as atan2(R(1,0), R(0,0)) of the rotation matrix R.
+  return std::atan2(rotations_(row, 1), rotations_(row, 0));
+}
+
+}  // namespace cloe
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/component/object_batch_test.cpp
+ * \see  cloe/component/object_batch.hpp
+ */
+
+#include <cmath>   // for M_PI
+#include <memory>  // for make_shared
+
+#include <gtest/gtest.h>
+
+#include <cloe/component/object_batch.hpp>
+
+namespace {
+
+cloe::Objects make_objects(size_t n) {
+  cloe::Objects objects;
+  for (size_t i = 0; i < n; ++i) {
+    auto o = std::make_shared<cloe::Object>();
+    double k = static_cast<double>(i);
+    o->id = static_cast<int>(i);
+    o->exist_prob = 1.0 / (k + 1.0);
+    o->type = cloe::Object::Type::Dynamic;
+    o->classification = cloe::Object::Class::Car;
+    o->pose = Eigen::Isometry3d::Identity();
+    o->pose.rotate(Eigen::AngleAxisd(0.1 * k, Eigen::Vector3d::UnitZ()));
+    o->pose.rotate(Eigen::AngleAxisd(0.01 * k, Eigen::Vector3d::UnitY()));
+    o->pose.translation() = Eigen::Vector3d(k, -2.0 * k, 0.5);
+    o->dimensions = Eigen::Vector3d(4.5, 1.8, 1.5);
+    o->cog_offset = Eigen::Vector3d(1.2, 0.0, 0.7);
+    o->velocity = Eigen::Vector3d(10.0 + k, 0.5, 0.0);
+    o->acceleration = Eigen::Vector3d(1.0, -k, 0.0);
+    o->angular_velocity = Eigen::Vector3d(0.0, 0.0, 0.01 * k);
+    objects.push_back(o);
+  }
+  return objects;
+}
+
+void expect_object_near(const cloe::Object& a, const cloe::Object& b) {
+  EXPECT_EQ(a.id, b.id);
+  EXPECT_EQ(a.exist_prob, b.exist_prob);
+  EXPECT_EQ(a.type, b.type);
+  EXPECT_EQ(a.classification, b.classification);
+  EXPECT_TRUE(a.pose.isApprox(b.pose, 1e-12));
+  EXPECT_TRUE(a.dimensions.isApprox(b.dimensions));
+  EXPECT_TRUE(a.cog_offset.isApprox(b.cog_offset));
+  EXPECT_TRUE(a.velocity.isApprox(b.velocity, 1e-12));
+  EXPECT_TRUE(a.acceleration.isApprox(b.acceleration, 1e-12));
+  EXPECT_TRUE(a.angular_velocity.isApprox(b.angular_velocity, 1e-12));
+}
+
+}  // anonymous namespace
+
+TEST(cloe_object_batch, round_trip) {
+  auto objects = make_objects(25);
+  cloe::ObjectBatch batch(objects);
+  ASSERT_EQ(batch.size(), objects.size());
+
+  auto result = batch.to_objects();
+  ASSERT_EQ(result.size(), objects.size());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    expect_object_near(*objects[i], *result[i]);
+    EXPECT_NEAR(batch.yaw(i), 0.1 * static_cast<double>(i), 1e-12);
+  }
+}
+
+TEST(cloe_object_batch, transform) {
+  auto objects = make_objects(25);
+  Eigen::Isometry3d mount = Eigen::Isometry3d::Identity();
+  mount.translate(Eigen::Vector3d(2.0, 0.5, 1.0));
+  mount.rotate(Eigen::AngleAxisd(M_PI / 2.0, Eigen::Vector3d::UnitZ()));
+
+  cloe::ObjectBatch batch(objects);
+  batch.transform(mount.inverse());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    // This is how ObjectFrustumCulling transformed each object before.
+    cloe::Object expected = *objects[i];
+    expected.pose = mount.inverse() * expected.pose;
+    expected.velocity = mount.inverse().rotation() * expected.velocity;
+    expected.acceleration = mount.inverse().rotation() * expected.acceleration;
+    expected.angular_velocity = mount.inverse().rotation() * expected.angular_velocity;
+    expect_object_near(expected, batch.object(i));
+  }
+}
+
+TEST(cloe_object_batch, keep) {
+  auto objects = make_objects(10);
+  cloe::ObjectBatch batch(objects);
+  batch.keep({0, 3, 4, 9});
+  ASSERT_EQ(batch.size(), 4);
+  expect_object_near(*objects[0], batch.object(0));
+  expect_object_near(*objects[3], batch.object(1));
+  expect_object_near(*objects[4], batch.object(2));
+  expect_object_near(*objects[9], batch.object(3));
+
+  batch.clear();
+  ASSERT_TRUE(batch.empty());
+  ASSERT_GE(batch.capacity(), 10);
+}
+
+TEST(cloe_object_batch, to_objects_reuses_unshared) {
+  cloe::ObjectBatch batch(make_objects(3));
+  cloe::Objects out;
+  batch.to_objects(out);
+  ASSERT_EQ(out.size(), 3);
+
+  auto* unshared = out[0].get();
+  auto shared = out[1];
+  batch.assign(make_objects(2));
+  batch.to_objects(out);
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_EQ(out[0].get(), unshared);
+  EXPECT_NE(out[1].get(), shared.get());
+  EXPECT_EQ(shared->id, 1);
+}
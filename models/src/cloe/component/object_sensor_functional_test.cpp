@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/component/object_sensor_functional_test.cpp
+ * \see  cloe/component/object_sensor_functional.hpp
+ */
+
+#include <memory>  // for make_shared
+
+#include <gtest/gtest.h>
+
+#include <cloe/component/object_sensor_functional.hpp>
+#include <cloe/utility/step_arena.hpp>  // for StepArena
+
+namespace {
+
+class FakeObjectSensor : public cloe::NopObjectSensor {
+ public:
+  explicit FakeObjectSensor(size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      auto o = std::make_shared<cloe::Object>();
+      o->id = static_cast<int>(i);
+      objects_.push_back(o);
+    }
+  }
+};
+
+}  // namespace
+
+TEST(models_object_sensor_functional, map_in_place_uses_step_arena) {
+  auto sensor = std::make_shared<FakeObjectSensor>(4);
+  auto arena = std::make_shared<cloe::utility::StepArena>();
+  cloe::ObjectSensorFilterMap filter_map("map", sensor, cloe::ObjectMap([](cloe::Object& o) {
+                                           o.id += 100;
+                                           return o.id % 2 == 0;
+                                         }));
+  filter_map.set_step_arena(arena);
+
+  const auto& objects = filter_map.sensed_objects();
+  ASSERT_EQ(objects.size(), 2);
+  EXPECT_EQ(objects[0]->id, 100);
+  EXPECT_EQ(objects[1]->id, 102);
+  EXPECT_EQ(arena->pool<cloe::Object>().size(), 4);
+
+  // The objects of the underlying sensor are not modified.
+  EXPECT_EQ(sensor->sensed_objects()[0]->id, 0);
+  EXPECT_EQ(sensor->sensed_objects()[2]->id, 2);
+}
+
+TEST(models_object_sensor_functional, filter_map_passes_objects_on) {
+  using ObjectPtr = std::shared_ptr<cloe::Object>;
+  auto sensor = std::make_shared<FakeObjectSensor>(4);
+  cloe::ObjectSensorFilterMap filter_map(
+      "filter_map", sensor, cloe::ObjectFilterMap([](const ObjectPtr& o) -> ObjectPtr {
+        return o->id < 2 ? o : nullptr;
+      }));
+
+  const auto& objects = filter_map.sensed_objects();
+  ASSERT_EQ(objects.size(), 2);
+  EXPECT_EQ(objects[0], sensor->sensed_objects()[0]);
+  EXPECT_EQ(objects[1], sensor->sensed_objects()[1]);
+}
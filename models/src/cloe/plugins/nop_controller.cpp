@@ -24,7 +24,8 @@
 
 #include <memory>  // for unique_ptr<>, make_unique<>
 
-#include <cloe/sync.hpp>  // for Sync
+#include <cloe/checkpoint.hpp>  // for CheckpointWriter, CheckpointReader
+#include <cloe/sync.hpp>        // for Sync
 
 namespace cloe::plugins {
 
@@ -43,6 +44,14 @@ class NopController : public Controller {
   }
 
   Duration process(const Sync& sync) override { return sync.time(); }
+
+  // The controller does nothing, so it never needs to wake up.
+  Duration next_wakeup(const Sync&) const override { return Duration::max(); }
+
+  // The controller is stateless, so its checkpoint is empty.
+  bool is_checkpointable() const override { return true; }
+  void save_state(CheckpointWriter&) const override {}
+  void load_state(CheckpointReader&) override {}
 };
 
 std::unique_ptr<Controller> NopControllerFactory::make(const Conf&) const {
@@ -27,6 +27,7 @@
 #include <string>      // for string
 #include <vector>      // for vector<>
 
+#include <cloe/checkpoint.hpp>                   // for CheckpointWriter, CheckpointReader
 #include <cloe/component/brake_sensor.hpp>       // for NopBrakeSensor
 #include <cloe/component/ego_sensor.hpp>         // for NopEgoSensor
 #include <cloe/component/gearbox_actuator.hpp>   // for GearboxActuator
@@ -141,6 +142,18 @@ class NopSimulator : public Simulator {
     return sync.time();
   }
 
+  // Without a termination function, the simulator does nothing and never
+  // needs to wake up.
+  Duration next_wakeup(const Sync& sync) const override {
+    return finfunc_ ? Simulator::next_wakeup(sync) : Duration::max();
+  }
+
+  // The vehicles do not change after connecting, so only the operational
+  // state is part of a checkpoint.
+  bool is_checkpointable() const override { return true; }
+  void save_state(CheckpointWriter& w) const override { w.write(operational_); }
+  void load_state(CheckpointReader& r) override { r.read(operational_); }
+
   friend void to_json(Json& j, const NopSimulator& b) {
     // clang-format off
     j = Json{
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/cow_vector_test.cpp
+ * \see  cloe/utility/cow_vector.hpp
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>  // for vector<>
+
+#include <fable/schema.hpp>  // for Schema
+
+#include <cloe/component/lane_boundary.hpp>  // for LaneBoundary, LaneBoundaries
+#include <cloe/utility/cow_vector.hpp>       // for CowVector
+
+using cloe::utility::CowVector;
+
+TEST(models_cow_vector, copy_shares_storage) {
+  CowVector<int> a{1, 2, 3};
+  EXPECT_FALSE(a.is_shared());
+
+  auto b = a;
+  EXPECT_TRUE(a.is_shared());
+  EXPECT_EQ(a.data(), b.data());
+  EXPECT_EQ(a, b);
+
+  // Reading never detaches.
+  EXPECT_EQ(b.at(1), 2);
+  EXPECT_EQ(b.back(), 3);
+  EXPECT_EQ(a.data(), b.data());
+}
+
+TEST(models_cow_vector, modification_detaches) {
+  CowVector<int> a{1, 2, 3};
+  auto b = a;
+  b.push_back(4);
+  EXPECT_FALSE(a.is_shared());
+  EXPECT_FALSE(b.is_shared());
+  EXPECT_NE(a.data(), b.data());
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_EQ(b.size(), 4);
+
+  // Modifying unshared storage does not copy.
+  const int* data = b.data();
+  b.mutate()[0] = 42;
+  EXPECT_EQ(b.data(), data);
+  EXPECT_EQ(b.front(), 42);
+  EXPECT_EQ(a.front(), 1);
+
+  // Assigning to shared storage does not affect the other copy.
+  auto c = a;
+  c = std::vector<int>{7};
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_EQ(c.size(), 1);
+
+  // Clearing shared storage only releases this reference.
+  auto d = a;
+  d.clear();
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(a.size(), 3);
+}
+
+TEST(models_cow_vector, lane_boundary_copies) {
+  cloe::LaneBoundary lb;
+  lb.id = 1;
+  lb.points = {Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(10, 0, 0), Eigen::Vector3d(20, 1, 0)};
+
+  cloe::LaneBoundaries lbs;
+  lbs.emplace_hint(lbs.end(), lb.id, lb);
+  lbs.emplace_hint(lbs.end(), 2, lb);
+  EXPECT_EQ(lbs.at(1).points.data(), lb.points.data());
+  EXPECT_EQ(lbs.at(2).points.data(), lb.points.data());
+
+  lbs.at(2).points.mutate()[0].x() = -1.0;
+  EXPECT_EQ(lb.points.front().x(), 0.0);
+  EXPECT_EQ(lbs.at(1).points.front().x(), 0.0);
+  EXPECT_EQ(lbs.at(2).points.front().x(), -1.0);
+
+  fable::Json j = lbs;
+  ASSERT_EQ(j["1"]["points"].size(), 3);
+}
@@ -20,8 +20,10 @@
  * \see  cloe/utility/frustum_culling.hpp
  */
 
+#include <array>
 #include <list>
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <cloe/utility/frustum_culling.hpp>
@@ -238,3 +240,84 @@ TEST(models_frustum_culling, is_point_inside_frustum_vary_offset_h) {
     i++;
   }
 }
+
+TEST(models_frustum_culling, compiled_frustum_invalid_fov) {
+  cloe::Frustum frustum{};
+  frustum.fov_h = 0.0;
+  EXPECT_THROW(cloe::utility::CompiledFrustum{frustum}, std::runtime_error);
+  frustum.fov_h = M_PI;
+  frustum.fov_v = 2.5 * M_PI;
+  EXPECT_THROW(cloe::utility::CompiledFrustum{frustum}, std::runtime_error);
+}
+
+TEST(models_frustum_culling, compiled_frustum_matches_free_functions) {
+  // The compiled frustum should come to the same result as the free functions
+  // it replaces, which are reimplemented here.
+  auto expected = [](const cloe::Frustum& f, const Eigen::Vector3d& p) {
+    using cloe::utility::is_left;
+    using cloe::utility::Point;
+    auto xy = cloe::utility::calc_corner_points(f.fov_h, f.offset_h, f.clip_far);
+    auto xz = cloe::utility::calc_corner_points(f.fov_v, f.offset_v, f.clip_far);
+    bool inside_xy =
+        cloe::utility::is_inside_fov(f.fov_h, is_left(xy[0], xy[1], Point{p.x(), p.y()}),
+                                     is_left(xy[0], xy[2], Point{p.x(), p.y()}), "");
+    bool inside_xz =
+        cloe::utility::is_inside_fov(f.fov_v, is_left(xz[0], xz[1], Point{p.z(), p.x()}),
+                                     is_left(xz[0], xz[2], Point{p.z(), p.x()}), "");
+    double distance = p.norm();
+    return inside_xy && inside_xz && distance >= f.clip_near && distance < f.clip_far;
+  };
+
+  std::vector<Eigen::Vector3d> points;
+  for (double x = -50.0; x <= 50.0; x += 7.3) {
+    for (double y = -50.0; y <= 50.0; y += 6.1) {
+      for (double z = -20.0; z <= 20.0; z += 4.7) {
+        points.emplace_back(x, y, z);
+      }
+    }
+  }
+
+  // clang-format off
+  std::list<std::array<double, 6>> frustums = {
+    // fov_h,      offset_h,    fov_v,       offset_v, clip_near, clip_far
+    {2.0 * M_PI,   0.0,         2.0 * M_PI,  0.0,      0.0,       480.0},
+    {M_PI / 2.0,   0.0,         M_PI / 4.0,  0.0,      0.0,       60.0},
+    {M_PI / 3.0,   M_PI / 2.0,  M_PI,        0.1,      5.0,       40.0},
+    {1.5 * M_PI,   -M_PI / 4.0, M_PI / 2.0,  0.0,      1.0,       30.0},
+    {M_PI,         M_PI,        1.5 * M_PI,  -0.2,     0.0,       70.0},
+  };
+  // clang-format on
+
+  for (const auto& values : frustums) {
+    cloe::Frustum frustum{};
+    frustum.fov_h = values[0];
+    frustum.offset_h = values[1];
+    frustum.fov_v = values[2];
+    frustum.offset_v = values[3];
+    frustum.clip_near = values[4];
+    frustum.clip_far = values[5];
+
+    cloe::utility::CompiledFrustum compiled{frustum};
+    ASSERT_TRUE(compiled.compiled_from(frustum));
+
+    std::vector<uint8_t> result(points.size());
+    size_t count = compiled.contains(points.data(), points.size(), result.data());
+    auto indices = compiled.select(points);
+    ASSERT_EQ(count, indices.size());
+
+    size_t j = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      bool inside = expected(frustum, points[i]);
+      EXPECT_EQ(inside, compiled.contains(points[i]));
+      EXPECT_EQ(inside, static_cast<bool>(result[i]));
+      if (inside) {
+        ASSERT_LT(j, indices.size());
+        EXPECT_EQ(i, indices[j++]);
+      }
+    }
+    EXPECT_EQ(j, indices.size());
+
+    frustum.clip_far += 1.0;
+    EXPECT_FALSE(compiled.compiled_from(frustum));
+  }
+}
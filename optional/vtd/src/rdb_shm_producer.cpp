@@ -0,0 +1,160 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file rdb_shm_producer.cpp
+ * \see  rdb_shm_producer.hpp
+ */
+
+#include "rdb_shm_producer.hpp"
+
+#include <algorithm>  // for min
+#include <cstring>    // for memcpy, memset
+#include <memory>     // for make_unique
+
+#include <boost/interprocess/exceptions.hpp>         // for interprocess_exception
+#include <boost/interprocess/xsi_shared_memory.hpp>  // for xsi_shared_memory, ...
+
+#include "rdb_transceiver_shm.hpp"  // for rdb_shm_flags, rdb_shm_set_flags
+
+namespace vtd {
+
+namespace {
+
+constexpr size_t align8(size_t n) { return (n + 7) & ~size_t{7}; }
+
+}  // anonymous namespace
+
+std::string make_rdb_message(uint32_t frame_number, double sim_time,
+                             const std::vector<RdbEntry>& entries) {
+  size_t data_size = 0;
+  for (const auto& e : entries) {
+    data_size += sizeof(RDB_MSG_ENTRY_HDR_t) + e.data.size();
+  }
+
+  RDB_MSG_HDR_t hdr{};
+  hdr.magicNo = RDB_MAGIC_NO;
+  hdr.version = RDB_VERSION;
+  hdr.headerSize = sizeof(RDB_MSG_HDR_t);
+  hdr.dataSize = static_cast<uint32_t>(data_size);
+  hdr.frameNo = frame_number;
+  hdr.simTime = sim_time;
+
+  std::string msg;
+  msg.reserve(sizeof(hdr) + data_size);
+  msg.append(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  for (const auto& e : entries) {
+    RDB_MSG_ENTRY_HDR_t entry{};
+    entry.headerSize = sizeof(RDB_MSG_ENTRY_HDR_t);
+    entry.dataSize = static_cast<uint32_t>(e.data.size());
+    entry.elementSize = e.element_size;
+    entry.pkgId = e.pkg_id;
+    entry.flags = e.flags;
+    msg.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    msg.append(e.data);
+  }
+  return msg;
+}
+
+RdbShmProducer::RdbShmProducer(key_t key, size_t buffer_size, uint8_t num_buffers) : key_(key) {
+  if (num_buffers == 0) {
+    throw RdbError("RdbShmProducer: require at least one buffer");
+  }
+
+  // Layout: header, buffer information for each buffer, buffers.
+  size_t header_size = sizeof(RDB_SHM_HDR_t);
+  size_t info_size = sizeof(RDB_SHM_BUFFER_INFO_t);
+  size_t buffers_offset = align8(header_size + num_buffers * info_size);
+  buffer_size = align8(buffer_size);
+  size_t total_size = buffers_offset + num_buffers * buffer_size;
+
+  try {
+    boost::interprocess::xsi_shared_memory shm(boost::interprocess::create_only,
+                                               boost::interprocess::xsi_key(key), total_size);
+    shm_id_ = shm.get_shmid();
+    region_ =
+        std::make_unique<boost::interprocess::mapped_region>(shm, boost::interprocess::read_write);
+  } catch (boost::interprocess::interprocess_exception& e) {
+    if (shm_id_ != -1) {
+      boost::interprocess::xsi_shared_memory::remove(shm_id_);
+    }
+    throw RdbError("RdbShmProducer: cannot create shared memory with key {:#x}: {}", key,
+                   e.what());
+  }
+
+  auto base = reinterpret_cast<char*>(region_->get_address());
+  std::memset(base, 0, total_size);
+  rdb_shm_hdr_ = reinterpret_cast<RDB_SHM_HDR_t*>(base);
+  rdb_shm_hdr_->headerSize = static_cast<uint32_t>(header_size);
+  rdb_shm_hdr_->dataSize = static_cast<uint32_t>(total_size - header_size);
+  rdb_shm_hdr_->noBuffers = num_buffers;
+  for (uint8_t i = 0; i < num_buffers; ++i) {
+    auto info = reinterpret_cast<RDB_SHM_BUFFER_INFO_t*>(base + header_size + i * info_size);
+    info->thisSize = static_cast<uint32_t>(info_size);
+    info->bufferSize = static_cast<uint32_t>(buffer_size);
+    info->id = i;
+    info->offset = static_cast<uint32_t>(buffers_offset + i * buffer_size);
+    info->flags = RDB_SHM_BUFFER_FLAG_NONE;
+    buffer_info_.push_back(info);
+  }
+}
+
+RdbShmProducer::~RdbShmProducer() {
+  // The segment is destroyed once all readers have detached.
+  boost::interprocess::xsi_shared_memory::remove(shm_id_);
+}
+
+int RdbShmProducer::free_buffer() const {
+  for (size_t i = 0; i < buffer_info_.size(); ++i) {
+    if (rdb_shm_flags(buffer_info_[i]) == RDB_SHM_BUFFER_FLAG_NONE) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool RdbShmProducer::publish(const std::vector<std::string>& messages, uint32_t release_mask) {
+  int buffer_id = free_buffer();
+  if (buffer_id == -1) {
+    return false;
+  }
+
+  auto info = buffer_info_[buffer_id];
+  size_t size = 0;
+  for (const auto& m : messages) {
+    size += m.size();
+  }
+  if (size > info->bufferSize) {
+    throw RdbError("RdbShmProducer: messages of {} bytes exceed buffer size {}", size,
+                   info->bufferSize);
+  }
+
+  char* pos = reinterpret_cast<char*>(rdb_shm_hdr_) + info->offset;
+  for (const auto& m : messages) {
+    std::memcpy(pos, m.data(), m.size());
+    pos += m.size();
+  }
+
+  // Terminate the messages with an empty header, if there is space left.
+  size_t remaining = info->bufferSize - size;
+  std::memset(pos, 0, std::min(remaining, sizeof(RDB_MSG_HDR_t)));
+
+  rdb_shm_set_flags(info, release_mask);
+  return true;
+}
+
+}  // namespace vtd
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file rdb_shm_producer.hpp
+ * \see  rdb_shm_producer.cpp
+ * \see  rdb_transceiver_shm.hpp
+ *
+ * This file provides a stand-in for the RDB shared memory output of VTD,
+ * so that RdbTransceiverShm can be tested without VTD.
+ */
+
+#pragma once
+
+#include <sys/types.h>  // for key_t
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint16_t, uint32_t
+#include <memory>       // for unique_ptr<>
+#include <string>       // for string
+#include <vector>       // for vector<>
+
+#include <boost/interprocess/mapped_region.hpp>  // for mapped_region
+
+#include "rdb_transceiver.hpp"  // for RDB_MSG_t
+
+namespace vtd {
+
+/**
+ * RdbEntry describes a single package entry of an RDB message.
+ */
+struct RdbEntry {
+  uint16_t pkg_id;
+  uint32_t element_size;
+  std::string data;
+  uint16_t flags{0};
+};
+
+/**
+ * Return an RDB message with the given entries, serialized as it would be
+ * written by VTD.
+ */
+std::string make_rdb_message(uint32_t frame_number, double sim_time,
+                             const std::vector<RdbEntry>& entries);
+
+/**
+ * RdbShmProducer creates an RDB shared memory segment and writes messages
+ * into it following the same buffer flag protocol as VTD.
+ *
+ * The segment is removed again when the producer is destroyed.
+ */
+class RdbShmProducer {
+ public:
+  static constexpr size_t default_buffer_size = 1024 * 1024;
+
+  /**
+   * Create a new shared memory segment with the given key.
+   *
+   * If the segment already exists, an RdbError is thrown.
+   */
+  explicit RdbShmProducer(key_t key, size_t buffer_size = default_buffer_size,
+                          uint8_t num_buffers = 2);
+  RdbShmProducer(const RdbShmProducer&) = delete;
+  RdbShmProducer& operator=(const RdbShmProducer&) = delete;
+  ~RdbShmProducer();
+
+  key_t key() const { return key_; }
+
+  /**
+   * Return true if there is a buffer which is neither locked nor still
+   * waiting to be read.
+   */
+  bool has_free_buffer() const { return free_buffer() >= 0; }
+
+  /**
+   * Write the messages into a free buffer and mark it as ready for readers
+   * with the given release mask.
+   *
+   * Return false if there is no free buffer. If the messages do not fit into
+   * a buffer, an RdbError is thrown.
+   */
+  bool publish(const std::vector<std::string>& messages, uint32_t release_mask);
+
+ private:
+  int free_buffer() const;
+
+ private:
+  key_t key_;
+  int shm_id_{-1};
+  std::unique_ptr<boost::interprocess::mapped_region> region_;
+  RDB_SHM_HDR_t* rdb_shm_hdr_{nullptr};
+  std::vector<RDB_SHM_BUFFER_INFO_t*> buffer_info_;
+};
+
+}  // namespace vtd
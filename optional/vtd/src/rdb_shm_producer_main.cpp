@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file rdb_shm_producer_main.cpp
+ * \see  rdb_shm_producer.hpp
+ *
+ * This file implements the vtd-rdb-shm-producer tool, which writes empty
+ * RDB frames into shared memory at a fixed rate, in the same way as VTD.
+ * This lets RdbTransceiverShm be exercised without a VTD installation:
+ *
+ *     vtd-rdb-shm-producer 0x0811a 1000 20
+ */
+
+#include <chrono>    // for milliseconds
+#include <cstdlib>   // for strtoul
+#include <iostream>  // for cout, cerr
+#include <string>    // for string
+#include <thread>    // for this_thread
+#include <vector>    // for vector<>
+
+#include "rdb_shm_producer.hpp"  // for RdbShmProducer, make_rdb_message
+
+namespace {
+
+void usage(const char* prog) {
+  std::cerr << "Usage: " << prog << " KEY [FRAMES=1000] [PERIOD_MS=20] [RELEASE_MASK]\n"
+            << "\n"
+            << "Create an RDB shared memory segment with KEY and publish FRAMES frames,\n"
+            << "one every PERIOD_MS milliseconds, to readers using RELEASE_MASK.\n"
+            << "RELEASE_MASK defaults to RDB_SHM_BUFFER_FLAG_TC (" << RDB_SHM_BUFFER_FLAG_TC
+            << ").\n";
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 5) {
+    usage(argv[0]);
+    return 2;
+  }
+  auto key = static_cast<key_t>(std::strtoul(argv[1], nullptr, 0));
+  auto frames = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : 1000;
+  auto period = std::chrono::milliseconds(argc > 3 ? std::strtoul(argv[3], nullptr, 0) : 20);
+  auto release_mask =
+      static_cast<uint32_t>(argc > 4 ? std::strtoul(argv[4], nullptr, 0) : RDB_SHM_BUFFER_FLAG_TC);
+
+  try {
+    vtd::RdbShmProducer producer(key);
+    std::cout << "Publishing " << frames << " frames to shm://" << std::hex << std::showbase
+              << key << std::dec << std::endl;
+
+    auto next = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+      double sim_time = std::chrono::duration<double>(period).count() * frame;
+      std::vector<std::string> msgs{
+          vtd::make_rdb_message(frame, sim_time,
+                                {
+                                    {RDB_PKG_ID_START_OF_FRAME, 0, {}},
+                                    {RDB_PKG_ID_END_OF_FRAME, 0, {}},
+                                }),
+      };
+
+      // Like VTD, wait until the reader has released a buffer.
+      while (!producer.publish(msgs, release_mask)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+
+      next += period;
+      std::this_thread::sleep_until(next);
+    }
+  } catch (std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -54,7 +54,6 @@ class RdbError : public cloe::Error {
  * RdbTransceiver is an interface for a RDB connection to VTD.
  *
  * There are currently two implementations of this: RDB over TCP and over shared memory.
- * Currently, the shared memory implementation is not being used.
  */
 class RdbTransceiver {
  public:
@@ -23,9 +23,9 @@
 #include "rdb_transceiver_shm.hpp"
 
 #include <sys/shm.h>  // for shmget
-#include <cstdlib>    // for memcopy, malloc
-#include <memory>     // for shared_ptr<>
-#include <stdexcept>  // for runtime_error
+#include <memory>     // for shared_ptr<>, make_shared
+#include <thread>     // for this_thread
+#include <utility>    // for move
 #include <vector>     // for vector<>
 
 #include <boost/interprocess/xsi_shared_memory.hpp>  // for xsi_shared_memory, ...
@@ -41,121 +41,160 @@
 
 namespace vtd {
 
+namespace {
+
+/**
+ * BufferLease locks an RDB shared memory buffer for as long as it exists.
+ *
+ * Received messages share ownership of the lease, so that the buffer is
+ * released to VTD once the last message has been processed.
+ */
+class BufferLease {
+ public:
+  BufferLease(std::shared_ptr<boost::interprocess::mapped_region> region,
+              RDB_SHM_BUFFER_INFO_t* info, uint32_t release_mask)
+      : region_(std::move(region)), info_(info), release_mask_(release_mask) {
+    rdb_shm_set_flags(info_, RDB_SHM_BUFFER_FLAG_LOCK);
+  }
+  BufferLease(const BufferLease&) = delete;
+  BufferLease& operator=(const BufferLease&) = delete;
+  ~BufferLease() { rdb_shm_clear_flags(info_, release_mask_ | RDB_SHM_BUFFER_FLAG_LOCK); }
+
+ private:
+  std::shared_ptr<boost::interprocess::mapped_region> region_;
+  RDB_SHM_BUFFER_INFO_t* info_;
+  uint32_t release_mask_;
+};
+
+}  // anonymous namespace
+
 RdbTransceiverShm::RdbTransceiverShm(key_t key, uint32_t release_mask)
-    : RdbTransceiver(), release_mask_(release_mask) {
-  int shm_id = shmget(key, 0, 0);
+    : RdbTransceiver(), key_(key), release_mask_(release_mask) {
+  if (release_mask_ == 0) {
+    throw RdbError("RdbTransceiverShm: release mask must not be zero");
+  }
 
+  int shm_id = shmget(key, 0, 0);
   if (-1 == shm_id) {
-    throw std::runtime_error("RdbTransceiverShm: failed to get shared memory ID");
+    throw RdbError("RdbTransceiverShm: failed to get shared memory ID for key {:#x}", key);
   }
 
-  // Initialize shared
+  // Map the complete segment; the segment itself can be removed by VTD while
+  // we are still attached without invalidating the mapping.
   boost::interprocess::xsi_shared_memory shm(boost::interprocess::open_only, shm_id);
-  region_ = boost::interprocess::mapped_region(shm, boost::interprocess::read_write);
-  rdb_shm_hdr_ = reinterpret_cast<RDB_SHM_HDR_t *>(region_.get_address());
-  if (2 != rdb_shm_hdr_->noBuffers) {
-    throw std::runtime_error("RdbTransceiverShm: double buffering required");
-  }
-
-  // Store pointers to RDB_SHM_BUFFER_INFO_t and pointer to RDB_MSG_t for each
-  // SHM buffer respectively
-  buffer_info_ = new RDB_SHM_BUFFER_INFO_t *[rdb_shm_hdr_->noBuffers];
-  rdb_msg_ = new RDB_MSG_t *[rdb_shm_hdr_->noBuffers];
+  region_ = std::make_shared<boost::interprocess::mapped_region>(
+      shm, boost::interprocess::read_write);
+  auto base = reinterpret_cast<char*>(region_->get_address());
+  auto size = region_->get_size();
 
-  if (0 == rdb_shm_hdr_->dataSize) {
-    throw std::runtime_error("RdbTransceiverShm: rdb_shm_hdr->dataSize is zero");
+  if (size < sizeof(RDB_SHM_HDR_t)) {
+    throw RdbError("RdbTransceiverShm: shared memory segment too small: {} bytes", size);
   }
-
-  // Store pointers to RDB_SHM_BUFFER_INFO_t
-  buffer_info_[0] = reinterpret_cast<RDB_SHM_BUFFER_INFO_t *>(
-      reinterpret_cast<char *>(rdb_shm_hdr_) + rdb_shm_hdr_->headerSize);
-  for (int i = 1; i < rdb_shm_hdr_->noBuffers; ++i) {
-    buffer_info_[i] = reinterpret_cast<RDB_SHM_BUFFER_INFO_t *>(
-        reinterpret_cast<char *>(buffer_info_[i - 1]) + buffer_info_[i - 1]->thisSize);
+  rdb_shm_hdr_ = reinterpret_cast<RDB_SHM_HDR_t*>(base);
+  if (rdb_shm_hdr_->noBuffers == 0) {
+    throw RdbError("RdbTransceiverShm: shared memory contains no buffers");
+  }
+  if (rdb_shm_hdr_->dataSize == 0) {
+    throw RdbError("RdbTransceiverShm: shared memory data size is zero");
   }
 
-  // Store pointers to first RDB_MSG_t in each RDB_SHM_BUFFER_INFO_t
+  // Store pointers to RDB_SHM_BUFFER_INFO_t and make sure that the buffers
+  // they describe are within the segment.
+  size_t info_offset = rdb_shm_hdr_->headerSize;
   for (int i = 0; i < rdb_shm_hdr_->noBuffers; ++i) {
-    rdb_msg_[i] = reinterpret_cast<RDB_MSG_t *>(reinterpret_cast<char *>(rdb_shm_hdr_) +
-                                                buffer_info_[i]->offset);
-    buffer_info_[i]->flags = 0;
+    if (info_offset + sizeof(RDB_SHM_BUFFER_INFO_t) > size) {
+      throw RdbError("RdbTransceiverShm: buffer info {} exceeds shared memory", i);
+    }
+    auto info = reinterpret_cast<RDB_SHM_BUFFER_INFO_t*>(base + info_offset);
+    if (info->thisSize < sizeof(RDB_SHM_BUFFER_INFO_t) ||
+        static_cast<size_t>(info->offset) + info->bufferSize > size) {
+      throw RdbError("RdbTransceiverShm: buffer {} exceeds shared memory", i);
+    }
+    buffer_info_.push_back(info);
+    info_offset += info->thisSize;
   }
-}
 
-RdbTransceiverShm::~RdbTransceiverShm() {
-  delete[] buffer_info_;
-  delete[] rdb_msg_;
+  // A buffer that is released to us but still locked was left over by a
+  // previous reader with our release mask, which would otherwise block VTD.
+  // Only this lock is cleared, since the other flags belong to VTD and to
+  // other readers of the same segment.
+  for (auto info : buffer_info_) {
+    auto flags = rdb_shm_flags(info);
+    if ((flags & release_mask_) && (flags & RDB_SHM_BUFFER_FLAG_LOCK)) {
+      rdb_shm_clear_flags(info, RDB_SHM_BUFFER_FLAG_LOCK);
+    }
+  }
 }
 
-std::vector<std::shared_ptr<RDB_MSG_t>> RdbTransceiverShm::receive() {
+int RdbTransceiverShm::ready_buffer() const {
   int buffer_id = -1;
+  uint32_t frame_number = 0;
+  for (size_t i = 0; i < buffer_info_.size(); ++i) {
+    auto flags = rdb_shm_flags(buffer_info_[i]);
+    if (!(flags & release_mask_) || (flags & RDB_SHM_BUFFER_FLAG_LOCK)) {
+      continue;
+    }
+    const auto* msg = reinterpret_cast<const RDB_MSG_t*>(
+        reinterpret_cast<const char*>(rdb_shm_hdr_) + buffer_info_[i]->offset);
+    if (buffer_id == -1 || msg->hdr.frameNo < frame_number) {
+      buffer_id = static_cast<int>(i);
+      frame_number = msg->hdr.frameNo;
+    }
+  }
+  return buffer_id;
+}
 
+std::vector<std::shared_ptr<RDB_MSG_t>> RdbTransceiverShm::receive() {
   std::vector<std::shared_ptr<RDB_MSG_t>> messages;
 
-  if (0 == rdb_shm_hdr_->dataSize) {
+  int buffer_id = ready_buffer();
+  if (buffer_id == -1) {
+    // Don't starve VTD of CPU time if we are called in a loop.
+    std::this_thread::yield();
     return messages;
   }
 
-  // Store pointers to RDB_SHM_BUFFER_INFO_t
-  buffer_info_[0] = reinterpret_cast<RDB_SHM_BUFFER_INFO_t *>(
-      reinterpret_cast<char *>(rdb_shm_hdr_) + rdb_shm_hdr_->headerSize);
-  for (int i = 1; i < rdb_shm_hdr_->noBuffers; ++i) {
-    buffer_info_[i] = reinterpret_cast<RDB_SHM_BUFFER_INFO_t *>(
-        reinterpret_cast<char *>(buffer_info_[i - 1]) + buffer_info_[i - 1]->thisSize);
-  }
-
-  // Store pointers to first RDB_MSG_t in each RDB_SHM_BUFFER_INFO_t
-  for (int i = 0; i < rdb_shm_hdr_->noBuffers; ++i) {
-    rdb_msg_[i] = reinterpret_cast<RDB_MSG_t *>(reinterpret_cast<char *>(rdb_shm_hdr_) +
-                                                buffer_info_[i]->offset);
-  }
-
-  for (int i = 0; i < rdb_shm_hdr_->noBuffers; ++i) {
-    if (RDB_MAGIC_NO != rdb_msg_[i]->hdr.magicNo) {
-      rdb_logger()->error("RdbTransceiverShm: magic number does not match: {}",
-                          rdb_msg_[i]->hdr.magicNo);
-      this->num_errors_++;
-      return messages;
+  auto info = buffer_info_[buffer_id];
+  auto lease = std::make_shared<BufferLease>(region_, info, release_mask_);
+  num_buffers_received_++;
+
+  // Create views of all messages in the buffer, which ends either with the
+  // buffer itself or with the first header that has no magic number.
+  char* pos = reinterpret_cast<char*>(rdb_shm_hdr_) + info->offset;
+  char* end = pos + info->bufferSize;
+  while (static_cast<size_t>(end - pos) >= sizeof(RDB_MSG_HDR_t)) {
+    auto msg = reinterpret_cast<RDB_MSG_t*>(pos);
+    if (RDB_MAGIC_NO != msg->hdr.magicNo) {
+      break;
     }
-  }
-  bool is_ready[2] = {((buffer_info_[0]->flags & release_mask_) || !release_mask_) &&
-                          !(buffer_info_[0]->flags & RDB_SHM_BUFFER_FLAG_LOCK),
-                      ((buffer_info_[1]->flags & release_mask_) || !release_mask_) &&
-                          !(buffer_info_[1]->flags & RDB_SHM_BUFFER_FLAG_LOCK)};
-
-  if (is_ready[0] && is_ready[1]) {
-    if (rdb_msg_[0]->hdr.frameNo < rdb_msg_[1]->hdr.frameNo) {
-      buffer_id = 0;
-    } else {
-      buffer_id = 1;
+    size_t msg_size = static_cast<size_t>(msg->hdr.headerSize) + msg->hdr.dataSize;
+    if (msg->hdr.headerSize < sizeof(RDB_MSG_HDR_t) || msg_size > static_cast<size_t>(end - pos)) {
+      num_errors_++;
+      throw RdbError("RdbTransceiverShm: message of {} bytes exceeds buffer {}", msg_size,
+                     buffer_id);
     }
-  } else if (is_ready[0]) {
-    buffer_id = 0;
-  } else if (is_ready[1]) {
-    buffer_id = 1;
+    messages.emplace_back(lease, msg);
+    pos += msg_size;
   }
 
-  if (is_ready[0] || is_ready[1]) {
-    buffer_info_[buffer_id]->flags |= RDB_SHM_BUFFER_FLAG_LOCK;
-
-    // copy messages from SHM to local memory
-    while (RDB_MAGIC_NO == rdb_msg_[buffer_id]->hdr.magicNo) {
-      RDB_MSG_t *message = reinterpret_cast<RDB_MSG_t *>(
-          malloc(rdb_msg_[buffer_id]->hdr.headerSize + rdb_msg_[buffer_id]->hdr.dataSize));
-      memcpy(message, rdb_msg_[buffer_id],
-             rdb_msg_[buffer_id]->hdr.headerSize + rdb_msg_[buffer_id]->hdr.dataSize);
-      this->num_messages_++;
-      messages.push_back(std::shared_ptr<RDB_MSG_t>{message});
-      rdb_msg_[buffer_id] = reinterpret_cast<RDB_MSG_t *>(
-          reinterpret_cast<char *>(rdb_msg_[buffer_id]) + rdb_msg_[buffer_id]->hdr.headerSize +
-          rdb_msg_[buffer_id]->hdr.dataSize);
-    }
-
-    buffer_info_[buffer_id]->flags &= ~release_mask_;
-    buffer_info_[buffer_id]->flags &= ~RDB_SHM_BUFFER_FLAG_LOCK;
+  if (messages.empty()) {
+    num_errors_++;
+    throw RdbError("RdbTransceiverShm: magic number does not match in buffer {}", buffer_id);
   }
 
+  num_messages_ += messages.size();
   return messages;
 }
 
+void RdbTransceiverShm::to_json(cloe::Json& j) const {
+  j = cloe::Json{
+      {"connection_endpoint", fmt::format("shm://{:#x}", key_)},
+      {"release_mask", release_mask_},
+      {"num_buffers", buffer_info_.size()},
+      {"num_buffers_received", num_buffers_received_},
+      {"num_errors", num_errors_},
+      {"num_messages", num_messages_},
+  };
+}
+
 }  // namespace vtd
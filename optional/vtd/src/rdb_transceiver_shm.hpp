@@ -22,8 +22,10 @@
 
 #pragma once
 
-#include <memory>  // for unique_ptr<>
-#include <vector>  // for vector<>
+#include <sys/types.h>  // for key_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <memory>       // for shared_ptr<>
+#include <vector>       // for vector<>
 
 #include <boost/interprocess/mapped_region.hpp>  // for mapped_region
 
@@ -34,69 +36,107 @@
 namespace vtd {
 
 /**
- * This class implements an RDB client via shared memory.
+ * Return the flags of an RDB shared memory buffer.
  *
- * WARNING:
- * > This class is primarily a proof-of-concept. Currently, it is not
- * > used and there is no guarantee that it actually works as advertised.
- * >
- * > Even if it works, under the hood manual memory-management is used,
- * > which means that until it is audited, it may leak memory or worse
- * > (ironic, I know).
+ * The flags are shared between processes, so all accesses are atomic and
+ * order the accesses to the buffer contents.
+ */
+inline uint32_t rdb_shm_flags(const RDB_SHM_BUFFER_INFO_t* info) {
+  return __atomic_load_n(&info->flags, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Set the given bits in the flags of an RDB shared memory buffer.
+ */
+inline void rdb_shm_set_flags(RDB_SHM_BUFFER_INFO_t* info, uint32_t mask) {
+  __atomic_fetch_or(&info->flags, mask, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * Clear the given bits in the flags of an RDB shared memory buffer.
+ */
+inline void rdb_shm_clear_flags(RDB_SHM_BUFFER_INFO_t* info, uint32_t mask) {
+  __atomic_fetch_and(&info->flags, ~mask, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * RdbTransceiverShm implements an RdbTransceiver via shared memory.
+ *
+ * VTD writes RDB messages into one of several buffers (normally two) in an
+ * XSI shared memory segment and marks the buffer as ready by setting the
+ * release mask in the buffer flags. The reader locks the buffer with
+ * RDB_SHM_BUFFER_FLAG_LOCK, processes the messages, and then clears both
+ * the release mask and the lock, after which VTD may reuse the buffer.
+ *
+ * The messages returned by receive() are views into the shared memory
+ * segment, so no message is copied. The buffer they are contained in is
+ * released as soon as the last of these pointers is destroyed, which is
+ * normally at the end of each iteration in RdbCodec::step. While a buffer
+ * is held, VTD writes into the other buffer; holding on to the messages
+ * for longer blocks VTD once all buffers are in use.
+ *
+ * \see  rdb_shm_producer.hpp
  */
 class RdbTransceiverShm : public RdbTransceiver {
  public:
   /**
-   * Connect to VTD memory to create a new RDB communication.
+   * Attach to the VTD shared memory segment with the given key.
    *
-   * If a "connection" cannot be achieved, C-strings are thrown.
+   * If the segment does not exist or has an invalid layout, an RdbError is
+   * thrown.
    *
    * \param key to obtain shared memory id
-   * \param release_mask mask used by VTD to mask a shared memory region as accessible
+   * \param release_mask mask used by VTD to mark a buffer as ready for us,
+   *        such as RDB_SHM_BUFFER_FLAG_TC; must not be zero
    */
   RdbTransceiverShm(key_t key, uint32_t release_mask);
 
-  virtual ~RdbTransceiverShm();
+  ~RdbTransceiverShm() override = default;
 
-  bool has() const override {
-    throw std::runtime_error("RdbTransceiverShm: has not implemented yet");
-  }
+  bool has() const override { return ready_buffer() >= 0; }
 
+  /**
+   * Return views of all messages in the oldest ready buffer, or an empty
+   * vector if no buffer is ready.
+   */
   std::vector<std::shared_ptr<RDB_MSG_t>> receive() override;
 
   void send(const RDB_MSG_t*, size_t) override {
-    throw std::runtime_error("RdbTransceiverShm: send not implemented");
+    throw RdbError("RdbTransceiverShm: send not supported");
   }
 
-  void to_json(cloe::Json& j) const override {
-    j = cloe::Json{
-        {"connection_endpoint", "shm://unknown-key"},
-        {"num_errors", this->num_errors_},
-        {"num_messages", this->num_messages_},
-    };
-  }
+  key_t key() const { return key_; }
+
+  void to_json(cloe::Json& j) const override;
 
   friend void to_json(cloe::Json& j, const RdbTransceiverShm& t) { t.to_json(j); }
 
  protected:
+  /**
+   * Return the index of the ready buffer with the lowest frame number,
+   * or -1 if no buffer is ready.
+   */
+  int ready_buffer() const;
+
+ protected:
+  key_t key_;
+
   /// VTD uses this mask to notify client when data in buffer is ready.
   uint32_t release_mask_;
 
-  /// Shared memory region.
-  boost::interprocess::mapped_region region_;
+  /// Shared memory region, which is kept alive by all received messages.
+  std::shared_ptr<boost::interprocess::mapped_region> region_;
 
   /// Pointer to the shared memory management header.
   RDB_SHM_HDR_t* rdb_shm_hdr_{nullptr};
 
-  /// Array of pointers to buffer information.
-  RDB_SHM_BUFFER_INFO_t** buffer_info_{nullptr};
-
-  /// Array of pointers to rdb messages.
-  RDB_MSG_t** rdb_msg_{nullptr};
+  /// Pointers to buffer information for each buffer.
+  std::vector<RDB_SHM_BUFFER_INFO_t*> buffer_info_;
 
   // Hold on to some cheap statistics for the JSON representation.
   uint64_t num_errors_{0};
   uint64_t num_messages_{0};
+  uint64_t num_buffers_received_{0};
 };
 
 }  // namespace vtd
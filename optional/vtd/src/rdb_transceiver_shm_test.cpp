@@ -0,0 +1,120 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file rdb_transceiver_shm_test.cpp
+ * \see  rdb_transceiver_shm.hpp
+ * \see  rdb_shm_producer.hpp
+ */
+
+#include <unistd.h>  // for getpid
+
+#include <gtest/gtest.h>  // for TEST, ASSERT_EQ, ...
+
+#include "rdb_shm_producer.hpp"     // for RdbShmProducer, make_rdb_message
+#include "rdb_transceiver_shm.hpp"  // for RdbTransceiverShm
+
+namespace {
+
+key_t test_key(int n) { return static_cast<key_t>(0x0c10e000 + ((getpid() & 0xff) << 4) + n); }
+
+std::vector<std::string> make_frame(uint32_t frame) {
+  return {
+      vtd::make_rdb_message(frame, 0.02 * frame, {{RDB_PKG_ID_START_OF_FRAME, 0, {}}}),
+      vtd::make_rdb_message(frame, 0.02 * frame, {{RDB_PKG_ID_END_OF_FRAME, 0, {}}}),
+  };
+}
+
+}  // anonymous namespace
+
+TEST(vtd_rdb_transceiver_shm_test, open) {
+  ASSERT_THROW(vtd::RdbTransceiverShm(test_key(0), RDB_SHM_BUFFER_FLAG_TC), vtd::RdbError);
+}
+
+TEST(vtd_rdb_transceiver_shm_test, receive_in_place) {
+  vtd::RdbShmProducer producer(test_key(1));
+  vtd::RdbTransceiverShm rdb(test_key(1), RDB_SHM_BUFFER_FLAG_TC);
+  ASSERT_FALSE(rdb.has());
+  ASSERT_TRUE(rdb.receive().empty());
+
+  ASSERT_TRUE(producer.publish(make_frame(1), RDB_SHM_BUFFER_FLAG_TC));
+  ASSERT_TRUE(rdb.has());
+  auto msgs = rdb.receive();
+  ASSERT_EQ(msgs.size(), 2);
+  EXPECT_EQ(msgs[0]->hdr.frameNo, 1);
+  EXPECT_EQ(msgs[0]->entryHdr.pkgId, RDB_PKG_ID_START_OF_FRAME);
+  EXPECT_EQ(msgs[1]->entryHdr.pkgId, RDB_PKG_ID_END_OF_FRAME);
+  EXPECT_EQ(reinterpret_cast<char*>(msgs[1].get()),
+            reinterpret_cast<char*>(msgs[0].get()) + sizeof(RDB_MSG_HDR_t) +
+                sizeof(RDB_MSG_ENTRY_HDR_t));
+
+  // The first buffer is held by msgs, so only the second one is free.
+  ASSERT_FALSE(rdb.has());
+  ASSERT_TRUE(producer.publish(make_frame(2), RDB_SHM_BUFFER_FLAG_TC));
+  ASSERT_FALSE(producer.has_free_buffer());
+
+  // Releasing the messages releases the buffer.
+  msgs.clear();
+  ASSERT_TRUE(producer.has_free_buffer());
+  msgs = rdb.receive();
+  ASSERT_EQ(msgs.size(), 2);
+  EXPECT_EQ(msgs[0]->hdr.frameNo, 2);
+}
+
+TEST(vtd_rdb_transceiver_shm_test, receive_in_order) {
+  vtd::RdbShmProducer producer(test_key(2));
+  vtd::RdbTransceiverShm rdb(test_key(2), RDB_SHM_BUFFER_FLAG_TC);
+
+  // Messages for other readers are ignored.
+  ASSERT_TRUE(producer.publish(make_frame(1), RDB_SHM_BUFFER_FLAG_IG));
+  ASSERT_TRUE(producer.publish(make_frame(2), RDB_SHM_BUFFER_FLAG_TC));
+  ASSERT_FALSE(producer.publish(make_frame(3), RDB_SHM_BUFFER_FLAG_TC));
+  EXPECT_EQ(rdb.receive().at(0)->hdr.frameNo, 2);
+  ASSERT_TRUE(producer.publish(make_frame(3), RDB_SHM_BUFFER_FLAG_TC));
+  EXPECT_EQ(rdb.receive().at(0)->hdr.frameNo, 3);
+  ASSERT_FALSE(rdb.has());
+
+  // Buffers are received in frame order, independent of the buffer index.
+  vtd::RdbTransceiverShm ig(test_key(2), RDB_SHM_BUFFER_FLAG_IG);
+  EXPECT_EQ(ig.receive().at(0)->hdr.frameNo, 1);
+  ASSERT_TRUE(producer.publish(make_frame(5), RDB_SHM_BUFFER_FLAG_TC));
+  ASSERT_TRUE(producer.publish(make_frame(4), RDB_SHM_BUFFER_FLAG_TC));
+  EXPECT_EQ(rdb.receive().at(0)->hdr.frameNo, 4);
+  EXPECT_EQ(rdb.receive().at(0)->hdr.frameNo, 5);
+}
+
+TEST(vtd_rdb_transceiver_shm_test, clear_stale_lock) {
+  vtd::RdbShmProducer producer(test_key(3));
+  vtd::RdbTransceiverShm ig(test_key(3), RDB_SHM_BUFFER_FLAG_IG);
+  vtd::RdbTransceiverShm tc(test_key(3), RDB_SHM_BUFFER_FLAG_TC);
+  ASSERT_TRUE(producer.publish(make_frame(1), RDB_SHM_BUFFER_FLAG_IG));
+  ASSERT_TRUE(producer.publish(make_frame(2), RDB_SHM_BUFFER_FLAG_TC));
+  auto ig_msgs = ig.receive();
+  auto tc_msgs = tc.receive();
+  ASSERT_FALSE(producer.has_free_buffer());
+
+  // A new reader only clears the lock left over by a reader with the same
+  // release mask, so the buffer of the other reader stays locked.
+  vtd::RdbTransceiverShm tc2(test_key(3), RDB_SHM_BUFFER_FLAG_TC);
+  ASSERT_FALSE(producer.has_free_buffer());
+  ASSERT_FALSE(ig.has());
+  ASSERT_TRUE(tc2.has());
+  EXPECT_EQ(tc2.receive().at(0)->hdr.frameNo, 2);
+  ASSERT_FALSE(ig.has());
+  ig_msgs.clear();
+  ASSERT_TRUE(producer.has_free_buffer());
+}
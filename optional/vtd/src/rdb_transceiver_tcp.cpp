@@ -42,12 +42,12 @@ std::shared_ptr<RDB_MSG_t> RdbTransceiverTcp::receive_wait() {
   }
 
   // 1.b) Read the header
-  tcp_stream_.read(reinterpret_cast<char*>(msg_hdr), sizeof(RDB_MSG_HDR_t));
-  if (!tcp_stream_) {
+  tcp_reader_.read(reinterpret_cast<char*>(msg_hdr), sizeof(RDB_MSG_HDR_t));
+  if (!tcp_reader_) {
     free(msg_hdr);
     this->num_errors_++;
     throw cloe::utility::TcpReadError("RdbTransceiverTcp: error during read: {}",
-                                      tcp_stream_.error().message());
+                                      tcp_reader_.error().message());
   }
 
   // 2. Verify if header is in sync
@@ -61,15 +61,16 @@ std::shared_ptr<RDB_MSG_t> RdbTransceiverTcp::receive_wait() {
   // 3. Allocate full amount of memory and append data
   auto msg =
       reinterpret_cast<RDB_MSG_t*>(realloc(msg_hdr, msg_hdr->headerSize + msg_hdr->dataSize));
-  tcp_stream_.read(reinterpret_cast<char*>(&(msg->entryHdr)), msg->hdr.dataSize);
-  if (!tcp_stream_) {
+  tcp_reader_.read(reinterpret_cast<char*>(&(msg->entryHdr)), msg->hdr.dataSize);
+  if (!tcp_reader_) {
     free(msg);
     this->num_errors_++;
     throw cloe::utility::TcpReadError("RdbTransceiverTcp: error during read: {}",
-                                      tcp_stream_.error().message());
+                                      tcp_reader_.error().message());
   }
 
   // 4. Wrap the result in a shared_ptr and return it
+  this->num_received_++;
   return std::shared_ptr<RDB_MSG_t>(msg);
 }
 
@@ -23,41 +23,47 @@
 
 #pragma once
 
+#include <atomic>  // for atomic<>
 #include <memory>  // for shared_ptr<>
+#include <string>  // for string
 #include <vector>  // for vector<>
 
 #include <boost/asio.hpp>  // for streamsize
 
 #include <cloe/core.hpp>                     // for Json
+#include <cloe/utility/async_receiver.hpp>   // for AsyncReceiver
 #include <cloe/utility/tcp_transceiver.hpp>  // for TcpTransceiver
 
 #include "rdb_transceiver.hpp"  // for RdbTransceiver
 #include "vtd_logger.hpp"       // for rdb_logger
 
-#define VTD_RDB_WAIT_SLEEP_MS 1
-
 namespace vtd {
 
 /**
  * RdbTransceiverTcp implements an RdbTransceiver via TCP.
+ *
+ * Messages are read and framed by a background reader thread and stored in
+ * a lock-free queue, so that receiving messages in the simulation thread only
+ * needs to drain already decoded messages. The reader thread has its own
+ * stream on the connection, so sending from the simulation thread does not
+ * race with it.
  */
 class RdbTransceiverTcp : public RdbTransceiver, public cloe::utility::TcpTransceiver {
  public:
-  using TcpTransceiver::TcpTransceiver;
-
-  bool has() const override {
-    return this->tcp_available_data() >= static_cast<std::streamsize>(sizeof(RDB_MSG_HDR_t));
+  RdbTransceiverTcp(const std::string& host, uint16_t port) : TcpTransceiver(host, port) {
+    this->tcp_open_reader();
+    receiver_.start([this]() { return this->receive_wait(); },
+                    [this]() { this->tcp_shutdown(); });
   }
 
+  ~RdbTransceiverTcp() override { receiver_.stop(); }
+
+  bool has() const override { return receiver_.has(); }
+
   std::vector<std::shared_ptr<RDB_MSG_t>> receive() override {
     std::vector<std::shared_ptr<RDB_MSG_t>> msgs;
-    while (!this->has()) {
-      std::this_thread::sleep_for(cloe::Milliseconds{VTD_RDB_WAIT_SLEEP_MS});
-    }
-    while (this->has()) {
-      num_received_++;
-      msgs.push_back(this->receive_wait());
-    }
+    receiver_.wait();
+    receiver_.drain(msgs);
     return msgs;
   }
 
@@ -70,9 +76,10 @@ class RdbTransceiverTcp : public RdbTransceiver, public cloe::utility::TcpTransc
     j = cloe::Json{
         {"connection_endpoint", this->tcp_endpoint()},
         {"connection_ok", this->tcp_is_ok()},
-        {"num_errors", this->num_errors_},
+        {"num_errors", this->num_errors_.load()},
         {"num_messages_sent", this->num_sent_},
-        {"num_messages_received", this->num_received_},
+        {"num_messages_received", this->num_received_.load()},
+        {"receiver", this->receiver_},
     };
   }
 
@@ -81,14 +88,18 @@ class RdbTransceiverTcp : public RdbTransceiver, public cloe::utility::TcpTransc
  protected:
   /**
    * Synchronous (blocking) method to receive an RDB message.
+   *
+   * This is called from the reader thread.
    */
   std::shared_ptr<RDB_MSG_t> receive_wait();
 
  private:
-  // Statistics for interest's sake
-  uint64_t num_errors_{0};
+  // Statistics for interest's sake, partly updated by the reader thread
+  std::atomic<uint64_t> num_errors_{0};
   uint64_t num_sent_{0};
-  uint64_t num_received_{0};
+  std::atomic<uint64_t> num_received_{0};
+
+  cloe::utility::AsyncReceiver<std::shared_ptr<RDB_MSG_t>> receiver_;
 };
 
 class RdbTransceiverTcpFactory : public cloe::utility::TcpTransceiverFactory<RdbTransceiverTcp> {
@@ -21,15 +21,23 @@
 
 #pragma once
 
-#include <chrono>  // for duration<>
-#include <map>     // for map<>
-#include <memory>  // for shared_ptr<>
-#include <string>  // for string
+#include <chrono>   // for duration<>
+#include <cstdint>  // for uint32_t
+#include <map>      // for map<>
+#include <memory>   // for shared_ptr<>
+#include <string>   // for string
 
 #include <cloe/core.hpp>                            // for Conf, Schema
 #include <cloe/utility/osi_message_handler.hpp>     // for SensorMockLevel
 #include <cloe/utility/tcp_transceiver_config.hpp>  // for TcpTransceiverConfiguration, ...
 
+#include "vtd_version.hpp"
+#if (VTD_API_VERSION_EPOCH == 0)
+  #include <viRDBIcd.h>  // for RDB_SHM_BUFFER_FLAG_TC
+#else
+  #include <VtdToolkit/viRDBIcd.h>
+#endif
+
 // Connection / Initialization
 #define VTD_DEFAULT_SCP_PORT 48179
 #define VTD_PARAMSERVER_PORT 54345
@@ -58,11 +66,12 @@ ENUM_SERIALIZATION(LabelConfiguration, ({
  * The ProtocolConfiguration class lets you configure how we receive
  * sensor data.
  */
-enum class ProtocolConfiguration { Rdb, Osi };
+enum class ProtocolConfiguration { Rdb, RdbShm, Osi };
 
 // clang-format off
 ENUM_SERIALIZATION(ProtocolConfiguration, ({
   {ProtocolConfiguration::Rdb, "rdb"},
+  {ProtocolConfiguration::RdbShm, "rdb_shm"},
   {ProtocolConfiguration::Osi, "osi"},
 }))
 // clang-format on
@@ -88,12 +97,26 @@ struct VtdSensorConfig : public cloe::Confable {
    * - [[ sensor_id ]] Sensor id to create a unique sensor name in <Sensor>
    * - [[ sensor_name ]] Sensor name to create a speaking sensor name in <Sensor>
    * - [[ sensor_port ]] TCP port for the sensor's RDB channel in <Port>
+   * - [[ shm_key ]] Shared memory key for the sensor's RDB channel in <Port>
+   * - [[ shm_release_mask ]] Release mask for the sensor's RDB channel in <Port>
    * - [[ player_id ]] Player id for <Player>
    */
   std::string xml = "";
 
   ProtocolConfiguration protocol = ProtocolConfiguration::Rdb;
 
+  /**
+   * Key of the shared memory segment that VTD writes RDB messages to.
+   * Only used with the rdb_shm protocol, and then required.
+   */
+  uint32_t shm_key = 0;
+
+  /**
+   * Mask with which VTD marks a shared memory buffer as ready for us.
+   * Only used with the rdb_shm protocol.
+   */
+  uint32_t shm_release_mask = RDB_SHM_BUFFER_FLAG_TC;
+
   /**
    * Overwrite data by ground truth.
    * Currently supported for OSI protocol only.
@@ -106,7 +129,9 @@ struct VtdSensorConfig : public cloe::Confable {
     // clang-format off
     return cloe::Schema{
         {"xml",         cloe::Schema(&xml, "VTD module manager sensor configuration")},
-        {"protocol",    cloe::Schema(&protocol, "VTD module manager sensor connection protocol ( rdb | osi )")},
+        {"protocol",    cloe::Schema(&protocol, "VTD module manager sensor connection protocol ( rdb | rdb_shm | osi )")},
+        {"shm_key",     cloe::Schema(&shm_key, "shared memory key of RDB channel for rdb_shm protocol")},
+        {"shm_release_mask", cloe::Schema(&shm_release_mask, "mask VTD uses to release shared memory buffers to us")},
         {"mock_level",  cloe::Schema(sensor_mock_conf.get(), "Sensor data mock level")},
     };
     // clang-format on
@@ -39,6 +39,7 @@
 #include "actuator_component.hpp"     // for VtdLatLongActuator
 #include "omni_sensor_component.hpp"  // for VtdOmniSensor
 #include "osi_sensor_component.hpp"   // for VtdOsiSensor
+#include "rdb_transceiver_shm.hpp"    // for RdbTransceiverShm
 #include "rdb_transceiver_tcp.hpp"    // for RdbTransceiverTcp, RdbTransceiverTcpFactory
 #include "scp_messages.hpp"           // for scp::{LabelVehicle, SensorConfiguration}
 #include "scp_transceiver.hpp"        // for ScpTransceiver
@@ -339,7 +340,13 @@ class VtdVehicleFactory {
         auto cfg = sens.second;
         auto port = sensor_port_++;
         cloe::Json j{
-            {"sensor_id", port}, {"sensor_name", name}, {"sensor_port", port}, {"player_id", id}};
+            {"sensor_id", port},
+            {"sensor_name", name},
+            {"sensor_port", port},
+            {"shm_key", cfg.shm_key},
+            {"shm_release_mask", cfg.shm_release_mask},
+            {"player_id", id},
+        };
         send_sensor_configuration(tx, cfg.xml, j);
         std::this_thread::sleep_for(cloe::Milliseconds(100));
         switch (cfg.protocol) {
@@ -350,6 +357,20 @@ class VtdVehicleFactory {
             veh->sensors_[name] = omni;
             break;
           }
+          case ProtocolConfiguration::RdbShm: {
+            if (cfg.shm_key == 0) {
+              throw cloe::Error("VtdVehicle: sensor {} requires shm_key for rdb_shm protocol",
+                                name);
+            }
+            sensors_logger()->debug("Attaching to RDB shared memory {:#x} for sensor {}",
+                                    cfg.shm_key, name);
+            std::shared_ptr<VtdOmniSensor> omni(new VtdOmniSensor(
+                std::make_unique<RdbTransceiverShm>(static_cast<key_t>(cfg.shm_key),
+                                                    cfg.shm_release_mask),
+                id));
+            veh->sensors_[name] = omni;
+            break;
+          }
           case ProtocolConfiguration::Osi: {
             sensors_logger()->debug("Opening TCP channel {} for OSI sensor {}", port, name);
             std::shared_ptr<VtdOsiSensor> osi(
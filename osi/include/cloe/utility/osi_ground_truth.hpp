@@ -22,7 +22,9 @@
 
 #pragma once
 
-#include <map>  // for std::map<>
+#include <cstddef>        // for size_t
+#include <unordered_map>  // for unordered_map<>
+#include <vector>         // for vector<>
 
 #include <Eigen/Geometry>  // for Vector3d
 
@@ -37,6 +39,10 @@ namespace cloe::utility {
 /**
  * OsiGroundTruth provides convenient access to auxiliary ground truth
  * information while converting an OSI message to Cloe data.
+ *
+ * When a ground truth message is set, an index from object id to moving
+ * object is built once, so that all per-object accessors run in constant
+ * time, independent of the number of traffic participants.
  */
 class OsiGroundTruth {
  public:
@@ -49,7 +55,7 @@ class OsiGroundTruth {
 
   /**
    * Store address of the GroundTruth object belonging to the OSI message
-   * that is to be processed.
+   * that is to be processed, and index its moving objects.
    */
   void set(const osi3::GroundTruth& osi_gt);
 
@@ -62,36 +68,54 @@ class OsiGroundTruth {
 
   void store_veh_coord_sys_info(int obj_id, const osi3::MovingObject::VehicleAttributes& osi_va) {
     // Assume that VehicleAttributes contains valid data.
-    veh_bbcenter_to_rear_[obj_id] = osi_vehicle_attrib_rear_offset_to_vector3d(osi_va);
+    auto& info = this->info(obj_id);
+    info.bbcenter_to_rear = osi_vehicle_attrib_rear_offset_to_vector3d(osi_va);
+    info.has_bbcenter_to_rear = true;
   }
 
   /**
    * Get the offset between coordinate reference frames of a vehicle (rear axle
    * center) and the bounding box center, e.g. for coordinate transformations.
+   *
+   * Throws std::out_of_range if the object has no vehicle attributes.
    */
   [[nodiscard]] const Eigen::Vector3d& get_veh_coord_sys_info(int obj_id) const {
-    return veh_bbcenter_to_rear_.at(obj_id);
+    const auto& info = this->info(obj_id);
+    if (!info.has_bbcenter_to_rear) {
+      throw std::out_of_range("OsiGroundTruth: object has no vehicle attributes");
+    }
+    return info.bbcenter_to_rear;
   }
 
   void store_mov_obj_dimensions(int obj_id, const osi3::Dimension3d& obj_dim) {
     // Assume that Dimension3d contains valid data.
-    mov_obj_dimensions_[obj_id] = osi_dimension3d_lwh_to_vector3d(obj_dim);
+    auto& info = this->info(obj_id);
+    info.dimensions = osi_dimension3d_lwh_to_vector3d(obj_dim);
+    info.has_dimensions = true;
   }
 
   /**
    * Get dimensions of a moving object, e.g. for coordinate transformations.
+   *
+   * Throws std::out_of_range if the object has no dimensions.
    */
   [[nodiscard]] const Eigen::Vector3d& get_mov_obj_dimensions(int obj_id) const {
-    return mov_obj_dimensions_.at(obj_id);
+    const auto& info = this->info(obj_id);
+    if (!info.has_dimensions) {
+      throw std::out_of_range("OsiGroundTruth: object has no dimensions");
+    }
+    return info.dimensions;
   }
 
   /**
    * Discard all data, e.g after processing an OSI message.
+   *
+   * Allocated memory is retained for the next message.
    */
   void reset() {
     gt_ptr_ = nullptr;
-    veh_bbcenter_to_rear_.erase(veh_bbcenter_to_rear_.begin(), veh_bbcenter_to_rear_.end());
-    mov_obj_dimensions_.erase(mov_obj_dimensions_.begin(), mov_obj_dimensions_.end());
+    mov_obj_index_.clear();
+    mov_obj_info_.clear();
   }
 
   /**
@@ -104,21 +128,66 @@ class OsiGroundTruth {
 
   /**
    * Get ground truth information for the requested moving object.
+   *
+   * Throws ModelError if the object does not exist.
    */
   [[nodiscard]] const osi3::MovingObject* get_moving_object(uint64_t id) const;
 
+  /**
+   * Get ground truth information for the requested moving object or nullptr
+   * if it does not exist.
+   */
+  [[nodiscard]] const osi3::MovingObject* find_moving_object(uint64_t id) const {
+    auto it = mov_obj_index_.find(id);
+    if (it == mov_obj_index_.end()) {
+      return nullptr;
+    }
+    return mov_obj_info_[it->second].osi_mo;
+  }
+
+  /**
+   * Return the number of indexed moving objects.
+   */
+  [[nodiscard]] size_t num_moving_objects() const { return mov_obj_info_.size(); }
+
  private:
   void error() const { throw cloe::ModelError("OsiGroundTruth not set"); }
 
+  /// Auxiliary information stored for each moving object.
+  struct MovingObjectInfo {
+    const osi3::MovingObject* osi_mo{nullptr};
+    bool has_bbcenter_to_rear{false};
+    bool has_dimensions{false};
+    Eigen::Vector3d bbcenter_to_rear;
+    Eigen::Vector3d dimensions;
+  };
+
+  [[nodiscard]] const MovingObjectInfo& info(int obj_id) const {
+    auto it = mov_obj_index_.find(static_cast<uint64_t>(obj_id));
+    if (it == mov_obj_index_.end()) {
+      throw std::out_of_range("OsiGroundTruth: unknown object id");
+    }
+    return mov_obj_info_[it->second];
+  }
+
+  MovingObjectInfo& info(int obj_id) {
+    auto [it, inserted] =
+        mov_obj_index_.try_emplace(static_cast<uint64_t>(obj_id), mov_obj_info_.size());
+    if (inserted) {
+      mov_obj_info_.emplace_back();
+    }
+    return mov_obj_info_[it->second];
+  }
+
  protected:
   /// Pointer to ground truth object of the processed OSI message.
   const osi3::GroundTruth* gt_ptr_{nullptr};
 
-  /// Store object coordinate system info for each object <obj_id,offset>.
-  std::map<int, Eigen::Vector3d> veh_bbcenter_to_rear_;
+  /// Index into mov_obj_info_ for each moving object <obj_id,index>.
+  std::unordered_map<uint64_t, size_t> mov_obj_index_;
 
-  /// Store moving object dimensions for each object <obj_id,dimensions>.
-  std::map<int, Eigen::Vector3d> mov_obj_dimensions_;
+  /// Moving object pointer, coordinate system info, and dimensions.
+  std::vector<MovingObjectInfo> mov_obj_info_;
 };
 
 }  // namespace cloe::utility
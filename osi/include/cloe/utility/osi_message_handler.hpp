@@ -23,6 +23,7 @@
 #pragma once
 
 #include <memory>  // for shared_ptr<>, unique_ptr<>
+#include <vector>  // for vector<>
 
 #include <Eigen/Geometry>  // for Isometry3d, Vector3d
 
@@ -208,7 +209,7 @@ class OsiMsgHandler {
    * \param osi_sd SensorData message to be processed.
    * \param osi_time Timestamp of the OSI message.
    */
-  virtual void process_received_msg(osi3::SensorData* osi_sd, Duration& osi_time);
+  virtual void process_received_msg(const osi3::SensorData* osi_sd, Duration& osi_time);
 
   /**
    * Translate OSI SensorView to Cloe data objects.
@@ -216,7 +217,7 @@ class OsiMsgHandler {
    * \param osi_sv SensorView message to be processed.
    * \param osi_time Timestamp of the OSI message.
    */
-  virtual void process_received_msg(osi3::SensorView* osi_sv, Duration& osi_time);
+  virtual void process_received_msg(const osi3::SensorView* osi_sv, Duration& osi_time);
 
   /**
    * Translate OSI GroundTruth to Cloe data objects.
@@ -224,7 +225,7 @@ class OsiMsgHandler {
    * \param osi_gt GroundTruth message to be processed.
    * \param osi_time Timestamp of the OSI message.
    */
-  virtual void process_received_msg(osi3::GroundTruth* osi_gt, Duration& osi_time);
+  virtual void process_received_msg(const osi3::GroundTruth* osi_gt, Duration& osi_time);
 
   /**
    * Translate OSI GroundTruth to Cloe data objects.
@@ -263,6 +264,13 @@ class OsiMsgHandler {
 
   void detected_static_objects_from_ground_truth();
 
+  /**
+   * Convert lane boundaries from ground truth to the sensor frame.
+   *
+   * Lane boundaries are part of the static ground truth, so their conversion
+   * is cached in the inertial frame and only redone when the transceiver
+   * reports a new static ground truth revision.
+   */
   void detected_lane_boundaries_from_ground_truth();
 
   void from_osi_boundary_points(const osi3::LaneBoundary& osi_lb, LaneBoundary& lb,
@@ -343,6 +351,12 @@ class OsiMsgHandler {
   /// Initial simulation time.
   Duration init_time_ = Duration(-1);
 
+  /// Lane boundaries from static ground truth with points in the inertial frame.
+  std::vector<LaneBoundary> static_lane_boundaries_;
+
+  /// Static ground truth revision of static_lane_boundaries_, 0 if unknown.
+  uint64_t static_lane_boundaries_revision_{0};
+
   /// Use alternative source for required data or overwrite incoming data, if requested.
   std::shared_ptr<const SensorMockConf> mock_{nullptr};
 };
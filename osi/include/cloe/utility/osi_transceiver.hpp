@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <memory>  // for shared_ptr<>
+#include <vector>  // for vector<>
+
 #include <osi3/osi_groundtruth.pb.h>  // for GroundTruth
 #include <osi3/osi_sensordata.pb.h>   // for SensorData
 
@@ -82,6 +85,17 @@ class OsiTransceiver {
    */
   virtual void clear_cache() {}
 
+  /**
+   * Return a revision number of the static ground truth content, such as
+   * lanes and lane boundaries, that changes whenever this content changes.
+   *
+   * This allows receivers of GroundTruth messages to cache conversions of
+   * static content between messages. The value 0 means that the revision is
+   * unknown, in which case static content must be converted for every
+   * message.
+   */
+  [[nodiscard]] virtual uint64_t static_ground_truth_revision() const { return 0; }
+
   /**
    * Non-blocking function to return all received osi::SensorData messages.
    */
@@ -97,9 +111,36 @@ class OsiTransceiver {
    */
   virtual void receive_osi_msgs(std::vector<std::shared_ptr<osi3::GroundTruth>>& msgs) = 0;
 
+  /**
+   * Non-blocking functions to return all received messages for reading only.
+   *
+   * This allows transceivers to return messages that they do not own, such as
+   * those of a simulator library, without copying them. OsiMsgHandler uses
+   * these. By default, they return the messages from the functions above.
+   */
+  virtual void receive_osi_msgs(std::vector<std::shared_ptr<const osi3::SensorData>>& msgs) {
+    receive_as_const<osi3::SensorData>(msgs);
+  }
+
+  virtual void receive_osi_msgs(std::vector<std::shared_ptr<const osi3::SensorView>>& msgs) {
+    receive_as_const<osi3::SensorView>(msgs);
+  }
+
+  virtual void receive_osi_msgs(std::vector<std::shared_ptr<const osi3::GroundTruth>>& msgs) {
+    receive_as_const<osi3::GroundTruth>(msgs);
+  }
+
   virtual void to_json(fable::Json& j) const = 0;
 
   friend void to_json(fable::Json& j, const OsiTransceiver& t) { t.to_json(j); }
+
+ private:
+  template <typename T>
+  void receive_as_const(std::vector<std::shared_ptr<const T>>& msgs) {
+    std::vector<std::shared_ptr<T>> tmp;
+    receive_osi_msgs(tmp);
+    msgs.insert(msgs.end(), tmp.begin(), tmp.end());
+  }
 };
 
 }  // namespace cloe::utility
@@ -22,15 +22,21 @@
 
 #pragma once
 
+#include <atomic>  // for atomic<>
 #include <memory>  // for shared_ptr<>
+#include <string>  // for string
 #include <vector>  // for vector<>
 
-#include <boost/asio.hpp>  // for streamsize
+#include <boost/asio.hpp>  // for iostream
+
+#include <google/protobuf/message.h>  // for Message, Descriptor
 
 #include <osi3/osi_groundtruth.pb.h>  // for GroundTruth
 #include <osi3/osi_sensordata.pb.h>   // for SensorData
+#include <osi3/osi_sensorview.pb.h>   // for SensorView
 
 #include <cloe/core/logger.hpp>              // for Logger
+#include <cloe/utility/async_receiver.hpp>   // for AsyncReceiver
 #include <cloe/utility/osi_transceiver.hpp>  // for OsiTransceiver
 #include <cloe/utility/osi_utils.hpp>        // for osi_logger
 #include <cloe/utility/tcp_transceiver.hpp>  // for TcpTransceiver
@@ -38,67 +44,163 @@
 
 namespace cloe::utility {
 
+/**
+ * Return the message serialized as a length-prefixed frame, as it is sent
+ * and received by OsiTransceiverTcp.
+ *
+ * The frame consists of the size of the serialized message as 32-bit little
+ * endian unsigned integer, followed by the serialized message.
+ */
+[[nodiscard]] std::string osi_tcp_frame(const google::protobuf::MessageLite& msg);
+
 /**
  * OsiTransceiverTcp implements an OsiTransceiver via TCP.
+ *
+ * Each connection carries length-prefixed frames of one OSI top-level message
+ * type, which is one of osi3::SensorData, osi3::SensorView, or
+ * osi3::GroundTruth.
+ *
+ * Messages are read, framed, and parsed by a background reader thread and
+ * stored in a lock-free queue, so that receiving messages in the simulation
+ * thread only needs to drain already decoded messages.
+ * The reader thread is started for the message type of the first call to
+ * receive_osi_msgs(), or explicitly with start_receiving().
+ * Until then, incoming data is buffered by the operating system.
+ * The reader thread has its own stream on the connection, so sending from
+ * the simulation thread does not race with it.
  */
 class OsiTransceiverTcp : public OsiTransceiver, public TcpTransceiver {
  public:
-  using TcpTransceiver::TcpTransceiver;
+  /**
+   * Maximum size of a single message frame.
+   *
+   * Anything larger than this is treated as a corrupted stream.
+   */
+  static constexpr uint32_t max_frame_size = 256 * 1024 * 1024;
 
-  bool has_sensor_data() const override {
-    return this->tcp_available_data() >= static_cast<std::streamsize>(sizeof(osi3::SensorData));
+  OsiTransceiverTcp(const std::string& host, uint16_t port) : TcpTransceiver(host, port) {
+    this->tcp_open_reader();
   }
 
-  bool has_sensor_view() const override {
-    return this->tcp_available_data() >= static_cast<std::streamsize>(sizeof(osi3::SensorView));
+  ~OsiTransceiverTcp() override { receiver_.stop(); }
+
+  /**
+   * Return true when a decoded message of the type is ready to be received.
+   *
+   * Messages are only decoded once the reader thread has been started, so
+   * these return false before the first call to receive_osi_msgs() or
+   * start_receiving(), even if the peer has already sent messages. Call
+   * start_receiving() first to poll for messages without receiving them.
+   */
+  bool has_sensor_data() const override { return has_msgs<osi3::SensorData>(); }
+
+  bool has_sensor_view() const override { return has_msgs<osi3::SensorView>(); }
+
+  bool has_ground_truth() const override { return has_msgs<osi3::GroundTruth>(); }
+
+  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::SensorData>>& msgs) override {
+    this->receive_msgs(msgs);
   }
 
-  bool has_ground_truth() const override {
-    return this->tcp_available_data() >= static_cast<std::streamsize>(sizeof(osi3::GroundTruth));
+  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::SensorView>>& msgs) override {
+    this->receive_msgs(msgs);
   }
 
-  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::SensorData>>& msgs) override {
-    if (!msgs.empty()) {
-      osi_logger()->warn(
-          "OsiTransceiverTcp: Non-zero length of message vector before retrieval: {}", msgs.size());
-    }
-    while (this->has_sensor_data()) {
-      num_received_++;
-      msgs.push_back(this->receive_sensor_data_wait());
-    }
+  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::GroundTruth>>& msgs) override {
+    this->receive_msgs(msgs);
   }
 
-  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::SensorView>>& /*msgs*/) override {
-    throw OsiError("OsiTransceiverTcp: Retrieval of osi3::SensorView not yet implemented.");
+  /**
+   * Start the reader thread for messages of type T.
+   *
+   * This does nothing if the reader thread has already been started for T,
+   * and throws an OsiError if it has been started for another type.
+   */
+  template <typename T>
+  void start_receiving() {
+    if (msg_type_ == nullptr) {
+      msg_type_ = T::descriptor();
+      receiver_.start(
+          [this]() -> std::shared_ptr<google::protobuf::Message> {
+            return this->receive_msg_wait<T>();
+          },
+          [this]() { this->tcp_shutdown(); });
+    } else if (msg_type_ != T::descriptor()) {
+      throw OsiError("OsiTransceiverTcp: cannot receive osi3::{}, connection carries osi3::{}",
+                     T::descriptor()->name(), msg_type_->name());
+    }
   }
 
-  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::GroundTruth>>& /*msgs*/) override {
-    throw OsiError("OsiTransceiverTcp: Retrieval of osi3::GroundTruth not yet implemented.");
+  /**
+   * Send the message as length-prefixed frame.
+   */
+  void send_osi_msg(const google::protobuf::MessageLite& msg) {
+    auto frame = osi_tcp_frame(msg);
+    this->tcp_send(frame.data(), frame.size());
+    num_sent_++;
   }
 
   void to_json(fable::Json& j) const override {
     j = fable::Json{
         {"connection_endpoint", this->tcp_endpoint()},
         {"connection_ok", this->tcp_is_ok()},
-        {"num_errors", this->num_errors_},
+        {"message_type", msg_type_ ? msg_type_->name() : ""},
+        {"num_errors", this->num_errors_.load()},
         {"num_messages_sent", this->num_sent_},
-        {"num_messages_received", this->num_received_},
+        {"num_messages_received", this->num_received_.load()},
+        {"receiver", this->receiver_},
     };
   }
 
   friend void to_json(fable::Json& j, const OsiTransceiverTcp& t) { t.to_json(j); }
 
  protected:
+  template <typename T>
+  bool has_msgs() const {
+    return msg_type_ == T::descriptor() && receiver_.has();
+  }
+
+  template <typename T>
+  void receive_msgs(std::vector<std::shared_ptr<T>>& msgs) {
+    if (!msgs.empty()) {
+      osi_logger()->warn(
+          "OsiTransceiverTcp: Non-zero length of message vector before retrieval: {}", msgs.size());
+    }
+    this->start_receiving<T>();
+    receiver_.drain_with([&msgs](std::shared_ptr<google::protobuf::Message>&& m) {
+      msgs.emplace_back(std::static_pointer_cast<T>(std::move(m)));
+    });
+  }
+
+  /**
+   * Synchronous (blocking) method to receive a message of type T.
+   *
+   * This is called from the reader thread, and is only instantiated for
+   * osi3::SensorData, osi3::SensorView, and osi3::GroundTruth.
+   */
+  template <typename T>
+  std::shared_ptr<T> receive_msg_wait();
+
   /**
-   * Synchronous (blocking) method to receive a SensorData message.
+   * Synchronous (blocking) method to read the next frame into frame_buf_.
+   *
+   * Return the size of the frame.
    */
-  std::shared_ptr<osi3::SensorData> receive_sensor_data_wait();
+  uint32_t receive_frame_wait();
 
  private:
-  // Statistics for interest's sake
-  uint64_t num_errors_{0};
+  // Only accessed by the reader thread:
+  std::vector<char> frame_buf_;
+
+  // Set once before the reader thread is started:
+  const google::protobuf::Descriptor* msg_type_{nullptr};
+
+  // Statistics for interest's sake, partly updated by the reader thread
+  std::atomic<uint64_t> num_errors_{0};
   uint64_t num_sent_{0};
-  uint64_t num_received_{0};
+  std::atomic<uint64_t> num_received_{0};
+
+  AsyncReceiver<std::shared_ptr<google::protobuf::Message>> receiver_;
 };
 
 class OsiTransceiverTcpFactory : public TcpTransceiverFactory<OsiTransceiverTcp> {
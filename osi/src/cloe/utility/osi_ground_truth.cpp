@@ -28,20 +28,29 @@
 namespace cloe::utility {
 
 const osi3::MovingObject* OsiGroundTruth::get_moving_object(const uint64_t id) const {
-  for (const auto& osi_obj : gt_ptr_->moving_object()) {
-    if (osi_obj.id().value() == id) {
-      return &osi_obj;
-    }
+  const auto* osi_obj = this->find_moving_object(id);
+  if (osi_obj == nullptr) {
+    throw cloe::ModelError("OSI ground truth object not found");
   }
-  throw cloe::ModelError("OSI ground truth object not found");
+  return osi_obj;
 }
 
 void OsiGroundTruth::set(const osi3::GroundTruth& osi_gt) {
   this->gt_ptr_ = &osi_gt;
+  mov_obj_index_.clear();
+  mov_obj_info_.clear();
+  mov_obj_index_.reserve(osi_gt.moving_object_size());
+  mov_obj_info_.reserve(osi_gt.moving_object_size());
   for (int i_mo = 0; i_mo < osi_gt.moving_object_size(); ++i_mo) {
     const osi3::MovingObject& osi_mo = osi_gt.moving_object(i_mo);
     int obj_id = osi_identifier(osi_mo.id());
 
+    // Index the object; if an id occurs twice, the first one wins as before.
+    auto& info = this->info(obj_id);
+    if (info.osi_mo == nullptr) {
+      info.osi_mo = &osi_mo;
+    }
+
     // Store geometric information of different object reference frames.
     if (osi_mo.has_vehicle_attributes()) {
       this->store_veh_coord_sys_info(obj_id, osi_mo.vehicle_attributes());
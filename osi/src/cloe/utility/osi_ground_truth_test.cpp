@@ -0,0 +1,140 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file osi_ground_truth_test.cpp
+ * \see  osi_ground_truth.hpp
+ * \see  osi_ground_truth.cpp
+ */
+
+#include <chrono>    // for steady_clock, duration
+#include <iostream>  // for cout
+#include <string>    // for to_string
+
+#include <gtest/gtest.h>  // for TEST, ASSERT_EQ, ...
+
+#include <osi3/osi_groundtruth.pb.h>  // for GroundTruth
+#include <osi3/osi_object.pb.h>       // for MovingObject
+
+#include "cloe/utility/osi_ground_truth.hpp"  // for OsiGroundTruth
+
+using cloe::utility::OsiGroundTruth;
+
+osi3::GroundTruth make_traffic_ground_truth(int num_objects) {
+  osi3::GroundTruth gt;
+  gt.mutable_host_vehicle_id()->set_value(0);
+  for (int i = 0; i < num_objects; i++) {
+    auto* mo = gt.add_moving_object();
+    // Use non-contiguous ids, as simulators do.
+    mo->mutable_id()->set_value(static_cast<uint64_t>(i) * 7);
+    auto* dim = mo->mutable_base()->mutable_dimension();
+    dim->set_length(4.0 + i);
+    dim->set_width(2.0);
+    dim->set_height(1.5);
+    if (i % 2 == 0) {
+      mo->mutable_vehicle_attributes()->mutable_bbcenter_to_rear()->set_x(-1.0 * i);
+    }
+  }
+  return gt;
+}
+
+const osi3::MovingObject* linear_find(const osi3::GroundTruth& gt, uint64_t id) {
+  for (const auto& osi_obj : gt.moving_object()) {
+    if (osi_obj.id().value() == id) {
+      return &osi_obj;
+    }
+  }
+  return nullptr;
+}
+
+TEST(osi_ground_truth, lookup) {
+  auto gt = make_traffic_ground_truth(10);
+  OsiGroundTruth ogt;
+  ogt.set(gt);
+
+  ASSERT_EQ(10, ogt.num_moving_objects());
+  ASSERT_EQ(&gt.moving_object(3), ogt.get_moving_object(21));
+  ASSERT_EQ(&gt.moving_object(0), ogt.get_moving_object(ogt.get_ego_id()));
+  ASSERT_EQ(nullptr, ogt.find_moving_object(22));
+  ASSERT_THROW((void)ogt.get_moving_object(22), cloe::ModelError);
+
+  ASSERT_DOUBLE_EQ(7.0, ogt.get_mov_obj_dimensions(21)(0));
+  ASSERT_DOUBLE_EQ(-4.0, ogt.get_veh_coord_sys_info(28)(0));
+  ASSERT_THROW((void)ogt.get_veh_coord_sys_info(21), std::out_of_range);
+  ASSERT_THROW((void)ogt.get_mov_obj_dimensions(22), std::out_of_range);
+
+  ogt.reset();
+  ASSERT_EQ(0, ogt.num_moving_objects());
+  ASSERT_EQ(nullptr, ogt.find_moving_object(21));
+}
+
+TEST(osi_ground_truth, lookup_many) {
+  // The indexed lookup must agree with a linear scan over all objects,
+  // including ids that lie between the non-contiguous ids of the objects.
+  constexpr int num_objects = 1000;
+  auto gt = make_traffic_ground_truth(num_objects);
+  OsiGroundTruth ogt;
+  ogt.set(gt);
+
+  ASSERT_EQ(num_objects, ogt.num_moving_objects());
+  for (uint64_t id = 0; id <= static_cast<uint64_t>(num_objects) * 7; id++) {
+    ASSERT_EQ(linear_find(gt, id), ogt.find_moving_object(id)) << "id " << id;
+  }
+
+  // Setting the ground truth again rebuilds the index.
+  auto gt2 = make_traffic_ground_truth(num_objects / 2);
+  ogt.set(gt2);
+  ASSERT_EQ(num_objects / 2, ogt.num_moving_objects());
+  ASSERT_EQ(&gt2.moving_object(1), ogt.find_moving_object(7));
+  ASSERT_EQ(nullptr, ogt.find_moving_object(static_cast<uint64_t>(num_objects / 2) * 7));
+}
+
+TEST(osi_ground_truth, DISABLED_lookup_benchmark) {
+  // Compare the indexed lookup of every object against a linear scan, as
+  // done when converting detected objects. Run with:
+  //
+  //   test-osi --gtest_also_run_disabled_tests --gtest_filter='*lookup_benchmark'
+  using Clock = std::chrono::steady_clock;
+  using Microseconds = std::chrono::duration<double, std::micro>;
+
+  constexpr int num_objects = 1000;
+  auto gt = make_traffic_ground_truth(num_objects);
+
+  auto t0 = Clock::now();
+  OsiGroundTruth ogt;
+  ogt.set(gt);
+  int found_indexed = 0;
+  for (const auto& osi_obj : gt.moving_object()) {
+    found_indexed += (ogt.get_moving_object(osi_obj.id().value()) == &osi_obj);
+  }
+  auto t1 = Clock::now();
+  int found_linear = 0;
+  for (const auto& osi_obj : gt.moving_object()) {
+    found_linear += (linear_find(gt, osi_obj.id().value()) == &osi_obj);
+  }
+  auto t2 = Clock::now();
+
+  ASSERT_EQ(num_objects, found_indexed);
+  ASSERT_EQ(num_objects, found_linear);
+  double indexed_us = Microseconds(t1 - t0).count();
+  double linear_us = Microseconds(t2 - t1).count();
+  RecordProperty("indexed_us", std::to_string(indexed_us));
+  RecordProperty("linear_us", std::to_string(linear_us));
+  std::cout << "lookup of " << num_objects << " moving objects: "
+            << "indexed (incl. set) " << indexed_us << " us, "
+            << "linear " << linear_us << " us" << std::endl;
+}
@@ -22,10 +22,12 @@
 
 #include "cloe/utility/osi_message_handler.hpp"
 
-#include <cassert>  // for assert
-#include <cmath>    // for atan
-#include <limits>   // for numeric_limits<>
-#include <map>      // for map<>
+#include <algorithm>  // for reverse
+#include <cassert>    // for assert
+#include <cmath>      // for atan
+#include <limits>     // for numeric_limits<>
+#include <map>        // for map<>
+#include <vector>     // for vector<>
 
 #include <Eigen/Geometry>  // for Isometry3d, Vector3d
 
@@ -190,11 +192,12 @@ void from_osi_detected_moving_object_alt(const osi3::DetectedMovingObject& osi_m
   from_osi_detected_item_header(osi_mo.header(), obj);
 
   // Get ground truth info for this object as fallback for missing data.
-  osi3::MovingObject osi_mo_gt(*(ground_truth.get_moving_object(obj.id)));
-  osi3::MovingObject osi_ego_gt(*(ground_truth.get_moving_object(ground_truth.get_ego_id())));
+  const auto& osi_mo_gt = *(ground_truth.get_moving_object(obj.id));
+  const auto& osi_ego_gt = *(ground_truth.get_moving_object(ground_truth.get_ego_id()));
   // Transform coordinates to osi detected object convention, i.e. into ego
-  // vehicle frame.
-  osi_transform_base_moving(osi_ego_gt.base(), *(osi_mo_gt.mutable_base()));
+  // vehicle frame. Only the base is modified, so we only copy that.
+  osi3::BaseMoving osi_mo_gt_base(osi_mo_gt.base());
+  osi_transform_base_moving(osi_ego_gt.base(), osi_mo_gt_base);
 
   // Object classification
   if (osi_mo.candidate_size() > 0) {
@@ -208,7 +211,7 @@ void from_osi_detected_moving_object_alt(const osi3::DetectedMovingObject& osi_m
   assert(obj.id != static_cast<int>(ground_truth.get_ego_id()));
   // DetectedMovingObject::base: "The bounding box does NOT include mirrors for
   // vehicles. The parent frame of base is the sensor's [vehicle frame]."
-  from_osi_base_moving_alt(osi_mo.base(), osi_mo_gt.base(), obj);
+  from_osi_base_moving_alt(osi_mo.base(), osi_mo_gt_base, obj);
   // TODO(tobias): handle sensor-specific data: if (osi_mo.has_radar_specifics())
 }
 
@@ -360,7 +363,7 @@ void OsiMsgHandler::process_osi_msgs(const Sync& s, const bool& restart, Duratio
   // Cycle until osi message has been received.
   int n_msg{0};
   while (n_msg == 0 || restart) {
-    std::vector<std::shared_ptr<T>> osi_msgs;
+    std::vector<std::shared_ptr<const T>> osi_msgs;
     osi_comm_->receive_osi_msgs(osi_msgs);
     if (osi_msgs.size() > 0) {
       osi_logger()->trace("OsiMsgHandler: processing {} messages at Cloe frame no {}",
@@ -401,7 +404,7 @@ void OsiMsgHandler::handle_first_message(const osi3::Timestamp& timestamp) {
   init_time_ = osi_timestamp_to_time(timestamp);
 }
 
-void OsiMsgHandler::process_received_msg(osi3::SensorData* osi_sd, Duration& osi_time) {
+void OsiMsgHandler::process_received_msg(const osi3::SensorData* osi_sd, Duration& osi_time) {
   if (osi_sd == nullptr) {
     return;
   }
@@ -518,7 +521,7 @@ void OsiMsgHandler::process_received_msg(osi3::SensorData* osi_sd, Duration& osi
   ground_truth_->reset();
 }
 
-void OsiMsgHandler::process_received_msg(osi3::SensorView* osi_sv, Duration& osi_time) {
+void OsiMsgHandler::process_received_msg(const osi3::SensorView* osi_sv, Duration& osi_time) {
   if (osi_sv == nullptr) {
     return;
   }
@@ -579,7 +582,7 @@ void OsiMsgHandler::process_received_msg(osi3::SensorView* osi_sv, Duration& osi
   ground_truth_->reset();
 }
 
-void OsiMsgHandler::process_received_msg(osi3::GroundTruth* osi_gt, Duration& osi_time) {
+void OsiMsgHandler::process_received_msg(const osi3::GroundTruth* osi_gt, Duration& osi_time) {
   if (osi_gt == nullptr) {
     return;
   }
@@ -791,6 +794,8 @@ bool skip_polygonal_objects(const TOsiObject& obj) {
 
 void OsiMsgHandler::detected_moving_objects_from_ground_truth() {
   const auto& osi_gt = ground_truth_->get_gt();
+  // Look up the ego only once, and only if there is an object to convert.
+  const osi3::MovingObject* osi_ego = nullptr;
   // Set moving object data.
   for (const auto& osi_obj : osi_gt.moving_object()) {
     osi_require("GroundTruth-MovingObject::id", osi_obj.has_id());
@@ -799,6 +804,9 @@ void OsiMsgHandler::detected_moving_objects_from_ground_truth() {
       if (skip_polygonal_objects(osi_obj)) {
         continue;
       }
+      if (osi_ego == nullptr) {
+        osi_ego = ground_truth_->get_moving_object(owner_id_);
+      }
       auto obj = std::make_shared<Object>();
       // Set existence probability.
       obj->exist_prob = 1.0;
@@ -808,7 +816,6 @@ void OsiMsgHandler::detected_moving_objects_from_ground_truth() {
       from_osi_mov_obj_type_classification(osi_obj, obj->classification);
       // Set type, pose, dimensions, rel. velocity, rel. acceleration, rel. angular_velocity.
       osi3::BaseMoving base_rel = osi_obj.base();
-      const auto* osi_ego = ground_truth_->get_moving_object(owner_id_);
       // Rel. velocity.
       double delta = base_rel.velocity().x() - osi_ego->base().velocity().x();
       base_rel.mutable_velocity()->set_x(delta);
@@ -916,21 +923,35 @@ void OsiMsgHandler::detected_static_objects_from_ground_truth() {
   }
 }
 
-void OsiMsgHandler::from_osi_boundary_points(const osi3::LaneBoundary& osi_lb,
-                                             LaneBoundary& lb,
-                                             bool reverse_pt_order = false) {
+namespace {
+
+/**
+ * Copy the boundary points in the inertial frame, in ascending order.
+ */
+void osi_boundary_points_to_vector(const osi3::LaneBoundary& osi_lb,
+                                   bool reverse_pt_order,
+                                   std::vector<Eigen::Vector3d>& points) {
   assert(osi_lb.boundary_line_size() > 0);
+  points.reserve(osi_lb.boundary_line_size());
   for (int i = 0; i < osi_lb.boundary_line_size(); ++i) {
-    const auto& osi_pt = osi_lb.boundary_line(i);
-    Eigen::Vector3d position = osi_vector3d_xyz_to_vector3d(osi_pt.position());
-    // Transform points from the inertial into the sensor reference frame.
-    transform_point_to_child_frame(osi_ego_pose_, &position);
-    transform_point_to_child_frame(osi_sensor_pose_, &position);
-    lb.points.push_back(position);
+    points.push_back(osi_vector3d_xyz_to_vector3d(osi_lb.boundary_line(i).position()));
   }
   // Provide points in ascending order.
   if (reverse_pt_order) {
-    std::reverse(lb.points.begin(), lb.points.end());
+    std::reverse(points.begin(), points.end());
+  }
+}
+
+/**
+ * Transform points from the inertial into the sensor reference frame and
+ * compute the lane boundary segment from them.
+ */
+void transform_boundary_points(const Eigen::Isometry3d& ego_pose,
+                               const Eigen::Isometry3d& sensor_pose,
+                               LaneBoundary& lb) {
+  for (auto& position : lb.points.mutate()) {
+    transform_point_to_child_frame(ego_pose, &position);
+    transform_point_to_child_frame(sensor_pose, &position);
   }
   // Compute clothoid segment. TODO(tobias): implement curved segments.
   lb.dx_start = lb.points.front()(0);
@@ -942,8 +963,12 @@ void OsiMsgHandler::from_osi_boundary_points(const osi3::LaneBoundary& osi_lb,
   lb.dx_end = lb.points.back()(0);
 }
 
-void OsiMsgHandler::detected_lane_boundaries_from_ground_truth() {
-  const auto& osi_gt = ground_truth_->get_gt();
+/**
+ * Convert all lane boundaries of the ground truth with points in the inertial
+ * frame.
+ */
+void lane_boundaries_from_ground_truth(const osi3::GroundTruth& osi_gt,
+                                       std::vector<LaneBoundary>& lbs) {
   // Flip lane boundary point order if centerline is not in ascending order.
   std::map<int, int> lbs_flip_pt_order;
   for (const auto& osi_lane : osi_gt.lane()) {
@@ -978,9 +1003,11 @@ void OsiMsgHandler::detected_lane_boundaries_from_ground_truth() {
   }
 
   // Set lane boundary data.
+  lbs.clear();
+  lbs.reserve(osi_gt.lane_boundary_size());
   for (const auto& osi_lb : osi_gt.lane_boundary()) {
     if (osi_lb.has_classification()) {
-      LaneBoundary lb;
+      LaneBoundary& lb = lbs.emplace_back();
       if (osi_lb.has_id()) {
         lb.id = osi_identifier(osi_lb.id());
       } else {
@@ -990,17 +1017,35 @@ void OsiMsgHandler::detected_lane_boundaries_from_ground_truth() {
       lb.prev_id = -1;  // no concatenated line segments for now
       lb.next_id = -1;
       ++lb_id;
-      if (lbs_flip_pt_order.find(lb.id) == lbs_flip_pt_order.end()) {
-        from_osi_boundary_points(osi_lb, lb, false);
-
-      } else {
-        from_osi_boundary_points(osi_lb, lb, true);
-      }
+      bool reverse_pt_order = lbs_flip_pt_order.find(lb.id) != lbs_flip_pt_order.end();
+      osi_boundary_points_to_vector(osi_lb, reverse_pt_order, lb.points.mutate());
       lb.type = osi_lane_bdry_type_map.at(osi_lb.classification().type());
       lb.color = osi_lane_bdry_color_map.at(osi_lb.classification().color());
-      store_lane_boundary(lb);
     }
   }
 }
 
+}  // anonymous namespace
+
+void OsiMsgHandler::from_osi_boundary_points(const osi3::LaneBoundary& osi_lb,
+                                             LaneBoundary& lb,
+                                             bool reverse_pt_order = false) {
+  osi_boundary_points_to_vector(osi_lb, reverse_pt_order, lb.points.mutate());
+  transform_boundary_points(osi_ego_pose_, osi_sensor_pose_, lb);
+}
+
+void OsiMsgHandler::detected_lane_boundaries_from_ground_truth() {
+  auto revision = osi_comm_->static_ground_truth_revision();
+  if (revision == 0 || revision != static_lane_boundaries_revision_) {
+    lane_boundaries_from_ground_truth(ground_truth_->get_gt(), static_lane_boundaries_);
+    static_lane_boundaries_revision_ = revision;
+  }
+
+  for (const auto& static_lb : static_lane_boundaries_) {
+    LaneBoundary lb = static_lb;
+    transform_boundary_points(osi_ego_pose_, osi_sensor_pose_, lb);
+    store_lane_boundary(lb);
+  }
+}
+
 }  // namespace cloe::utility
@@ -21,84 +21,108 @@
 
 #include "cloe/utility/osi_transceiver_tcp.hpp"
 
-#include <cstdlib>  // for malloc, free
+#include <cstdint>  // for uint8_t, uint32_t
 #include <memory>   // for shared_ptr<>
+#include <string>   // for string
 
-#include <cloe/core.hpp>                     // for Error
 #include <cloe/utility/tcp_transceiver.hpp>  // for TcpReadError
 
-#include <google/protobuf/io/coded_stream.h>                // for CodedInputStream
+#include <google/protobuf/io/coded_stream.h>                // for CodedInputStream, ...
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>  // for ArrayInputStream
 
-#include <osi3/osi_sensordata.pb.h>  // for SensorData
+#include <osi3/osi_groundtruth.pb.h>  // for GroundTruth
+#include <osi3/osi_sensordata.pb.h>   // for SensorData
+#include <osi3/osi_sensorview.pb.h>   // for SensorView
 
 namespace cloe::utility {
 
-// This method reads a complete SensorData struct from the stream.
+std::string osi_tcp_frame(const google::protobuf::MessageLite& msg) {
+  auto data_size = msg.ByteSizeLong();
+  std::string frame(sizeof(uint32_t) + data_size, '\0');
+  auto buf = reinterpret_cast<uint8_t*>(frame.data());
+  buf = google::protobuf::io::CodedOutputStream::WriteLittleEndian32ToArray(
+      static_cast<uint32_t>(data_size), buf);
+  msg.SerializeWithCachedSizesToArray(buf);
+  return frame;
+}
+
+// This method reads a complete frame from the stream into frame_buf_.
 //
-// First, we read the header of the message to find out how much memory we have to allocate,
+// First, we read the header of the frame to find out how much memory we need,
 // and then we read the rest of the data after verifying the validity of the header.
-std::shared_ptr<osi3::SensorData> OsiTransceiverTcp::receive_sensor_data_wait() {
+// Since the read blocks until all requested data is available, frames that
+// arrive in several parts are handled transparently.
+uint32_t OsiTransceiverTcp::receive_frame_wait() {
   // 1. Read the header (= data_size).
-  auto hdr_buf = reinterpret_cast<uint32_t*>(malloc(sizeof(uint32_t)));
-  tcp_stream_.read(reinterpret_cast<char*>(hdr_buf), sizeof(uint32_t));
-  if (!tcp_stream_) {
-    free(hdr_buf);
+  uint8_t hdr_buf[sizeof(uint32_t)];
+  tcp_reader_.read(reinterpret_cast<char*>(hdr_buf), sizeof(uint32_t));
+  if (!tcp_reader_) {
     this->num_errors_++;
     throw TcpReadError("OsiTransceiverTcp: error during header read: {}",
-                       tcp_stream_.error().message());
+                       tcp_reader_.error().message());
   }
 
-  // Parse as protobuf for consistency with send().
-  google::protobuf::io::ArrayInputStream hdr_array_input(hdr_buf, sizeof(uint32_t));
-  google::protobuf::io::CodedInputStream hdr_code_input(&hdr_array_input);
-
+  // Decode as protobuf for consistency with osi_tcp_frame().
   uint32_t data_size = 0;
-  hdr_code_input.ReadLittleEndian32(&data_size);
-  free(hdr_buf);
-
-  // 2.a) Allocate enough memory for the message.
-  auto data_buf = reinterpret_cast<char*>(malloc(data_size));
-  if (data_buf == nullptr) {
-    throw Error("OsiTransceiverTcp: malloc failed");
+  google::protobuf::io::CodedInputStream::ReadLittleEndian32FromArray(hdr_buf, &data_size);
+  if (data_size > max_frame_size) {
+    this->num_errors_++;
+    throw OsiError("OsiTransceiverTcp: frame size {} exceeds maximum of {}", data_size,
+                   max_frame_size);
   }
 
-  // 2.b) Read the message.
-  tcp_stream_.read(data_buf, data_size);
-  if (!tcp_stream_) {
-    free(data_buf);
+  // 2. Read the message, re-using the frame buffer from previous reads.
+  if (frame_buf_.size() < data_size) {
+    frame_buf_.resize(data_size);
+  }
+  tcp_reader_.read(frame_buf_.data(), data_size);
+  if (!tcp_reader_) {
     this->num_errors_++;
-    throw TcpReadError("OsiTransceiverTcp: error during read: {}", tcp_stream_.error().message());
+    throw TcpReadError("OsiTransceiverTcp: error during read: {}", tcp_reader_.error().message());
   }
+  return data_size;
+}
+
+// This method reads and parses a complete message of type T from the stream.
+template <typename T>
+std::shared_ptr<T> OsiTransceiverTcp::receive_msg_wait() {
+  auto data_size = this->receive_frame_wait();
 
   // 3. Parse the data message as protobuf input stream.
-  google::protobuf::io::ArrayInputStream array_input(data_buf, data_size);
+  google::protobuf::io::ArrayInputStream array_input(frame_buf_.data(), static_cast<int>(data_size));
   google::protobuf::io::CodedInputStream code_input(&array_input);
-  google::protobuf::io::CodedInputStream::Limit pb_limit = code_input.PushLimit(data_size);
+  google::protobuf::io::CodedInputStream::Limit pb_limit =
+      code_input.PushLimit(static_cast<int>(data_size));
 
-  auto sensor_data_rcv = std::make_shared<osi3::SensorData>();
-  if (!sensor_data_rcv->ParseFromCodedStream(&code_input)) {
-    throw OsiError("OsiTransceiverTcp: failure while parsing osi message");
+  auto msg = std::make_shared<T>();
+  if (!msg->ParseFromCodedStream(&code_input)) {
+    this->num_errors_++;
+    throw OsiError("OsiTransceiverTcp: failure while parsing osi3::{} message",
+                   T::descriptor()->name());
   }
   code_input.PopLimit(pb_limit);
 
-  // 4. Cleanup.
-  free(data_buf);
-
-  // 5. Consistency checks.
-  if (sensor_data_rcv->ByteSizeLong() != static_cast<size_t>(data_size)) {
+  // 4. Consistency checks.
+  if (msg->ByteSizeLong() != static_cast<size_t>(data_size)) {
     this->num_errors_++;
-    throw OsiError("OsiTransceiverTcp: inconsistent data size in osi protobuf message");
+    throw OsiError("OsiTransceiverTcp: inconsistent data size in osi3::{} message",
+                   T::descriptor()->name());
   }
 
-  if (!sensor_data_rcv->IsInitialized()) {
+  if (!msg->IsInitialized()) {
     this->num_errors_++;
-    throw OsiError(
-        "OsiTransceiverTcp: incoming osi sensor_data message was not correctly initialized");
+    throw OsiError("OsiTransceiverTcp: incoming osi3::{} message was not correctly initialized",
+                   T::descriptor()->name());
   }
 
-  // 5. Wrap the result in a shared_ptr and return it.
-  return sensor_data_rcv;
+  // 5. Return the result as shared_ptr.
+  this->num_received_++;
+  return msg;
 }
 
+template std::shared_ptr<osi3::SensorData> OsiTransceiverTcp::receive_msg_wait<osi3::SensorData>();
+template std::shared_ptr<osi3::SensorView> OsiTransceiverTcp::receive_msg_wait<osi3::SensorView>();
+template std::shared_ptr<osi3::GroundTruth>
+OsiTransceiverTcp::receive_msg_wait<osi3::GroundTruth>();
+
 }  // namespace cloe::utility
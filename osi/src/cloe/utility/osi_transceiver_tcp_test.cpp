@@ -0,0 +1,204 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file osi_transceiver_tcp_test.cpp
+ * \see  osi_transceiver_tcp.hpp
+ * \see  osi_transceiver_tcp.cpp
+ */
+
+#include <chrono>  // for steady_clock, milliseconds
+#include <memory>  // for shared_ptr<>
+#include <string>  // for string
+#include <thread>  // for sleep_for
+#include <vector>  // for vector<>
+
+#include <gtest/gtest.h>   // for TEST, ASSERT_EQ, ...
+#include <boost/asio.hpp>  // for io_context, acceptor, socket, write
+
+#include <osi3/osi_groundtruth.pb.h>  // for GroundTruth
+#include <osi3/osi_sensordata.pb.h>   // for SensorData
+#include <osi3/osi_sensorview.pb.h>   // for SensorView
+
+#include "cloe/utility/osi_transceiver_tcp.hpp"  // for OsiTransceiverTcp, osi_tcp_frame
+
+using cloe::utility::osi_tcp_frame;
+using cloe::utility::OsiTransceiverTcp;
+using boost::asio::ip::tcp;
+
+/**
+ * OsiTcpProducer is a local stand-in for an external OSI producer, such as
+ * a simulator or sensor model, which writes length-prefixed frames to the
+ * first client that connects.
+ */
+class OsiTcpProducer {
+ public:
+  OsiTcpProducer() : acceptor_(io_, tcp::endpoint(tcp::v4(), 0)), socket_(io_) {}
+
+  uint16_t port() const { return acceptor_.local_endpoint().port(); }
+
+  void accept() { acceptor_.accept(socket_); }
+
+  void send(const std::string& bytes) { boost::asio::write(socket_, boost::asio::buffer(bytes)); }
+
+  void send(const google::protobuf::MessageLite& msg) { send(osi_tcp_frame(msg)); }
+
+  std::string receive(size_t n) {
+    std::string bytes(n, '\0');
+    boost::asio::read(socket_, boost::asio::buffer(bytes));
+    return bytes;
+  }
+
+  void close() { socket_.close(); }
+
+ private:
+  boost::asio::io_context io_;
+  tcp::acceptor acceptor_;
+  tcp::socket socket_;
+};
+
+template <typename T>
+std::vector<std::shared_ptr<T>> receive_n(OsiTransceiverTcp& t, size_t n) {
+  std::vector<std::shared_ptr<T>> result;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (result.size() < n && std::chrono::steady_clock::now() < deadline) {
+    std::vector<std::shared_ptr<T>> msgs;
+    t.receive_osi_msgs(msgs);
+    result.insert(result.end(), msgs.begin(), msgs.end());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return result;
+}
+
+osi3::GroundTruth make_ground_truth(int64_t seconds, size_t num_objects) {
+  osi3::GroundTruth gt;
+  gt.mutable_timestamp()->set_seconds(seconds);
+  for (size_t i = 0; i < num_objects; i++) {
+    gt.add_moving_object()->mutable_id()->set_value(i);
+  }
+  return gt;
+}
+
+TEST(osi_transceiver_tcp, ground_truth) {
+  OsiTcpProducer producer;
+  OsiTransceiverTcp transceiver("localhost", producer.port());
+  producer.accept();
+
+  transceiver.start_receiving<osi3::GroundTruth>();
+  ASSERT_FALSE(transceiver.has_ground_truth());
+  ASSERT_FALSE(transceiver.has_sensor_data());
+
+  producer.send(make_ground_truth(1, 3));
+
+  // Send a frame in two parts, which must not be received before it is complete.
+  auto frame = osi_tcp_frame(make_ground_truth(2, 100));
+  auto half = frame.size() / 2;
+  producer.send(frame.substr(0, half));
+  auto first = receive_n<osi3::GroundTruth>(transceiver, 1);
+  ASSERT_EQ(1, first.size());
+  ASSERT_EQ(1, first[0]->timestamp().seconds());
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_FALSE(transceiver.has_ground_truth());
+  producer.send(frame.substr(half));
+
+  auto second = receive_n<osi3::GroundTruth>(transceiver, 1);
+  ASSERT_EQ(1, second.size());
+  ASSERT_EQ(2, second[0]->timestamp().seconds());
+  ASSERT_EQ(100, second[0]->moving_object_size());
+  ASSERT_EQ(99, second[0]->moving_object(99).id().value());
+
+  // The connection carries GroundTruth, so other types cannot be received.
+  std::vector<std::shared_ptr<osi3::SensorData>> msgs;
+  ASSERT_THROW(transceiver.receive_osi_msgs(msgs), cloe::utility::OsiError);
+}
+
+TEST(osi_transceiver_tcp, has_after_start) {
+  OsiTcpProducer producer;
+  OsiTransceiverTcp transceiver("localhost", producer.port());
+  producer.accept();
+  producer.send(make_ground_truth(1, 3));
+
+  // Messages are only decoded once the reader thread has been started.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_FALSE(transceiver.has_ground_truth());
+
+  transceiver.start_receiving<osi3::GroundTruth>();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!transceiver.has_ground_truth() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(transceiver.has_ground_truth());
+  ASSERT_EQ(1, receive_n<osi3::GroundTruth>(transceiver, 1).size());
+}
+
+TEST(osi_transceiver_tcp, sensor_view) {
+  OsiTcpProducer producer;
+  OsiTransceiverTcp transceiver("localhost", producer.port());
+  producer.accept();
+
+  for (int64_t i = 0; i < 10; i++) {
+    osi3::SensorView sv;
+    sv.mutable_timestamp()->set_seconds(i);
+    *sv.mutable_global_ground_truth() = make_ground_truth(i, 5);
+    producer.send(sv);
+  }
+
+  auto msgs = receive_n<osi3::SensorView>(transceiver, 10);
+  ASSERT_EQ(10, msgs.size());
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_EQ(i, msgs[i]->timestamp().seconds());
+    ASSERT_EQ(5, msgs[i]->global_ground_truth().moving_object_size());
+  }
+}
+
+TEST(osi_transceiver_tcp, sensor_data_echo) {
+  OsiTcpProducer producer;
+  OsiTransceiverTcp transceiver("localhost", producer.port());
+  producer.accept();
+
+  // Frames sent by the transceiver are sent back to it unchanged.
+  osi3::SensorData sd;
+  sd.mutable_timestamp()->set_seconds(42);
+  transceiver.send_osi_msg(sd);
+  producer.send(producer.receive(osi_tcp_frame(sd).size()));
+
+  auto msgs = receive_n<osi3::SensorData>(transceiver, 1);
+  ASSERT_EQ(1, msgs.size());
+  ASSERT_EQ(42, msgs[0]->timestamp().seconds());
+}
+
+TEST(osi_transceiver_tcp, truncated_frame) {
+  OsiTcpProducer producer;
+  OsiTransceiverTcp transceiver("localhost", producer.port());
+  producer.accept();
+
+  auto frame = osi_tcp_frame(make_ground_truth(1, 10));
+  producer.send(frame.substr(0, frame.size() - 1));
+  producer.close();
+
+  std::vector<std::shared_ptr<osi3::GroundTruth>> msgs;
+  ASSERT_THROW(
+      {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+          transceiver.receive_osi_msgs(msgs);
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      },
+      cloe::utility::TcpReadError);
+  ASSERT_TRUE(msgs.empty());
+}
@@ -24,9 +24,10 @@
 
 #include <math.h>          // for atan
 #include <Eigen/Geometry>  // for Isometry3d
-#include <map>             // for map
 #include <memory>          // for shared_ptr<>
 #include <string>          // for string
+#include <unordered_map>   // for unordered_map<>
+#include <utility>         // for move
 #include <vector>          // for vector
 
 #include <cloe/component.hpp>                // for Component, Json
@@ -38,8 +39,9 @@
 #include <cloe/registrar.hpp>                // for Registrar
 #include <cloe/sync.hpp>                     // for Sync
 #include <cloe/trigger/set_action.hpp>       // for actions::SetVariableActionFactory
+#include <cloe/utility/cow_vector.hpp>       // for CowVector
 
-#include "g1_fitting.hpp"  // for calc_clothoid
+#include "g1_fitting.hpp"  // for calc_clothoid, ClothoidBatch
 
 namespace cloe {
 
@@ -74,16 +76,24 @@ double estimate_lane_boundary_length(const std::vector<Eigen::Vector3d>& points)
   return length;
 }
 
-void cleanup_lane_boundary_points(std::vector<Eigen::Vector3d>& points) {
+/**
+ * Return the polyline points without points that are too close to their
+ * predecessor.
+ *
+ * \param points: Lane boundary polyline points.
+ */
+std::vector<Eigen::Vector3d> cleanup_lane_boundary_points(
+    const std::vector<Eigen::Vector3d>& points) {
   // Points shall have at least 1cm distance for robust clothoid estimation.
   const double min_dist = 0.01;
   std::vector<Eigen::Vector3d> pts_mod{points.front()};
+  pts_mod.reserve(points.size());
   for (uint64_t i = 1; i < points.size(); ++i) {
     if ((points[i] - points[i - 1]).norm() > min_dist) {
       pts_mod.push_back(points[i]);
     }
   }
-  points = pts_mod;
+  return pts_mod;
 }
 
 // Keep track on which side of each frustum plane a point is located
@@ -310,7 +320,7 @@ void lane_boundary_point_culling(const Frustum& frustum, std::vector<Eigen::Vect
       mask_out_end.push_back(plane_mask);
     }
   }
-  points = pts_frustum;
+  points = std::move(pts_frustum);
 }
 
 /**
@@ -341,25 +351,35 @@ double calc_heading_angle_adv(const Eigen::Vector3d& ptm1, const Eigen::Vector3d
 }
 
 /**
-   * Fit one clothoid segment to the given polyline using a point and heading
-   * angle at the beginning and end of the polyline segment of interest,
-   * respectively.
-   *
-   * \param lb: Lane boundary with polyline data.
-   */
-bool fit_clothoid(const cloe::Logger& logger, bool frustum_culling, const Frustum& frustum,
-                  LaneBoundary& lb) {
+ * Prepare fitting one clothoid segment to the given polyline using a point
+ * and heading angle at the beginning and end of the polyline segment of
+ * interest, respectively.
+ *
+ * This cleans up and culls the points of lb, sets the start of the segment,
+ * and adds the clothoid fitting problem to the batch. Use apply_clothoid_fit
+ * after solving the batch to set the remaining parameters of lb.
+ *
+ * Return false if lb cannot be fitted.
+ *
+ * \param lb: Lane boundary with polyline data.
+ * \param batch: Clothoid fitting problems to add to.
+ */
+bool prepare_clothoid_fit(const cloe::Logger& logger, bool frustum_culling, const Frustum& frustum,
+                          LaneBoundary& lb, g1_fit::ClothoidBatch& batch) {
   if (estimate_lane_boundary_length(lb.points) < 0.5) {
     // Discard tiny lane boundary snippets.
     logger->debug("Discarding short lane boundary segment < 0.5m.");
     return false;
   }
-  cleanup_lane_boundary_points(lb.points);
+  // The points of lb may be shared with the source sensor, so we build the
+  // modified polyline separately instead of modifying them in place.
+  auto points = cleanup_lane_boundary_points(lb.points);
   // Store discarded points for advanced heading angle estimation.
   std::vector<Eigen::Vector3d> pts_out_start, pts_out_end;
   if (frustum_culling) {
-    lane_boundary_point_culling(frustum, lb.points, pts_out_start, pts_out_end);
+    lane_boundary_point_culling(frustum, points, pts_out_start, pts_out_end);
   }
+  lb.points = std::move(points);
   if (lb.points.size() < 2) {
     logger->debug("Clothoid fit requires at least two points.");
     return false;
@@ -382,13 +402,189 @@ bool fit_clothoid(const cloe::Logger& logger, bool frustum_culling, const Frustu
   } else {
     hdg1 = calc_heading_angle(lb.points.at(n - 1), lb.points.at(n));
   }
-  // Compute clothoid parameters curv_hor_start, curv_hor_change and dx_end.
-  g1_fit::calc_clothoid(x0.x(), x0.y(), hdg0, x1.x(), x1.y(), hdg1, lb.curv_hor_start,
-                        lb.curv_hor_change, lb.dx_end);
+  batch.push_back(x0.x(), x0.y(), hdg0, x1.x(), x1.y(), hdg1);
+  return true;
+}
 
+/**
+ * Set the clothoid parameters curv_hor_start, curv_hor_change and dx_end of
+ * lb from problem i of the solved batch.
+ */
+void apply_clothoid_fit(const g1_fit::ClothoidBatch& batch, size_t i, LaneBoundary& lb) {
+  lb.curv_hor_start = batch.k[i];
+  lb.curv_hor_change = batch.dk[i];
+  lb.dx_end = batch.l[i];
+}
+
+/**
+ * Fit one clothoid segment to the given polyline.
+ *
+ * \see prepare_clothoid_fit
+ * \param lb: Lane boundary with polyline data.
+ */
+bool fit_clothoid(const cloe::Logger& logger, bool frustum_culling, const Frustum& frustum,
+                  LaneBoundary& lb) {
+  g1_fit::ClothoidBatch batch;
+  if (!prepare_clothoid_fit(logger, frustum_culling, frustum, lb, batch)) {
+    return false;
+  }
+  // Compute clothoid parameters curv_hor_start, curv_hor_change and dx_end.
+  g1_fit::calc_clothoid(batch.x0[0], batch.y0[0], batch.theta0[0], batch.x1[0], batch.y1[0],
+                        batch.theta1[0], lb.curv_hor_start, lb.curv_hor_change, lb.dx_end);
   return true;
 }
 
+/**
+ * ClothoidFitCache stores the result of fit_clothoid for each lane boundary,
+ * so that lane boundaries whose polyline did not change since the previous
+ * step are not fitted again.
+ *
+ * The cache keeps a copy of the input points of each lane boundary. Since
+ * the points are copy-on-write, a source that passes on unchanged points is
+ * recognized in constant time; otherwise the points are compared by value,
+ * which is still much cheaper than fitting.
+ *
+ * Usage per step:
+ *
+ *     cache.begin(frustum_culling, frustum);
+ *     for (...) { cache.fit(logger, id, lb); }
+ *     cache.end();
+ */
+class ClothoidFitCache {
+ public:
+  /**
+   * Start a new step, invalidating all results if the fit parameters changed.
+   */
+  void begin(bool frustum_culling, const Frustum& frustum) {
+    if (frustum_culling != frustum_culling_ || !same_frustum(frustum, frustum_)) {
+      entries_.clear();
+      frustum_culling_ = frustum_culling;
+      frustum_ = frustum;
+    }
+    generation_++;
+  }
+
+  enum class Result {
+    Miss,       ///< lb must be fitted, then passed to store()
+    Fitted,     ///< lb was set from the cached fit
+    Discarded,  ///< lb could not be fitted previously
+  };
+
+  /**
+   * Look up the cached fit for the lane boundary with the given id, and set
+   * the fitted parameters and points of lb on a hit.
+   *
+   * On a miss, the points of lb are remembered as the input for store().
+   */
+  Result lookup(int id, LaneBoundary& lb) {
+    auto& e = entries_[id];
+    e.generation = generation_;
+    if (e.valid && e.input == lb.points) {
+      num_hits_++;
+      if (!e.ok) {
+        return Result::Discarded;
+      }
+      lb.points = e.fitted.points;
+      lb.dx_start = e.fitted.dx_start;
+      lb.dy_start = e.fitted.dy_start;
+      lb.heading_start = e.fitted.heading_start;
+      lb.curv_hor_start = e.fitted.curv_hor_start;
+      lb.curv_hor_change = e.fitted.curv_hor_change;
+      lb.dx_end = e.fitted.dx_end;
+      return Result::Fitted;
+    }
+    num_misses_++;
+    e.valid = false;
+    e.input = lb.points;
+    return Result::Miss;
+  }
+
+  /**
+   * Store the result of fitting the lane boundary with the given id after a
+   * miss in lookup().
+   */
+  void store(int id, const LaneBoundary& fitted, bool ok) {
+    auto& e = entries_[id];
+    e.ok = ok;
+    if (ok) {
+      e.fitted = fitted;
+    }
+    e.valid = true;
+  }
+
+  /**
+   * Fit a clothoid to lb like fit_clothoid, or use the cached result for the
+   * lane boundary with the given id.
+   */
+  bool fit(const cloe::Logger& logger, int id, LaneBoundary& lb) {
+    switch (lookup(id, lb)) {
+      case Result::Fitted:
+        return true;
+      case Result::Discarded:
+        return false;
+      case Result::Miss:
+        break;
+    }
+    bool ok = fit_clothoid(logger, frustum_culling_, frustum_, lb);
+    store(id, lb, ok);
+    return ok;
+  }
+
+  [[nodiscard]] bool frustum_culling() const { return frustum_culling_; }
+  [[nodiscard]] const Frustum& frustum() const { return frustum_; }
+
+  /**
+   * Finish the step, removing lane boundaries that were not fitted in it.
+   */
+  void end() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.generation != generation_) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void clear() { entries_.clear(); }
+
+  [[nodiscard]] size_t size() const { return entries_.size(); }
+  [[nodiscard]] uint64_t num_hits() const { return num_hits_; }
+  [[nodiscard]] uint64_t num_misses() const { return num_misses_; }
+
+  friend void to_json(fable::Json& j, const ClothoidFitCache& c) {
+    j = fable::Json{
+        {"size", c.entries_.size()},
+        {"num_hits", c.num_hits_},
+        {"num_misses", c.num_misses_},
+    };
+  }
+
+ private:
+  static bool same_frustum(const Frustum& a, const Frustum& b) {
+    return a.fov_h == b.fov_h && a.offset_h == b.offset_h && a.fov_v == b.fov_v &&
+           a.offset_v == b.offset_v && a.clip_near == b.clip_near && a.clip_far == b.clip_far;
+  }
+
+  struct Entry {
+    utility::CowVector<Eigen::Vector3d> input;
+    LaneBoundary fitted;
+    uint64_t generation{0};
+    bool valid{false};
+    bool ok{false};
+  };
+
+ private:
+  std::unordered_map<int, Entry> entries_;
+  bool frustum_culling_{false};
+  Frustum frustum_;
+  uint64_t generation_{0};
+
+  // Statistics:
+  uint64_t num_hits_{0};
+  uint64_t num_misses_{0};
+};
+
 class LaneBoundaryClothoidFit : public LaneBoundarySensor {
  public:
   LaneBoundaryClothoidFit(const std::string& name, const ClothoidFitConf& conf,
@@ -404,26 +600,56 @@ class LaneBoundaryClothoidFit : public LaneBoundarySensor {
   }
 
   const LaneBoundaries& sensed_lane_boundaries() const override {
+    if (!config_.enabled) {
+      // Forward all lane boundaries from the source sensor component.
+      return sensor_in_->sensed_lane_boundaries();
+    }
     if (cached_) {
       return lbs_;
     }
-    if (config_.enabled) {
-      for (auto& kv : sensor_in_->sensed_lane_boundaries()) {
-        auto lb = kv.second;
-        if (fit_clothoid(logger(), config_.frustum_culling, this->frustum(), lb)) {
-          lbs_[kv.first] = lb;
-        }
+    // Lane boundaries that are not in the cache are fitted together in one
+    // batch after all of them have been prepared.
+    fit_cache_.begin(config_.frustum_culling, this->frustum());
+    batch_.clear();
+    batch_ids_.clear();
+    for (const auto& kv : sensor_in_->sensed_lane_boundaries()) {
+      auto it = lbs_.emplace_hint(lbs_.end(), kv.first, kv.second);
+      switch (fit_cache_.lookup(kv.first, it->second)) {
+        case ClothoidFitCache::Result::Fitted:
+          break;
+        case ClothoidFitCache::Result::Discarded:
+          lbs_.erase(it);
+          break;
+        case ClothoidFitCache::Result::Miss:
+          if (prepare_clothoid_fit(logger(), config_.frustum_culling, this->frustum(), it->second,
+                                   batch_)) {
+            batch_ids_.push_back(kv.first);
+          } else {
+            fit_cache_.store(kv.first, it->second, false);
+            lbs_.erase(it);
+          }
+          break;
       }
-    } else {
-      // Copy all lane boundaries from the source sensor component.
-      lbs_ = sensor_in_->sensed_lane_boundaries();
     }
+    g1_fit::calc_clothoid(batch_);
+    for (size_t i = 0; i < batch_ids_.size(); ++i) {
+      auto& lb = lbs_.at(batch_ids_[i]);
+      apply_clothoid_fit(batch_, i, lb);
+      fit_cache_.store(batch_ids_[i], lb, true);
+    }
+    fit_cache_.end();
     cached_ = true;
     return lbs_;
   }
 
   const Frustum& frustum() const override { return sensor_in_->frustum(); }
 
+  fable::Json active_state() const override {
+    auto j = LaneBoundarySensor::active_state();
+    j["clothoid_fit_cache"] = fit_cache_;
+    return j;
+  }
+
   const Eigen::Isometry3d& mount_pose() const override { return sensor_in_->mount_pose(); }
 
   /**
@@ -451,6 +677,7 @@ class LaneBoundaryClothoidFit : public LaneBoundarySensor {
     LaneBoundarySensor::reset();
     sensor_in_->reset();
     clear_cache();
+    fit_cache_.clear();
   }
 
   void abort() override {
@@ -467,8 +694,11 @@ class LaneBoundaryClothoidFit : public LaneBoundarySensor {
  private:
   ClothoidFitConf config_;
   std::shared_ptr<LaneBoundarySensor> sensor_in_;  // provides input data
-  mutable bool cached_;
+  mutable bool cached_{false};
   mutable LaneBoundaries lbs_;
+  mutable ClothoidFitCache fit_cache_;
+  mutable g1_fit::ClothoidBatch batch_;
+  mutable std::vector<int> batch_ids_;
   Duration time_{0};
 };
 
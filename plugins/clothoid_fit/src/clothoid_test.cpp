@@ -195,6 +195,77 @@ TEST(lane_boundary, clothoid_line) {
   EXPECT_NEAR(lb.dx_end, (lb.points.back() - lb.points.front()).norm(), tol);
 }
 
+TEST(lane_boundary, clothoid_copy_keeps_source_points) {
+  auto logger = cloe::logger::get("clothoid");
+  cloe::Frustum frustum;
+  frustum.fov_h = M_2X_PI;
+  frustum.fov_v = M_2X_PI;
+  frustum.clip_near = -0.001;
+  frustum.clip_far = 20.001;
+  cloe::LaneBoundary src;
+  src.points =
+      get_line_lb_points(Eigen::Vector3d(-5.0, 0.0, 0.0), Eigen::Vector3d(25.0, 0.0, 0.0), 7);
+
+  // Copies share the points of the source until the fit modifies them.
+  cloe::LaneBoundary lb = src;
+  EXPECT_EQ(lb.points.data(), src.points.data());
+  ASSERT_TRUE(cloe::component::fit_clothoid(logger, true, frustum, lb));
+  EXPECT_NE(lb.points.data(), src.points.data());
+  EXPECT_EQ(src.points.size(), 7);
+  EXPECT_DOUBLE_EQ(src.points.front().x(), -5.0);
+  EXPECT_NEAR(lb.points.front().x(), 0.0, 1E-3);
+  EXPECT_LT(lb.points.back().x(), 20.001);
+}
+
+TEST(lane_boundary, clothoid_fit_cache) {
+  auto logger = cloe::logger::get("clothoid");
+  cloe::Frustum frustum;
+  frustum.clip_near = -0.001;
+  frustum.clip_far = 20.001;
+  cloe::LaneBoundary src;
+  src.points =
+      get_line_lb_points(Eigen::Vector3d(-5.0, 0.0, 0.0), Eigen::Vector3d(25.0, 0.0, 0.0), 7);
+
+  cloe::component::ClothoidFitCache cache;
+  auto step = [&](const cloe::LaneBoundary& in) {
+    cloe::LaneBoundary lb = in;
+    cache.begin(true, frustum);
+    bool ok = cache.fit(logger, 1, lb);
+    cache.end();
+    EXPECT_TRUE(ok);
+    return lb;
+  };
+
+  auto lb1 = step(src);
+  EXPECT_EQ(cache.num_misses(), 1);
+  EXPECT_EQ(cache.num_hits(), 0);
+
+  // Same points storage and equal points are both hits.
+  auto lb2 = step(src);
+  cloe::LaneBoundary copy;
+  copy.points = src.points.get();
+  auto lb3 = step(copy);
+  EXPECT_EQ(cache.num_misses(), 1);
+  EXPECT_EQ(cache.num_hits(), 2);
+  EXPECT_EQ(lb2.points, lb1.points);
+  EXPECT_EQ(lb3.points, lb1.points);
+  EXPECT_DOUBLE_EQ(lb3.dx_end, lb1.dx_end);
+
+  // Changed points and a changed frustum are misses.
+  src.points.mutate()[6].x() = 30.0;
+  step(src);
+  EXPECT_EQ(cache.num_misses(), 2);
+  frustum.clip_far = 15.001;
+  auto lb4 = step(src);
+  EXPECT_EQ(cache.num_misses(), 3);
+  EXPECT_LT(lb4.points.back().x(), 15.001);
+
+  // Lane boundaries that disappear are evicted.
+  cache.begin(true, frustum);
+  cache.end();
+  EXPECT_EQ(cache.size(), 0);
+}
+
 TEST(frustum_exceed, error) {
   cloe::LaneBoundary lb;
   // Polyline in x-direction, culling (x-range). Cull at near-plane.
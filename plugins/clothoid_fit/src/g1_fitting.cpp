@@ -49,8 +49,11 @@
  * \see  g1_fitting.hpp
  */
 
+#include "g1_fitting.hpp"
+
 #include <math.h>     // for M_PI, ..
 #include <algorithm>  // for min, max
+#include <array>      // for array<>
 #include <cmath>      // for abs, sqrt
 #include <sstream>    // for ostringstream
 #include <stdexcept>  // for runtime_error
@@ -220,6 +223,126 @@ void calc_std_fresnel_integral(double y, double& int_c, double& int_s) {
   }
 }
 
+namespace {
+
+/**
+ * Coefficients of the power series for x < 1 used by the batch version of
+ * calc_std_fresnel_integral, in terms of t = -((pi/2)*x^2)^2:
+ *   c(x) = x * \sum_k t^k / ((2k)! * (4k+1))
+ *   s(x) = (pi/2) * x^3 * \sum_k t^k / ((2k+1)! * (4k+3))
+ *
+ * With 12 terms, the remainder is below 1e-17 for x < 1.
+ */
+struct FresnelSeriesCoefficients {
+  static constexpr int N = 12;
+  double c[N]{};
+  double s[N]{};
+
+  constexpr FresnelSeriesCoefficients() {
+    double fact_c = 1.0;
+    double fact_s = 1.0;
+    for (int k = 0; k < N; ++k) {
+      if (k > 0) {
+        fact_c *= (2.0 * k) * (2.0 * k - 1.0);
+        fact_s *= (2.0 * k + 1.0) * (2.0 * k);
+      }
+      c[k] = 1.0 / (fact_c * (4.0 * k + 1.0));
+      s[k] = 1.0 / (fact_s * (4.0 * k + 3.0));
+    }
+  }
+};
+
+constexpr FresnelSeriesCoefficients fresnel_series;
+
+/**
+ * Number of terms of the asymptotic expansions of f and g for x >= 6.
+ *
+ * With t = -1/(pi*x^2)^2, the 9th term is below 1e-16 for x >= 6.
+ */
+constexpr int FRESNEL_ASYMPTOTIC_TERMS = 8;
+
+}  // anonymous namespace
+
+namespace {
+
+/**
+ * Compute the standard Fresnel integrals for x >= 0 with a fixed number of
+ * terms in each range, given sin_u and cos_u of u = (pi/2)*x^2, which are
+ * only used for x >= 1.
+ *
+ * There are no data-dependent loops, so all arguments in the same range take
+ * the same path, and sin_u and cos_u can be shared with the moments.
+ */
+inline void calc_std_fresnel_integral_fixed(
+    double x, double sin_u, double cos_u, double& int_c, double& int_s) {
+  if (x < 1.0) {
+    // Power series.
+    const double u = M_PI_2 * (x * x);
+    const double t = -u * u;
+    double sum_c = fresnel_series.c[FresnelSeriesCoefficients::N - 1];
+    double sum_s = fresnel_series.s[FresnelSeriesCoefficients::N - 1];
+    for (int k = FresnelSeriesCoefficients::N - 2; k >= 0; --k) {
+      sum_c = fresnel_series.c[k] + t * sum_c;
+      sum_s = fresnel_series.s[k] + t * sum_s;
+    }
+    int_c = x * sum_c;
+    int_s = u * x * sum_s;
+    return;
+  }
+
+  double f, g;
+  if (x < 6.0) {
+    // Rational approximation of f and g.
+    double fn_sum = 0.0;
+    double fd_sum = fd[11];
+    double gn_sum = 0.0;
+    double gd_sum = gd[11];
+    for (int k = 10; k >= 0; --k) {
+      fn_sum = fn[k] + x * fn_sum;
+      fd_sum = fd[k] + x * fd_sum;
+      gn_sum = gn[k] + x * gn_sum;
+      gd_sum = gd[k] + x * gd_sum;
+    }
+    f = fn_sum / fd_sum;
+    g = gn_sum / gd_sum;
+  } else {
+    // Asymptotic expansion of f and g.
+    const double p = M_PI * (x * x);
+    const double t = -1.0 / (p * p);
+    double series_f = 1.0;
+    double series_g = 1.0;
+    for (int k = FRESNEL_ASYMPTOTIC_TERMS; k >= 1; --k) {
+      const double m = 4.0 * k - 1.0;
+      series_f = 1.0 + m * (m - 2.0) * t * series_f;
+      series_g = 1.0 + m * (m + 2.0) * t * series_g;
+    }
+    f = series_f / (M_PI * x);
+    g = series_g / (p * M_PI * x);
+  }
+  int_c = 0.5 + f * sin_u - g * cos_u;
+  int_s = 0.5 - f * cos_u - g * sin_u;
+}
+
+}  // anonymous namespace
+
+void calc_std_fresnel_integral(size_t n, const double* y, double* int_c, double* int_s) {
+  for (size_t i = 0; i < n; ++i) {
+    const double x = std::abs(y[i]);
+    double sin_u = 0.0;
+    double cos_u = 0.0;
+    if (x >= 1.0) {
+      const double u = M_PI_2 * (x * x);
+      sin_u = sin(u);
+      cos_u = cos(u);
+    }
+    double c, s;
+    calc_std_fresnel_integral_fixed(x, sin_u, cos_u, c, s);
+    const double sign = y[i] < 0 ? -1.0 : 1.0;
+    int_c[i] = sign * c;
+    int_s[i] = sign * s;
+  }
+}
+
 /**
  * Compute moments of Fresnel integrals:
  *   c_k(t) = \int_0^t s^k * cos( (pi/2)*s^2 ) ds
@@ -329,7 +452,7 @@ double calc_lommel_term(double mu, double nu, double b) {
     // After the modification, alpha(1,mu,nu) above makes sense.
     tmp *= (-b / (2 * n + mu - nu - 1)) * (b / (2 * n + mu + nu - 1));
     res += tmp;
-    if (std::abs(tmp) < std::abs(res) * 1e-50) {
+    if (std::abs(tmp) < std::abs(res) * 1e-17) {
       break;
     }
   }
@@ -348,10 +471,7 @@ double calc_lommel_term(double mu, double nu, double b) {
  * \param x_k: Array of cosine moments [x_0,x_1,...,x_{n_k-1}]
  * \param y_k: Array of sine moments [y_0,y_1,...,y_{n_k-1}]
  */
-static void calc_integral_moments_a_zero(int n_k,
-                                         double b,
-                                         std::vector<double>& x_k,
-                                         std::vector<double>& y_k) {
+static void calc_integral_moments_a_zero(int n_k, double b, double x_k[], double y_k[]) {
   double sin_b = sin(b);
   double cos_b = cos(b);
   double b_sq = b * b;
@@ -409,7 +529,7 @@ static void calc_integral_moments_a_small(
   CLOTHOID_ASSERT(p < 11 && p > 0, "In evalXYaSmall p = " << p << " must be in [1,10]");
   // x_k(0,b) and y_k(0,b) must be evaluated up to k=(4*p+2+n_k), see Eqs. 23 and 24.
   int nk0 = 4 * p + 2 + n_k;
-  std::vector<double> x0(nk0), y0(nk0);
+  double x0[4 * 10 + 2 + 3], y0[4 * 10 + 2 + 3];
   calc_integral_moments_a_zero(nk0, b, x0, y0);
 
   // Compute n=0 terms.
@@ -473,6 +593,99 @@ void calc_gen_fresnel_integral_moments(
   }
 }
 
+/**
+ * Compute the first three moments of Fresnel integrals for n arguments at
+ * once, see calc_gen_fresnel_integral_moments above.
+ *
+ * Instead of c, its cosine and sine are given, since c does not change during
+ * the Newton iterations. Arguments with large a use the fixed-term standard
+ * Fresnel integrals, which share sin and cos with the standard moments.
+ * Arguments with small a use the scalar series.
+ *
+ * \param n: Number of arguments.
+ * \param a: Array of n values for a.
+ * \param b: Array of n values for b.
+ * \param cos_c: Array of n values for cos(c).
+ * \param sin_c: Array of n values for sin(c).
+ * \param x_k: Array of n Fresnel cosine moments [x_0,x_1,x_2].
+ * \param y_k: Array of n Fresnel sine moments [y_0,y_1,y_2].
+ */
+static void calc_gen_fresnel_integral_moments(size_t n,
+                                              const double* a,
+                                              const double* b,
+                                              const double* cos_c,
+                                              const double* sin_c,
+                                              std::array<double, 3>* x_k,
+                                              std::array<double, 3>* y_k) {
+  const double a_thresh = 0.01;
+  const int n_terms = 3;
+
+  // Evaluate the standard Fresnel moments c_k(t) and s_k(t) for k < 3, see
+  // calc_std_fresnel_integral_moments.
+  auto std_moments = [](double t, double C[3], double S[3]) {
+    const double tt = M_PI_2 * (t * t);
+    const double ss = sin(tt);
+    const double cc = cos(tt);
+    calc_std_fresnel_integral_fixed(std::abs(t), ss, cc, C[0], S[0]);
+    if (t < 0) {
+      C[0] = -C[0];
+      S[0] = -S[0];
+    }
+    C[1] = ss * M_1_PI;
+    S[1] = (1 - cc) * M_1_PI;
+    C[2] = (t * ss - S[0]) * M_1_PI;
+    S[2] = (C[0] - t * cc) * M_1_PI;
+  };
+
+  for (size_t i = 0; i < n; ++i) {
+    if (std::abs(a[i]) < a_thresh) {
+      calc_integral_moments_a_small(3, a[i], b[i], n_terms, x_k[i].data(), y_k[i].data());
+    } else {
+      // See calc_integral_moments_a_large.
+      const double s = a[i] > 0 ? +1 : -1;
+      const double abs_a = std::abs(a[i]);
+      const double z = ONE_SQRTPI * sqrt(abs_a);
+      const double l = s * b[i] * ONE_SQRTPI / sqrt(abs_a);
+      const double gam = -0.5 * s * (b[i] * b[i]) / abs_a;
+      double cg = cos(gam) / z;
+      double sg = sin(gam) / z;
+
+      double Cl[3], Sl[3], Cz[3], Sz[3];
+      std_moments(l, Cl, Sl);
+      std_moments(l + z, Cz, Sz);
+
+      const double dC0 = Cz[0] - Cl[0];
+      const double dS0 = Sz[0] - Sl[0];
+      x_k[i][0] = cg * dC0 - s * sg * dS0;
+      y_k[i][0] = sg * dC0 + s * cg * dS0;
+      cg /= z;
+      sg /= z;
+      const double dC1 = Cz[1] - Cl[1];
+      const double dS1 = Sz[1] - Sl[1];
+      double DC = dC1 - l * dC0;
+      double DS = dS1 - l * dS0;
+      x_k[i][1] = cg * DC - s * sg * DS;
+      y_k[i][1] = sg * DC + s * cg * DS;
+      const double dC2 = Cz[2] - Cl[2];
+      const double dS2 = Sz[2] - Sl[2];
+      DC = dC2 + l * (l * dC0 - 2 * dC1);
+      DS = dS2 + l * (l * dS0 - 2 * dS1);
+      cg = cg / z;
+      sg = sg / z;
+      x_k[i][2] = cg * DC - s * sg * DS;
+      y_k[i][2] = sg * DC + s * cg * DS;
+    }
+
+    // Evaluate x_k(a,b,c) and y_k(a,b,c).
+    for (int k = 0; k < 3; ++k) {
+      const double xx = x_k[i][k];
+      const double yy = y_k[i][k];
+      x_k[i][k] = xx * cos_c[i] - yy * sin_c[i];
+      y_k[i][k] = xx * sin_c[i] + yy * cos_c[i];
+    }
+  }
+}
+
 /**
  * Normalize angle to range [-M_PI, M_PI].
  *
@@ -584,4 +797,78 @@ void calc_clothoid(double x0,
   dk = 2 * a / l / l;
 }
 
+void calc_clothoid(ClothoidBatch& batch) {
+  const size_t n = batch.size();
+  batch.k.resize(n);
+  batch.dk.resize(n);
+  batch.l.resize(n);
+
+  std::vector<double> r(n), delta(n), cos_phi0(n), sin_phi0(n), a(n);
+  for (size_t i = 0; i < n; ++i) {
+    const double dx = batch.x1[i] - batch.x0[i];
+    const double dy = batch.y1[i] - batch.y0[i];
+    const double phi = atan2(dy, dx);
+    const double phi0 = normalize_abs_pi(batch.theta0[i] - phi);
+    const double phi1 = normalize_abs_pi(batch.theta1[i] - phi);
+    r[i] = hypot(dx, dy);
+    delta[i] = phi1 - phi0;
+    cos_phi0[i] = cos(phi0);
+    sin_phi0[i] = sin(phi0);
+    a[i] = calc_initial_guess(phi0, phi1);
+  }
+
+  // Newton solver, see find_root. All problems that have not converged yet
+  // are iterated in lockstep; converged problems drop out early.
+  const int niter_max = 10;
+  const double tol = 1e-12;
+  std::vector<size_t> active(n);
+  for (size_t i = 0; i < n; ++i) {
+    active[i] = i;
+  }
+  std::vector<double> aa(n), bb(n), cc(n), sc(n);
+  std::vector<std::array<double, 3>> x_k(n), y_k(n);
+  for (int niter = 1; !active.empty(); ++niter) {
+    const size_t m = active.size();
+    for (size_t j = 0; j < m; ++j) {
+      size_t i = active[j];
+      aa[j] = 2 * a[i];
+      bb[j] = delta[i] - a[i];
+      cc[j] = cos_phi0[i];
+      sc[j] = sin_phi0[i];
+    }
+    calc_gen_fresnel_integral_moments(m, aa.data(), bb.data(), cc.data(), sc.data(), x_k.data(),
+                                      y_k.data());
+
+    size_t remaining = 0;
+    for (size_t j = 0; j < m; ++j) {
+      size_t i = active[j];
+      double g = y_k[j][0];
+      double dg = x_k[j][2] - x_k[j][1];
+      a[i] -= g / dg;
+      CLOTHOID_ASSERT(niter <= niter_max,
+                      "Newton do not converge, g = " << g << " niter = " << niter);
+      if (std::abs(g) > tol) {
+        active[remaining++] = i;
+      }
+    }
+    active.resize(remaining);
+  }
+
+  // Compute clothoid parameters for the final root results, see
+  // calc_clothoid_length.
+  for (size_t i = 0; i < n; ++i) {
+    aa[i] = 2 * a[i];
+    bb[i] = delta[i] - a[i];
+  }
+  calc_gen_fresnel_integral_moments(n, aa.data(), bb.data(), cos_phi0.data(), sin_phi0.data(),
+                                    x_k.data(), y_k.data());
+  for (size_t i = 0; i < n; ++i) {
+    double l = r[i] / x_k[i][0];
+    CLOTHOID_ASSERT(l > 0, "Negative length l = " << l);
+    batch.l[i] = l;
+    batch.k[i] = (delta[i] - a[i]) / l;
+    batch.dk[i] = 2 * a[i] / l / l;
+  }
+}
+
 }  // namespace g1_fit
@@ -49,6 +49,12 @@
  *
  */
 
+#pragma once
+
+#include <cstddef>           // for size_t
+#include <initializer_list>  // for initializer_list<>
+#include <vector>            // for vector<>
+
 namespace g1_fit {
 
 /**
@@ -100,4 +106,73 @@ void calc_clothoid(double x0,
  */
 void calc_std_fresnel_integral(double y, double& int_c, double& int_s);
 
+/**
+ * Compute standard Fresnel integrals for n arguments at once.
+ *
+ * In contrast to the scalar version, every argument is evaluated with a fixed
+ * number of terms in each range, so there are no data-dependent loops and the
+ * compiler can vectorize the evaluation. The results agree with the scalar
+ * version to about machine precision.
+ *
+ * \param n: Number of arguments.
+ * \param y: Array of n arguments.
+ * \param int_c: Array of n Fresnel cosine integrals.
+ * \param int_s: Array of n Fresnel sine integrals.
+ */
+void calc_std_fresnel_integral(size_t n, const double* y, double* int_c, double* int_s);
+
+/**
+ * ClothoidBatch contains the input and output of several independent clothoid
+ * fitting problems as structure of arrays.
+ *
+ * \see calc_clothoid(ClothoidBatch&)
+ */
+struct ClothoidBatch {
+  // Input:
+  std::vector<double> x0, y0, theta0;
+  std::vector<double> x1, y1, theta1;
+
+  // Output:
+  std::vector<double> k, dk, l;
+
+  [[nodiscard]] size_t size() const { return x0.size(); }
+
+  /**
+   * Add a clothoid fitting problem and return its index.
+   */
+  size_t push_back(double x0_, double y0_, double theta0_, double x1_, double y1_,
+                   double theta1_) {
+    x0.push_back(x0_);
+    y0.push_back(y0_);
+    theta0.push_back(theta0_);
+    x1.push_back(x1_);
+    y1.push_back(y1_);
+    theta1.push_back(theta1_);
+    return x0.size() - 1;
+  }
+
+  void reserve(size_t n) {
+    for (auto* v : {&x0, &y0, &theta0, &x1, &y1, &theta1, &k, &dk, &l}) {
+      v->reserve(n);
+    }
+  }
+
+  void clear() {
+    for (auto* v : {&x0, &y0, &theta0, &x1, &y1, &theta1, &k, &dk, &l}) {
+      v->clear();
+    }
+  }
+};
+
+/**
+ * Compute clothoid parameters for all problems in the batch at once.
+ *
+ * The results are the same as calling the scalar calc_clothoid for each
+ * problem, but the Newton iterations run in lockstep over all problems that
+ * have not yet converged, and the Fresnel integrals are evaluated in batches.
+ *
+ * \param batch: Clothoid fitting problems; k, dk, and l are resized and set.
+ */
+void calc_clothoid(ClothoidBatch& batch);
+
 }  // namespace g1_fit
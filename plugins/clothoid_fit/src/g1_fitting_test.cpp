@@ -21,7 +21,8 @@
  */
 
 #include <gtest/gtest.h>
-#include <vector>
+#include <cmath>   // for cos, sin
+#include <vector>  // for vector<>
 
 #include "g1_fitting.hpp"  // for calc_clothoid
 
@@ -43,3 +44,48 @@ TEST(g1_fitting, fresnel_integral) {
     EXPECT_NEAR(int_s, s[i], tol);
   }
 }
+
+TEST(g1_fitting, fresnel_integral_batch) {
+  // The batch version must agree with the scalar version in all ranges.
+  std::vector<double> x;
+  for (double xi = -12.0; xi <= 12.0; xi += 0.01) {
+    x.push_back(xi);
+  }
+  x.insert(x.end(), {0.0, 1.0, 6.0, 1.0 - 1e-12, 6.0 - 1e-12, 100.0});
+  std::vector<double> c(x.size()), s(x.size());
+  calc_std_fresnel_integral(x.size(), x.data(), c.data(), s.data());
+  for (size_t i = 0; i < x.size(); ++i) {
+    double int_c, int_s;
+    calc_std_fresnel_integral(x[i], int_c, int_s);
+    EXPECT_NEAR(c[i], int_c, 1e-14) << "x = " << x[i];
+    EXPECT_NEAR(s[i], int_s, 1e-14) << "x = " << x[i];
+  }
+}
+
+TEST(g1_fitting, clothoid_batch) {
+  // Nearly straight, curved, and strongly curved segments in all directions.
+  ClothoidBatch batch;
+  for (double theta0 : {-1.5, -0.3, -1e-4, 0.0, 1e-3, 0.2, 1.0, 2.5}) {
+    for (double theta1 : {-2.0, -0.4, 0.0, 2e-4, 0.05, 0.7, 1.4}) {
+      for (double phi : {0.0, 0.5, -2.0, 3.0}) {
+        batch.push_back(1.0, -2.0, theta0 + phi, 1.0 + 30.0 * std::cos(phi), -2.0 + 30.0 * std::sin(phi),
+                        theta1 + phi);
+      }
+    }
+  }
+  calc_clothoid(batch);
+  ASSERT_EQ(batch.k.size(), batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    double k, dk, l;
+    calc_clothoid(batch.x0[i], batch.y0[i], batch.theta0[i], batch.x1[i], batch.y1[i],
+                  batch.theta1[i], k, dk, l);
+    EXPECT_NEAR(batch.k[i], k, 1e-10);
+    EXPECT_NEAR(batch.dk[i], dk, 1e-10);
+    EXPECT_NEAR(batch.l[i], l, 1e-8);
+  }
+
+  // An empty batch is fine.
+  ClothoidBatch empty;
+  calc_clothoid(empty);
+  EXPECT_EQ(empty.l.size(), 0);
+}
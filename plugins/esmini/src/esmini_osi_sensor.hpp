@@ -52,6 +52,7 @@ class ESMiniOsiReceiver : public cloe::utility::OsiTransceiver {
     if (update_static_ground_truth_) {
       ierr += SE_UpdateOSIStaticGroundTruth();
       update_static_ground_truth_ = false;
+      ++static_ground_truth_revision_;
     }
     // Do not add the driver model's ghost vehicle to the object list.
     ierr += SE_UpdateOSIDynamicGroundTruth(/*reportGhost=*/false);
@@ -76,9 +77,23 @@ class ESMiniOsiReceiver : public cloe::utility::OsiTransceiver {
   }
 
   /**
-   * Fetch sensor model output from ESMini, if applicable.
+   * Fetch a copy of the sensor model output from ESMini, if applicable.
    */
   void receive_osi_msgs(std::vector<std::shared_ptr<osi3::SensorData>>& msgs) override {
+    receive_copies(msgs);
+  }
+
+  /**
+   * Fetch a copy of the ground truth from ESMini, if applicable.
+   */
+  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::GroundTruth>>& msgs) override {
+    receive_copies(msgs);
+  }
+
+  /**
+   * Fetch sensor model output from ESMini, if applicable, without copying it.
+   */
+  void receive_osi_msgs(std::vector<std::shared_ptr<const osi3::SensorData>>& msgs) override {
     if (!msgs.empty()) {
       esmini_logger()->warn(
           "ESMiniOsiReceiver: Non-zero length of message vector before retrieval: {}", msgs.size());
@@ -88,28 +103,35 @@ class ESMiniOsiReceiver : public cloe::utility::OsiTransceiver {
       if (!sd->has_timestamp()) {
         throw cloe::ModelError("ESMiniOsiSensor: No timestamp in SensorData.");
       }
-      msgs.push_back(std::make_shared<osi3::SensorData>(*sd));
+      msgs.push_back(borrow(sd));
     }
   }
 
   /**
-   * Fetch ground truth from ESMini, if applicable.
+   * Fetch ground truth from ESMini, if applicable, without copying it.
    */
-  void receive_osi_msgs(std::vector<std::shared_ptr<osi3::GroundTruth>>& msgs) override {
+  void receive_osi_msgs(std::vector<std::shared_ptr<const osi3::GroundTruth>>& msgs) override {
     if (!msgs.empty()) {
       esmini_logger()->warn(
           "ESMiniOsiReceiver: Non-zero length of message vector before retrieval: {}", msgs.size());
     }
     if (this->has_ground_truth()) {
-      // NOTE: Make a copy because we are going to change it.
-      auto gt = *reinterpret_cast<const osi3::GroundTruth*>(SE_GetOSIGroundTruthRaw());
-      if (!gt.has_timestamp()) {
+      const auto* gt = reinterpret_cast<const osi3::GroundTruth*>(SE_GetOSIGroundTruthRaw());
+      if (!gt->has_timestamp()) {
         throw cloe::ModelError("ESMiniOsiSensor: No timestamp in GroundTruth.");
       }
-      msgs.push_back(std::make_shared<osi3::GroundTruth>(std::move(gt)));
+      msgs.push_back(borrow(gt));
     }
   }
 
+  using cloe::utility::OsiTransceiver::receive_osi_msgs;
+
+  /**
+   * Return the number of times that the static ground truth has been updated
+   * in ESMini, which allows OsiMsgHandler to cache the lane boundaries.
+   */
+  uint64_t static_ground_truth_revision() const override { return static_ground_truth_revision_; }
+
   void clear_cache() override {
     // In ESMini v2.20.10, the SE_ClearOSIGroundTruth() was found
     // to vanish the gt->lane_boundary_ list (gt->lane_boundary_size()==0 after
@@ -121,11 +143,38 @@ class ESMiniOsiReceiver : public cloe::utility::OsiTransceiver {
   void to_json(cloe::Json& j) const override {
     j = cloe::Json{
         {"has_sensor_data", has_sensor_data()},
+        {"static_ground_truth_revision", static_ground_truth_revision_},
     };
   }
 
+ private:
+  /**
+   * Return a non-owning pointer to a message that is owned by ESMini.
+   *
+   * This avoids copying the complete message every step. The message is only
+   * valid until the next update of the ground truth in ESMini, i.e. for the
+   * current step, which is how OsiMsgHandler uses it.
+   */
+  template <typename T>
+  static std::shared_ptr<const T> borrow(const T* msg) {
+    return std::shared_ptr<const T>(std::shared_ptr<const T>{}, msg);
+  }
+
+  /**
+   * Receive the messages owned by ESMini as copies that may be modified.
+   */
+  template <typename T>
+  void receive_copies(std::vector<std::shared_ptr<T>>& msgs) {
+    std::vector<std::shared_ptr<const T>> borrowed;
+    receive_osi_msgs(borrowed);
+    for (const auto& m : borrowed) {
+      msgs.push_back(std::make_shared<T>(*m));
+    }
+  }
+
  private:
   mutable bool update_static_ground_truth_{true};
+  mutable uint64_t static_ground_truth_revision_{0};
 };
 
 /**
@@ -46,17 +46,15 @@ class LaneBoundaryFrustumCulling : public LaneBoundarySensor {
 
   virtual ~LaneBoundaryFrustumCulling() noexcept = default;
 
+  /**
+   * Return the lane boundaries of the underlying sensor.
+   *
+   * Culling is not implemented for lane boundaries yet, so they are
+   * forwarded by reference instead of being copied every step.
+   */
   const LaneBoundaries& sensed_lane_boundaries() const override {
-    if (cached_) {
-      return lbs_;
-    }
-    for (const auto& kv : sensor_->sensed_lane_boundaries()) {
-      auto lb = kv.second;
-      auto lb_mod = apply_frustum_culling(lb);
-      lbs_.insert(std::pair<int, LaneBoundary>(kv.first, lb_mod));
-    }
-    cached_ = true;
-    return lbs_;
+    // TODO(tobias): transform coordinate system and check if inside frustum
+    return sensor_->sensed_lane_boundaries();
   }
 
   const Frustum& frustum() const override { return config_.frustum; }
@@ -64,12 +62,7 @@ class LaneBoundaryFrustumCulling : public LaneBoundarySensor {
   const Eigen::Isometry3d& mount_pose() const override { return config_.ref_frame.pose; }
 
   /**
-   * Process the underlying sensor and clear the cache.
-   *
-   * We could process and create the filtered list of lane boundaries now, but we can
-   * also delay it (lazy computation) and only do it when absolutely necessary.
-   * This comes at the minor cost of checking whether cached_ is true every
-   * time sensed_lane_boundaries() is called.
+   * Process the underlying sensor.
    */
   Duration process(const Sync& sync) override {
     // This currently shouldn't do anything, but this class acts as a prototype
@@ -79,16 +72,13 @@ class LaneBoundaryFrustumCulling : public LaneBoundarySensor {
       return t;
     }
 
-    // Process the underlying sensor and clear the cache.
-    t = sensor_->process(sync);
-    clear_cache();
-    return t;
+    // Process the underlying sensor.
+    return sensor_->process(sync);
   }
 
   void reset() override {
     LaneBoundarySensor::reset();
     sensor_->reset();
-    clear_cache();
   }
 
   void abort() override {
@@ -101,23 +91,9 @@ class LaneBoundaryFrustumCulling : public LaneBoundarySensor {
         &config_, "config", "configure lane sensor culling component"));
   }
 
- protected:
-  LaneBoundary apply_frustum_culling(const LaneBoundary& lb) const {
-    LaneBoundary lb_m = lb;
-    // TODO(tobias): transform coordinate system and check if inside frustum
-    return lb_m;
-  }
-
-  void clear_cache() {
-    lbs_.clear();
-    cached_ = false;
-  }
-
  private:
   FrustumCullingConf config_;
   std::shared_ptr<LaneBoundarySensor> sensor_;
-  mutable bool cached_;
-  mutable LaneBoundaries lbs_;
 };
 
 DEFINE_COMPONENT_FACTORY(
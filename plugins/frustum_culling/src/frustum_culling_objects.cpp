@@ -23,17 +23,19 @@
 #include <memory>          // for shared_ptr<>
 #include <random>          // for random_device
 #include <string>          // for string
+#include <vector>          // for vector<>
 
 #include <cloe/component.hpp>                // for Component, Json
 #include <cloe/component/frustum.hpp>        // for Frustum
 #include <cloe/component/object.hpp>         // for Object
+#include <cloe/component/object_batch.hpp>   // for ObjectBatch
 #include <cloe/component/object_sensor.hpp>  // for ObjectSensor
 #include <cloe/conf/action.hpp>              // for actions::ConfigureFactory
 #include <cloe/plugin.hpp>                   // for EXPORT_CLOE_PLUGIN
 #include <cloe/registrar.hpp>                // for Registrar
 #include <cloe/sync.hpp>                     // for Sync
 #include <cloe/trigger/set_action.hpp>       // for actions::SetVariableActionFactory
-#include <cloe/utility/frustum_culling.hpp>  // for Point, is_point_inside_frustum
+#include <cloe/utility/frustum_culling.hpp>  // for CompiledFrustum
 #include "frustum_culling_conf.hpp"          // for FrustumCullingConf
 
 namespace cloe::frustum_culling_plugin {
@@ -59,16 +61,13 @@ class ObjectFrustumCulling : public ObjectSensor {
     if (cached_) {
       return objects_;
     }
-    for (const auto& o : sensor_->sensed_objects()) {
-      auto obj = apply_frustum_culling(o);
-
-      bool is_object_inside =
-          cloe::utility::is_point_inside_frustum(config_.frustum, obj->pose.translation());
-
-      if (is_object_inside) {
-        objects_.push_back(obj);
-      }
+    // The frustum may be changed by the configure action at any time.
+    if (!compiled_frustum_.compiled_from(config_.frustum)) {
+      compiled_frustum_ = utility::CompiledFrustum(config_.frustum);
     }
+    batch_.assign(sensor_->sensed_objects());
+    apply_frustum_culling(batch_);
+    batch_.to_objects(objects_, [this]() { return make_step_shared<Object>(); });
     cached_ = true;
     return objects_;
   }
@@ -116,18 +115,18 @@ class ObjectFrustumCulling : public ObjectSensor {
   }
 
  protected:
-  std::shared_ptr<Object> apply_frustum_culling(const std::shared_ptr<Object>& o) const {
-    auto obj = std::make_shared<Object>(*o);
-
+  void apply_frustum_culling(ObjectBatch& batch) const {
     // Assumption:
     // * cog_offset is in detected objects coordinate system
     // * dimensions is in absolute values and not provided as a vector
     // * the coordinate systems do not have any relative velocity/acceleration/angular velocity, both have same velocity/acceleration/angular velocity
-    obj->pose = this->mount_pose().inverse() * obj->pose;
-    obj->velocity = this->mount_pose().inverse().rotation() * obj->velocity;
-    obj->acceleration = this->mount_pose().inverse().rotation() * obj->acceleration;
-    obj->angular_velocity = this->mount_pose().inverse().rotation() * obj->angular_velocity;
-    return obj;
+    batch.transform(this->mount_pose().inverse());
+
+    auto pos = batch.positions();
+    indices_.resize(batch.size());
+    auto n = compiled_frustum_.select(pos.col(0).data(), pos.col(1).data(), pos.col(2).data(),
+                                      batch.size(), indices_.data());
+    batch.keep(indices_.data(), n);
   }
 
   void clear_cache() {
@@ -140,6 +139,9 @@ class ObjectFrustumCulling : public ObjectSensor {
   std::shared_ptr<ObjectSensor> sensor_;
   mutable bool cached_;
   mutable Objects objects_;
+  mutable utility::CompiledFrustum compiled_frustum_;
+  mutable ObjectBatch batch_;
+  mutable std::vector<size_t> indices_;
 };
 
 DEFINE_COMPONENT_FACTORY(ObjectFrustumCullingFactory, FrustumCullingConf, "frustum_culling_objects",
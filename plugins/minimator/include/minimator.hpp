@@ -16,6 +16,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#pragma once
+
+#include <cstdint>  // for uint64_t
+
 #include <cloe/core/fable.hpp>  // for Confable, Schema, ...
 
 namespace minimator {
@@ -72,9 +76,52 @@ struct EgoSensorConfig : public cloe::Confable {
   }
 };
 
+/**
+ * TrafficConfig configures the generation of moving traffic objects.
+ *
+ * Traffic drives on a straight road with num_lanes lanes along the x axis,
+ * laterally centered at the origin. The road is a ring: objects that reach
+ * the end of the road reappear at its start, so the traffic density stays
+ * constant over time. Each object keeps to its lane and has a constant
+ * acceleration, which is reversed whenever its velocity leaves the range
+ * [min_velocity, max_velocity].
+ *
+ * When traffic is enabled, the lane sensor of the vehicle provides the lane
+ * boundaries of this road.
+ */
+struct TrafficConfig : public cloe::Confable {
+  bool enabled{false};
+  uint64_t seed{1};
+  int num_lanes{3};
+  double lane_width{4.0};
+  double road_length{1000.0};
+  double density{20.0};
+  double min_velocity{20.0};
+  double max_velocity{40.0};
+  double max_acceleration{1.0};
+
+ public:
+  CONFABLE_SCHEMA(TrafficConfig) {
+    // clang-format off
+    return cloe::Schema{
+        {"enable", cloe::Schema(&enabled, "Generate moving traffic objects")},
+        {"seed", cloe::Schema(&seed, "Seed for the initial traffic state")},
+        {"num_lanes", cloe::make_schema(&num_lanes, "Number of lanes of the road").minimum(1)},
+        {"lane_width", cloe::make_schema(&lane_width, "Width of each lane [m]").minimum(0.0)},
+        {"road_length", cloe::make_schema(&road_length, "Length of the ring road [m]").minimum(1.0)},
+        {"density", cloe::make_schema(&density, "Number of objects per km and lane").minimum(0.0)},
+        {"min_velocity", cloe::make_schema(&min_velocity, "Minimum object velocity [m/s]").minimum(0.0)},
+        {"max_velocity", cloe::make_schema(&max_velocity, "Maximum object velocity [m/s]").minimum(0.0)},
+        {"max_acceleration", cloe::make_schema(&max_acceleration, "Maximum absolute acceleration [m/s^2]").minimum(0.0)},
+    };
+    // clang-format on
+  }
+};
+
 struct SensorMockupConfig : public cloe::Confable {
   EgoSensorConfig ego_sensor_mockup;
   ObjectSensorConfig object_sensor_mockup;
+  TrafficConfig traffic;
 
  public:
   CONFABLE_SCHEMA(SensorMockupConfig) {
@@ -82,6 +129,7 @@ struct SensorMockupConfig : public cloe::Confable {
     return cloe::Schema{
         {"ego_sensor_mockup", cloe::Schema(&ego_sensor_mockup, "Ego sensor mockup configuration")},
         {"object_sensor_mockup", cloe::Schema(&object_sensor_mockup, "Object sensor mockup configuration")},
+        {"traffic", cloe::Schema(&traffic, "Moving traffic generator configuration")},
     };
     // clang-format on
   }
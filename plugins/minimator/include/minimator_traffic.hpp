@@ -0,0 +1,142 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file minimator_traffic.hpp
+ * \see  minimator_traffic.cpp
+ * \see  minimator_traffic_test.cpp
+ *
+ * This file defines a kinematic traffic model, which lets minimator serve
+ * as a load source for the sensor and controller pipeline.
+ */
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <functional>  // for function<>
+#include <memory>      // for shared_ptr<>
+
+#include <Eigen/Core>  // for ArrayXd, ArrayXi, Vector3d
+
+#include <cloe/cloe_fwd.hpp>                 // for CheckpointWriter, CheckpointReader
+#include <cloe/component/lane_boundary.hpp>  // for LaneBoundaries
+#include <cloe/component/object.hpp>         // for Object, Objects
+#include <cloe/core.hpp>                     // for Json
+#include <minimator.hpp>                     // for TrafficConfig
+
+namespace minimator {
+
+/**
+ * Return the lateral position of the center of the given lane, where lane 0
+ * is the leftmost lane.
+ */
+inline double lane_center(int lane, int num_lanes, double lane_width) {
+  return (num_lanes - 1) * lane_width / 2.0 - lane_width * lane;
+}
+
+/**
+ * Return the lane boundaries of a straight road along the x axis from 0 to
+ * length, which is laterally centered at the origin.
+ *
+ * Points are placed every point_spacing meters. All coordinates are relative
+ * to origin. The outer lane boundaries are solid, the inner ones dashed.
+ */
+cloe::LaneBoundaries make_road_lane_boundaries(int num_lanes, double lane_width, double length,
+                                               double point_spacing,
+                                               const Eigen::Vector3d& origin);
+
+/**
+ * Traffic is a set of objects that follow the lanes of a straight ring road
+ * with constant acceleration.
+ *
+ * The state is stored as a structure of arrays, so that each step updates all
+ * objects with a few vectorized array expressions.
+ *
+ * \see TrafficConfig
+ */
+class Traffic {
+ public:
+  using MakeObject = std::function<std::shared_ptr<cloe::Object>()>;
+
+  /**
+   * Spawn objects with the density given by the configuration.
+   *
+   * Objects are spaced evenly along each lane with some jitter, and their
+   * initial velocity and acceleration are drawn uniformly from the
+   * configured ranges. The same configuration always results in the same
+   * initial state.
+   */
+  explicit Traffic(const TrafficConfig& c);
+
+  [[nodiscard]] size_t size() const { return static_cast<size_t>(s_.size()); }
+  [[nodiscard]] const TrafficConfig& config() const { return config_; }
+
+  /**
+   * Advance all objects by dt seconds.
+   */
+  void step(double dt);
+
+  /**
+   * Add the objects to the back of out, positioned relative to origin.
+   *
+   * Object ids start at first_id. Each object is created with make, so that
+   * the caller can decide how objects are allocated.
+   */
+  void to_objects(cloe::Objects& out, const Eigen::Vector3d& origin, int first_id,
+                  const MakeObject& make) const;
+
+  /**
+   * Write the object state to a checkpoint.
+   *
+   * The configuration is not part of the checkpoint, so the state can only
+   * be loaded into traffic with the same configuration.
+   */
+  void save_state(cloe::CheckpointWriter& w) const;
+
+  /**
+   * Read the object state from a checkpoint written by save_state.
+   *
+   * Throws CheckpointError if the number of objects does not match.
+   */
+  void load_state(cloe::CheckpointReader& r);
+
+  // Object state:
+  [[nodiscard]] const Eigen::ArrayXi& lanes() const { return lane_; }
+  [[nodiscard]] const Eigen::ArrayXd& positions() const { return s_; }
+  [[nodiscard]] const Eigen::ArrayXd& velocities() const { return v_; }
+  [[nodiscard]] const Eigen::ArrayXd& accelerations() const { return a_; }
+
+  friend void to_json(cloe::Json& j, const Traffic& t) {
+    j = cloe::Json{
+        {"num_objects", t.size()},
+        {"num_steps", t.num_steps_},
+    };
+  }
+
+ private:
+  TrafficConfig config_;
+  uint64_t num_steps_{0};
+
+  Eigen::ArrayXi lane_;  // lane index
+  Eigen::ArrayXd y_;     // lateral position [m]
+  Eigen::ArrayXd s_;     // longitudinal position along the road [m]
+  Eigen::ArrayXd v_;     // velocity [m/s]
+  Eigen::ArrayXd a_;     // acceleration [m/s^2]
+};
+
+}  // namespace minimator
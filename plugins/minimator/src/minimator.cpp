@@ -48,11 +48,15 @@
  * `fable` namespace.
  */
 
+#include <chrono>      // for duration<>
+#include <cstdint>     // for uint64_t
 #include <functional>  // for function<>
-#include <memory>      // for unique_ptr<>
+#include <memory>      // for unique_ptr<>, shared_ptr<>
 #include <string>      // for string
+#include <utility>     // for move
 #include <vector>      // for vector<>
 
+#include <cloe/checkpoint.hpp>                          // for CheckpointWriter, CheckpointReader
 #include <cloe/component/ego_sensor.hpp>                // for NopEgoSensor
 #include <cloe/component/lane_sensor.hpp>               // for LaneBoundarySensor
 #include <cloe/component/latlong_actuator.hpp>          // for LatLongActuator
@@ -67,6 +71,7 @@
 #include <cloe/utility/geometry.hpp>                    // for pose_from_rotation_translation
 #include <cloe/vehicle.hpp>                             // for Vehicle
 #include <minimator.hpp>
+#include <minimator_traffic.hpp>  // for Traffic, make_road_lane_boundaries
 
 namespace minimator {
 
@@ -75,32 +80,25 @@ using Vehicles = std::vector<std::shared_ptr<cloe::Vehicle>>;
 /**
  * MinimatorLaneSensor is a very static lane boundary sensor.
  *
- * It returns the 4 lane boundaries of a 3-lane 4m lane-width road of a total
- * length of 100m. The road is laterally centered at the origin.
+ * By default, it returns the 4 lane boundaries of a 3-lane 4m lane-width road
+ * of a total length of 100m. The road is laterally centered at the origin.
+ *
+ * When traffic is enabled, it returns the lane boundaries of the traffic
+ * road instead, relative to the ego vehicle.
  */
 class MinimatorLaneSensor : public cloe::LaneBoundarySensor {
  public:
-  MinimatorLaneSensor() : cloe::LaneBoundarySensor("minimator_lane_sensor") {
-    const int n = 4;
-    const double w = 4.0;
-    const double l = 100.0;
-    for (int i = 0; i != n; ++i) {
-      cloe::LaneBoundary lb;
-      lb.id = i;
-      lb.prev_id = -1;
-      lb.next_id = -1;
-      lb.dx_start = 0;
-      lb.dy_start = (n - 1) * w / 2.0 - w * i;
-      lb.heading_start = 0.0;
-      lb.curv_hor_start = 0.0;
-      lb.curv_hor_change = 0.0;
-      lb.dx_end = l;
-      lb.type = i % (n - 1) ? cloe::LaneBoundary::Type::Dashed : cloe::LaneBoundary::Type::Solid;
-      lb.color = cloe::LaneBoundary::Color::White;
-      lb.points.push_back(Eigen::Vector3d(lb.dx_start, lb.dy_start, 0));
-      lb.points.push_back(Eigen::Vector3d(lb.dx_end, lb.dy_start, 0));
-      lane_boundaries_[i] = lb;
-    }
+  MinimatorLaneSensor()
+      : MinimatorLaneSensor(
+            make_road_lane_boundaries(3, 4.0, 100.0, 100.0, Eigen::Vector3d::Zero())) {}
+
+  MinimatorLaneSensor(const TrafficConfig& traffic, const Eigen::Vector3d& ego_position)
+      : MinimatorLaneSensor(make_road_lane_boundaries(traffic.num_lanes, traffic.lane_width,
+                                                      traffic.road_length, lane_point_spacing,
+                                                      ego_position)) {}
+
+  explicit MinimatorLaneSensor(cloe::LaneBoundaries lbs)
+      : cloe::LaneBoundarySensor("minimator_lane_sensor"), lane_boundaries_(std::move(lbs)) {
     mount_pose_.setIdentity();
   }
   virtual ~MinimatorLaneSensor() = default;
@@ -121,6 +119,9 @@ class MinimatorLaneSensor : public cloe::LaneBoundarySensor {
   const Eigen::Isometry3d& mount_pose() const override { return mount_pose_; }
 
  private:
+  /// Distance between lane boundary points of the traffic road [m].
+  static constexpr double lane_point_spacing = 10.0;
+
   cloe::LaneBoundaries lane_boundaries_;
   cloe::Frustum frustum_;
   Eigen::Isometry3d mount_pose_;
@@ -135,7 +136,11 @@ class MinimatorLaneSensor : public cloe::LaneBoundarySensor {
 class SimulatorSensorMockup {
  public:
   SimulatorSensorMockup(const uint16_t& id, const SensorMockupConfig& sensor_mockup_config)
-      : vehicle_id(id), sensor_mockup_config_(sensor_mockup_config) {}
+      : vehicle_id(id), sensor_mockup_config_(sensor_mockup_config) {
+    if (sensor_mockup_config_.traffic.enabled) {
+      traffic_ = std::make_shared<Traffic>(sensor_mockup_config_.traffic);
+    }
+  }
 
   void process_ego_vehicles() {
     std::array<double, 3> ori{0.0, 0.0, 0.0};
@@ -189,6 +194,34 @@ class SimulatorSensorMockup {
     process_sensed_objects();
   }
 
+  /**
+   * Advance the traffic, if any, by one step.
+   */
+  void process_traffic(const cloe::Sync& sync) {
+    if (traffic_) {
+      traffic_->step(std::chrono::duration<double>(sync.step_width()).count());
+    }
+  }
+
+  const std::shared_ptr<Traffic>& get_traffic() const { return traffic_; }
+
+  void save_state(cloe::CheckpointWriter& w) const {
+    if (traffic_) {
+      traffic_->save_state(w);
+    }
+  }
+
+  void load_state(cloe::CheckpointReader& r) {
+    if (traffic_) {
+      traffic_->load_state(r);
+    }
+  }
+  const SensorMockupConfig& config() const { return sensor_mockup_config_; }
+  Eigen::Vector3d get_ego_position() const {
+    const auto& pos = sensor_mockup_config_.ego_sensor_mockup.ego_object.position;
+    return Eigen::Vector3d(pos.x, pos.y, pos.z);
+  }
+
   const cloe::Objects& get_world_objects() const { return world_objects_; }
   const cloe::Objects& get_ego_objects() const { return ego_objects_; }
   const cloe::Object& get_object(const cloe::Objects& objects) const {
@@ -217,6 +250,9 @@ class SimulatorSensorMockup {
         {"vehicles", b.ego_objects_},
         {"objects", b.world_objects_},
     };
+    if (b.traffic_) {
+      j["traffic"] = *b.traffic_;
+    }
   }
 
  private:
@@ -224,25 +260,64 @@ class SimulatorSensorMockup {
   cloe::Objects world_objects_;
   cloe::Objects ego_objects_;
   SensorMockupConfig sensor_mockup_config_;
+  std::shared_ptr<Traffic> traffic_;
 };
 
+/**
+ * MinimatorObjectSensor returns the configured static objects and, if traffic
+ * is enabled, the traffic objects relative to the ego vehicle.
+ */
 class MinimatorObjectSensor : public cloe::ObjectSensor {
  public:
-  MinimatorObjectSensor(cloe::Objects world_objects)
-      : cloe::ObjectSensor("minimator_object_sensor"), world_objects_(std::move(world_objects)) {
+  /// Traffic object ids start here, to keep them apart from vehicle ids.
+  static constexpr int traffic_first_id = 1000;
+
+  MinimatorObjectSensor(cloe::Objects world_objects, std::shared_ptr<const Traffic> traffic = {},
+                        const Eigen::Vector3d& ego_position = Eigen::Vector3d::Zero())
+      : cloe::ObjectSensor("minimator_object_sensor")
+      , world_objects_(std::move(world_objects))
+      , traffic_(std::move(traffic))
+      , ego_position_(ego_position) {
     mount_pose_.setIdentity();
   }
 
-  const cloe::Objects& sensed_objects() const override { return world_objects_; }
+  const cloe::Objects& sensed_objects() const override {
+    if (!traffic_) {
+      return world_objects_;
+    }
+    if (!cached_) {
+      objects_ = world_objects_;
+      traffic_->to_objects(objects_, ego_position_, traffic_first_id,
+                           [this]() { return make_step_shared<cloe::Object>(); });
+      cached_ = true;
+    }
+    return objects_;
+  }
 
   const cloe::Frustum& frustum() const override { return frustum_; }
 
   const Eigen::Isometry3d& mount_pose() const override { return mount_pose_; }
 
+  cloe::Duration process(const cloe::Sync& sync) override {
+    objects_.clear();
+    cached_ = false;
+    return cloe::ObjectSensor::process(sync);
+  }
+
+  void reset() override {
+    cloe::ObjectSensor::reset();
+    objects_.clear();
+    cached_ = false;
+  }
+
  private:
   cloe::Frustum frustum_;
   Eigen::Isometry3d mount_pose_;
   cloe::Objects world_objects_;
+  std::shared_ptr<const Traffic> traffic_;
+  Eigen::Vector3d ego_position_;
+  mutable bool cached_{false};
+  mutable cloe::Objects objects_;
 };
 
 /**
@@ -338,14 +413,24 @@ class MinimatorVehicle : public cloe::Vehicle {
                         cloe::CloeComponent::GROUNDTRUTH_EGO_SENSOR,
                         cloe::CloeComponent::DEFAULT_EGO_SENSOR);
 
-    // Similarly here.
-    this->new_component(new MinimatorObjectSensor(simulator_sensor_mockup_.get_world_objects()),
+    // Similarly here. If the vehicle has traffic, the object and lane sensors
+    // share it with the simulator, which advances it in every step.
+    const auto& traffic = simulator_sensor_mockup_.get_traffic();
+    auto ego_position = simulator_sensor_mockup_.get_ego_position();
+    this->new_component(new MinimatorObjectSensor(simulator_sensor_mockup_.get_world_objects(),
+                                                  traffic, ego_position),
                         cloe::CloeComponent::GROUNDTRUTH_WORLD_SENSOR,
                         cloe::CloeComponent::DEFAULT_WORLD_SENSOR);
 
-    this->new_component(new MinimatorLaneSensor(),
-                        cloe::CloeComponent::GROUNDTRUTH_LANE_SENSOR,
-                        cloe::CloeComponent::DEFAULT_LANE_SENSOR);
+    if (traffic) {
+      this->new_component(new MinimatorLaneSensor(traffic->config(), ego_position),
+                          cloe::CloeComponent::GROUNDTRUTH_LANE_SENSOR,
+                          cloe::CloeComponent::DEFAULT_LANE_SENSOR);
+    } else {
+      this->new_component(new MinimatorLaneSensor(),
+                          cloe::CloeComponent::GROUNDTRUTH_LANE_SENSOR,
+                          cloe::CloeComponent::DEFAULT_LANE_SENSOR);
+    }
 
     // The `LatLongActuator` component isn't exactly a dummy component, but we
     // won't be reading from it, so writing to it won't do much good.
@@ -463,6 +548,7 @@ class MinimatorSimulator : public cloe::Simulator {
 
     // Empty the list of vehicles.
     vehicles.clear();
+    vehicles_data.clear();
 
     // Also call superclass method.
     Simulator::disconnect();
@@ -607,14 +693,43 @@ class MinimatorSimulator : public cloe::Simulator {
     // Fetch new data and save it in vehicle list.
     for (auto& d : vehicles_data) {
       d.process();
-      // Note: Our simulator here doesn't really do anything at all, so we can keep
-      // running forever.
-      // Here there would be the logic to set the vehicle data that is read in this process() call.
+      // Note: Our simulator here doesn't really do much at all, so we can keep
+      // running forever. The only moving parts are the traffic objects, which
+      // are advanced in a single batch per vehicle.
+      d.process_traffic(sync);
     }
 
     return sync.time();
   }
 
+  /**
+   * Minimator supports checkpoints, since the traffic objects are its only
+   * state that changes during the simulation.
+   *
+   * \see Model::save_state
+   */
+  bool is_checkpointable() const final { return true; }
+
+  void save_state(cloe::CheckpointWriter& w) const final {
+    w.write(operational_);
+    w.write<uint64_t>(vehicles_data.size());
+    for (const auto& d : vehicles_data) {
+      d.save_state(w);
+    }
+  }
+
+  void load_state(cloe::CheckpointReader& r) final {
+    r.read(operational_);
+    auto n = r.read<uint64_t>();
+    if (n != vehicles_data.size()) {
+      throw cloe::CheckpointError("minimator: checkpoint has {} vehicles, expected {}", n,
+                                  vehicles_data.size());
+    }
+    for (auto& d : vehicles_data) {
+      d.load_state(r);
+    }
+  }
+
   /**
    * Serialize MinimatorSimulator into JSON.
    *
@@ -79,6 +79,25 @@ TEST(minimator, deserialize_ego_sensor_config) {
     })");
 }
 
+TEST(minimator, deserialize_traffic_config) {
+  TrafficConfig traffic_conf;
+
+  fable::assert_validate(traffic_conf, R"({
+        "enable": true,
+        "seed": 42,
+        "num_lanes": 4,
+        "lane_width": 3.5,
+        "road_length": 2000.0,
+        "density": 30.0,
+        "min_velocity": 15.0,
+        "max_velocity": 35.0,
+        "max_acceleration": 2.0
+    })");
+  fable::assert_invalidate(traffic_conf, R"({
+        "num_lanes": 0
+    })");
+}
+
 TEST(minimator, deserialize_sensor_mockup_config) {
   SensorMockupConfig sensor_mockup_conf;
 
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file minimator_traffic.cpp
+ * \see  minimator_traffic.hpp
+ */
+
+#include <minimator_traffic.hpp>
+
+#include <algorithm>  // for min, max
+#include <cmath>      // for ceil, round
+#include <random>     // for mt19937_64, uniform_real_distribution<>
+#include <utility>    // for move
+
+#include <Eigen/Geometry>  // for Isometry3d
+
+#include <cloe/checkpoint.hpp>  // for CheckpointWriter, CheckpointReader, CheckpointError
+#include <cloe/model.hpp>       // for ModelError
+
+namespace minimator {
+
+cloe::LaneBoundaries make_road_lane_boundaries(int num_lanes, double lane_width, double length,
+                                               double point_spacing,
+                                               const Eigen::Vector3d& origin) {
+  const int n = num_lanes + 1;
+  const int num_points = std::max(2, static_cast<int>(std::ceil(length / point_spacing)) + 1);
+  cloe::LaneBoundaries lbs;
+  for (int i = 0; i != n; ++i) {
+    cloe::LaneBoundary lb;
+    lb.id = i;
+    lb.prev_id = -1;
+    lb.next_id = -1;
+    lb.dx_start = -origin.x();
+    lb.dy_start = (n - 1) * lane_width / 2.0 - lane_width * i - origin.y();
+    lb.heading_start = 0.0;
+    lb.curv_hor_start = 0.0;
+    lb.curv_hor_change = 0.0;
+    lb.dx_end = length - origin.x();
+    lb.type = i % (n - 1) ? cloe::LaneBoundary::Type::Dashed : cloe::LaneBoundary::Type::Solid;
+    lb.color = cloe::LaneBoundary::Color::White;
+    auto& points = lb.points.mutate();
+    points.reserve(num_points);
+    for (int k = 0; k != num_points; ++k) {
+      double x = std::min(k * point_spacing, length) - origin.x();
+      points.emplace_back(x, lb.dy_start, -origin.z());
+    }
+    lbs.emplace_hint(lbs.end(), i, std::move(lb));
+  }
+  return lbs;
+}
+
+Traffic::Traffic(const TrafficConfig& c) : config_(c) {
+  if (c.min_velocity > c.max_velocity) {
+    throw cloe::ModelError("minimator: traffic min_velocity {} greater than max_velocity {}",
+                           c.min_velocity, c.max_velocity);
+  }
+
+  const auto per_lane =
+      static_cast<Eigen::Index>(std::round(c.density * c.road_length / 1000.0));
+  const auto n = per_lane * c.num_lanes;
+  lane_.resize(n);
+  y_.resize(n);
+  s_.resize(n);
+  v_.resize(n);
+  a_.resize(n);
+
+  std::mt19937_64 gen(c.seed);
+  std::uniform_real_distribution<double> jitter(0.0, 0.5);
+  std::uniform_real_distribution<double> velocity(c.min_velocity, c.max_velocity);
+  std::uniform_real_distribution<double> acceleration(-c.max_acceleration, c.max_acceleration);
+  const double spacing = per_lane > 0 ? c.road_length / per_lane : 0.0;
+  Eigen::Index i = 0;
+  for (int lane = 0; lane < c.num_lanes; ++lane) {
+    for (Eigen::Index k = 0; k < per_lane; ++k, ++i) {
+      lane_[i] = lane;
+      y_[i] = lane_center(lane, c.num_lanes, c.lane_width);
+      s_[i] = (k + jitter(gen)) * spacing;
+      v_[i] = velocity(gen);
+      a_[i] = acceleration(gen);
+    }
+  }
+}
+
+void Traffic::step(double dt) {
+  const double length = config_.road_length;
+
+  s_ += v_ * dt + 0.5 * a_ * dt * dt;
+  s_ -= length * (s_ / length).floor();
+  v_ += a_ * dt;
+
+  // Objects that leave the velocity range turn around and accelerate
+  // back into it.
+  a_ = (v_ > config_.max_velocity).select(-a_.abs(), a_);
+  a_ = (v_ < config_.min_velocity).select(a_.abs(), a_);
+  v_ = v_.min(config_.max_velocity).max(config_.min_velocity);
+  num_steps_++;
+}
+
+void Traffic::to_objects(cloe::Objects& out, const Eigen::Vector3d& origin, int first_id,
+                         const MakeObject& make) const {
+  out.reserve(out.size() + size());
+  for (Eigen::Index i = 0; i < s_.size(); ++i) {
+    auto o = make();
+    o->id = first_id + static_cast<int>(i);
+    o->exist_prob = 1.0;
+    o->type = cloe::Object::Type::Dynamic;
+    o->classification = cloe::Object::Class::Car;
+    o->pose.setIdentity();
+    o->pose.translation() = Eigen::Vector3d(s_[i], y_[i], 0.0) - origin;
+    o->dimensions = Eigen::Vector3d(4.5, 1.8, 1.5);
+    o->cog_offset = Eigen::Vector3d::Zero();
+    o->velocity = Eigen::Vector3d(v_[i], 0.0, 0.0);
+    o->acceleration = Eigen::Vector3d(a_[i], 0.0, 0.0);
+    o->angular_velocity = Eigen::Vector3d::Zero();
+    out.emplace_back(std::move(o));
+  }
+}
+
+void Traffic::save_state(cloe::CheckpointWriter& w) const {
+  w.write(num_steps_);
+  w.write_array(lane_.data(), static_cast<size_t>(lane_.size()));
+  w.write_array(y_.data(), static_cast<size_t>(y_.size()));
+  w.write_array(s_.data(), static_cast<size_t>(s_.size()));
+  w.write_array(v_.data(), static_cast<size_t>(v_.size()));
+  w.write_array(a_.data(), static_cast<size_t>(a_.size()));
+}
+
+void Traffic::load_state(cloe::CheckpointReader& r) {
+  auto read_array = [&r, n = size()](auto& xs) {
+    auto m = r.read_array_size();
+    if (m != n) {
+      throw cloe::CheckpointError("minimator: checkpoint has {} traffic objects, expected {}", m,
+                                  n);
+    }
+    r.read_array_data(xs.data(), m);
+  };
+  r.read(num_steps_);
+  read_array(lane_);
+  read_array(y_);
+  read_array(s_);
+  read_array(v_);
+  read_array(a_);
+}
+
+}  // namespace minimator
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file minimator_traffic_test.cpp
+ * \see  minimator_traffic.hpp
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>  // for make_shared
+
+#include <cloe/checkpoint.hpp>  // for CheckpointWriter, CheckpointReader, CheckpointError
+#include <minimator_traffic.hpp>
+
+namespace minimator {
+
+TEST(minimator_traffic, spawn_with_density) {
+  TrafficConfig c;
+  c.enabled = true;
+  c.num_lanes = 3;
+  c.road_length = 2000.0;
+  c.density = 25.0;
+  Traffic t(c);
+  ASSERT_EQ(t.size(), 150);
+
+  // The same configuration results in the same traffic.
+  Traffic u(c);
+  EXPECT_TRUE((t.positions() == u.positions()).all());
+  EXPECT_TRUE((t.velocities() == u.velocities()).all());
+
+  c.seed = 2;
+  Traffic w(c);
+  EXPECT_FALSE((t.velocities() == w.velocities()).all());
+}
+
+TEST(minimator_traffic, step_kinematics) {
+  TrafficConfig c;
+  c.road_length = 500.0;
+  c.density = 40.0;
+  c.min_velocity = 10.0;
+  c.max_velocity = 30.0;
+  c.max_acceleration = 3.0;
+  Traffic t(c);
+  ASSERT_EQ(t.size(), 60);
+
+  auto s0 = t.positions();
+  auto v0 = t.velocities();
+  auto a0 = t.accelerations();
+  const double dt = 0.02;
+  t.step(dt);
+  for (Eigen::Index i = 0; i < s0.size(); ++i) {
+    double s = s0[i] + v0[i] * dt + 0.5 * a0[i] * dt * dt;
+    if (s >= c.road_length) {
+      s -= c.road_length;
+    }
+    EXPECT_NEAR(t.positions()[i], s, 1e-9);
+  }
+
+  for (int i = 0; i < 10000; ++i) {
+    t.step(dt);
+  }
+  EXPECT_GE(t.positions().minCoeff(), 0.0);
+  EXPECT_LT(t.positions().maxCoeff(), c.road_length);
+  EXPECT_GE(t.velocities().minCoeff(), c.min_velocity);
+  EXPECT_LE(t.velocities().maxCoeff(), c.max_velocity);
+
+  // Objects keep to their lanes.
+  cloe::Objects objs;
+  t.to_objects(objs, Eigen::Vector3d(100.0, 4.0, 0.0), 1000,
+               []() { return std::make_shared<cloe::Object>(); });
+  ASSERT_EQ(objs.size(), t.size());
+  for (size_t i = 0; i < objs.size(); ++i) {
+    EXPECT_EQ(objs[i]->id, 1000 + static_cast<int>(i));
+    double y = lane_center(t.lanes()[i], c.num_lanes, c.lane_width) - 4.0;
+    EXPECT_EQ(objs[i]->pose.translation().y(), y);
+    EXPECT_EQ(objs[i]->velocity.x(), t.velocities()[i]);
+  }
+}
+
+TEST(minimator_traffic, checkpoint) {
+  TrafficConfig c;
+  c.road_length = 500.0;
+  c.density = 40.0;
+  Traffic t(c);
+  for (int i = 0; i < 100; ++i) {
+    t.step(0.02);
+  }
+  cloe::CheckpointWriter w;
+  t.save_state(w);
+  auto blob = w.release();
+
+  // Continuing from the checkpoint results in the same traffic.
+  Traffic u(c);
+  cloe::CheckpointReader r(blob);
+  u.load_state(r);
+  EXPECT_TRUE(r.at_end());
+  t.step(0.02);
+  u.step(0.02);
+  EXPECT_TRUE((t.positions() == u.positions()).all());
+  EXPECT_TRUE((t.velocities() == u.velocities()).all());
+  EXPECT_TRUE((t.accelerations() == u.accelerations()).all());
+
+  // The checkpoint cannot be loaded into traffic with another size.
+  c.density = 20.0;
+  Traffic v(c);
+  cloe::CheckpointReader r2(blob);
+  EXPECT_THROW(v.load_state(r2), cloe::CheckpointError);
+}
+
+TEST(minimator_traffic, road_lane_boundaries) {
+  auto lbs = make_road_lane_boundaries(3, 4.0, 100.0, 100.0, Eigen::Vector3d::Zero());
+  ASSERT_EQ(lbs.size(), 4);
+  EXPECT_EQ(lbs.at(0).dy_start, 6.0);
+  EXPECT_EQ(lbs.at(3).dy_start, -6.0);
+  EXPECT_EQ(lbs.at(0).type, cloe::LaneBoundary::Type::Solid);
+  EXPECT_EQ(lbs.at(1).type, cloe::LaneBoundary::Type::Dashed);
+  ASSERT_EQ(lbs.at(0).points.size(), 2);
+  EXPECT_EQ(lbs.at(0).points.back().x(), 100.0);
+
+  lbs = make_road_lane_boundaries(2, 3.5, 1000.0, 10.0, Eigen::Vector3d(50.0, 1.0, 0.0));
+  ASSERT_EQ(lbs.size(), 3);
+  EXPECT_EQ(lbs.at(1).dy_start, -1.0);
+  EXPECT_EQ(lbs.at(1).dx_start, -50.0);
+  ASSERT_EQ(lbs.at(1).points.size(), 101);
+  EXPECT_EQ(lbs.at(1).points.back().x(), 950.0);
+}
+
+}  // namespace minimator
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file counter_rng.hpp
+ * \see  noise_data.hpp
+ * \see  noisy_sensor_test.cpp
+ *
+ * This file defines a counter-based random number generator, which computes
+ * random numbers as a pure function of a key and a counter instead of
+ * advancing an internal state.
+ */
+
+#pragma once
+
+#include <array>    // for array<>
+#include <cmath>    // for sqrt, log, cos, sin
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t, uint64_t
+#include <utility>  // for pair<>
+
+namespace cloe {
+namespace component {
+
+using PhiloxCounter = std::array<uint32_t, 4>;
+using PhiloxKey = std::array<uint32_t, 2>;
+
+/**
+ * Return the Philox-4x32-10 block for the given counter and key.
+ *
+ * See: Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", 2011.
+ */
+inline PhiloxCounter philox4x32(PhiloxCounter c, PhiloxKey k) {
+  constexpr uint32_t M0 = 0xD2511F53;
+  constexpr uint32_t M1 = 0xCD9E8D57;
+  constexpr uint32_t W0 = 0x9E3779B9;
+  constexpr uint32_t W1 = 0xBB67AE85;
+  for (int round = 0; round < 10; ++round) {
+    uint64_t p0 = uint64_t{M0} * c[0];
+    uint64_t p1 = uint64_t{M1} * c[2];
+    c = PhiloxCounter{
+        static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0],
+        static_cast<uint32_t>(p1),
+        static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1],
+        static_cast<uint32_t>(p0),
+    };
+    k[0] += W0;
+    k[1] += W1;
+  }
+  return c;
+}
+
+/**
+ * CounterRng generates standard normal variates keyed by (seed, step, id,
+ * stream).
+ *
+ * Each sample only depends on its key, so the noise of one object is the
+ * same regardless of which other objects are present, in which order they
+ * are processed, or whether they are processed in parallel.
+ *
+ * The seed and stream are fixed for a generator, the step and id are given
+ * for each sample. One Philox block yields two independent variates via the
+ * Box-Muller transform.
+ */
+class CounterRng {
+ public:
+  CounterRng() = default;
+  explicit CounterRng(uint64_t seed, uint32_t stream = 0) { reset(seed, stream); }
+
+  void reset(uint64_t seed, uint32_t stream = 0) {
+    key_ = PhiloxKey{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    stream_ = stream;
+  }
+
+  [[nodiscard]] uint64_t seed() const { return (uint64_t{key_[1]} << 32) | key_[0]; }
+  [[nodiscard]] uint32_t stream() const { return stream_; }
+
+  /**
+   * Return two independent standard normal variates for the given step and
+   * id.
+   */
+  [[nodiscard]] std::pair<double, double> normal2(uint64_t step, uint32_t id) const {
+    double x, y;
+    normal2(step, id, x, y);
+    return {x, y};
+  }
+
+  /**
+   * Set x[i] and y[i] to independent standard normal variates for step and
+   * ids[i], for each i < n.
+   *
+   * The result for each i is the same as from normal2(step, ids[i]). If y is
+   * nullptr, only x is set.
+   */
+  template <typename Id>
+  void normal_batch(uint64_t step, const Id* ids, size_t n, double* x, double* y) const {
+    if (y == nullptr) {
+      double unused;
+      for (size_t i = 0; i < n; ++i) {
+        normal2(step, static_cast<uint32_t>(ids[i]), x[i], unused);
+      }
+      return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      normal2(step, static_cast<uint32_t>(ids[i]), x[i], y[i]);
+    }
+  }
+
+ private:
+  void normal2(uint64_t step, uint32_t id, double& x, double& y) const {
+    constexpr double two_pi = 6.283185307179586476925;
+    auto r = philox4x32(
+        PhiloxCounter{static_cast<uint32_t>(step), static_cast<uint32_t>(step >> 32), id, stream_},
+        key_);
+    double u0 = to_uniform(r[0], r[1]);
+    double u1 = to_uniform(r[2], r[3]);
+    double rho = std::sqrt(-2.0 * std::log(u0));
+    x = rho * std::cos(two_pi * u1);
+    y = rho * std::sin(two_pi * u1);
+  }
+
+  /**
+   * Return a uniform variate in the open interval (0, 1) from 53 of the 64
+   * random bits, so that the logarithm in Box-Muller is always finite.
+   */
+  static double to_uniform(uint32_t lo, uint32_t hi) {
+    uint64_t bits = ((uint64_t{hi} << 32) | lo) >> 11;
+    return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+  }
+
+ private:
+  PhiloxKey key_{0, 0};
+  uint32_t stream_{0};
+};
+
+}  // namespace component
+}  // namespace cloe
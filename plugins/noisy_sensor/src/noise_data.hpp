@@ -17,33 +17,53 @@
  */
 /**
  * \file noise_data.hpp
+ * \see  counter_rng.hpp
  */
 
 #pragma once
 
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t, uint64_t
 #include <memory>   // for shared_ptr<>
-#include <random>   // for default_random_engine, normal_distribution<>
 #include <string>   // for string
-#include <utility>  // for move
+#include <utility>  // for move, pair<>
 
 #include <cloe/component.hpp>        // for Component, ComponentFactory, ...
 #include <cloe/core.hpp>             // for Confable, Schema
 #include <cloe/entity.hpp>           // for Entity
 #include <cloe/simulator.hpp>        // for ModelError
 #include <fable/schema/factory.hpp>  // for Factory
+#include "counter_rng.hpp"           // for CounterRng
 
 namespace cloe {
 namespace component {
 
-using Generator = std::default_random_engine;
-
+/**
+ * Distribution maps standard normal variates to samples of a distribution.
+ *
+ * The variates are generated by a CounterRng, so that the noise applied to
+ * an entity does not depend on the order in which entities are processed.
+ */
 template <typename T>
 class Distribution : public Confable, public Entity {
  public:
   using Entity::Entity;
   virtual ~Distribution() noexcept = default;
 
-  virtual T get(Generator&) const = 0;
+  /**
+   * Return the sample of the distribution for the standard normal variate z.
+   */
+  virtual T get(double z) const = 0;
+
+  /**
+   * Replace each of the n standard normal variates in z with the sample of
+   * the distribution for it.
+   */
+  virtual void get(double* z, size_t n) const {
+    for (size_t i = 0; i < n; ++i) {
+      z[i] = get(z[i]);
+    }
+  }
 
   void to_json(Json& j) const override {
     j = Json{
@@ -62,9 +82,13 @@ class NormalDistribution : public Distribution<T> {
   NormalDistribution() : Distribution<T>("normal") {}
   virtual ~NormalDistribution() noexcept = default;
 
-  T get(Generator& g) const override { return distribution(g); }
+  T get(double z) const override { return mean + std_deviation * z; }
 
-  void reset() override { distribution = std::normal_distribution<T>{mean, std_deviation}; }
+  void get(double* z, size_t n) const override {
+    for (size_t i = 0; i < n; ++i) {
+      z[i] = mean + std_deviation * z[i];
+    }
+  }
 
   void to_json(Json& j) const override {
     Distribution<T>::to_json(j);
@@ -72,11 +96,6 @@ class NormalDistribution : public Distribution<T> {
     j["std_deviation"] = std_deviation;
   }
 
-  void from_conf(const Conf& c) override {
-    Confable::from_conf(c);
-    reset();
-  }
-
  protected:
   Schema schema_impl() override {
     // clang-format off
@@ -91,37 +110,10 @@ class NormalDistribution : public Distribution<T> {
   // Configuration
   double mean = 0.0;
   double std_deviation = 0.1;
-
-  // State
-  mutable std::normal_distribution<double> distribution{mean, std_deviation};
 };
 
 using DistributionPtr = std::shared_ptr<Distribution<double>>;
 
-template <typename T>
-class Random {
- public:
-  Random(const unsigned long& seed, DistributionPtr dist) : engine_(seed), d(dist) {}
-
-  virtual ~Random() noexcept = default;
-
-  T get() const { return d->get(engine_); }
-
-  void reset(const unsigned long& seed) { engine_ = std::default_random_engine(seed); }
-
-  void reset(DistributionPtr dist) {
-    if (dist) {
-      d = dist;
-    } else {
-      throw cloe::ModelError("noisy_sensor: empty distribution assignment.");
-    }
-  }
-
- private:
-  mutable std::default_random_engine engine_;
-  DistributionPtr d{nullptr};
-};
-
 class DistributionFactory : public fable::schema::Factory<DistributionPtr> {
  public:
   DistributionFactory(DistributionPtr* ptr, std::string desc)
@@ -133,19 +125,53 @@ class DistributionFactory : public fable::schema::Factory<DistributionPtr> {
   virtual ~DistributionFactory() = default;
 };
 
+/**
+ * NoiseConf draws noise for one field of the entities of a sensor.
+ *
+ * Noise is a pure function of (seed, step, entity id, stream), where the
+ * stream identifies the noise parameter within the sensor configuration.
+ */
 class NoiseConf : public Confable {
  public:
   NoiseConf() = default;
 
   virtual ~NoiseConf() noexcept = default;
 
-  double get() const { return rnd_.get(); }
+  /**
+   * Return the noise for the entity with the given id in the given step.
+   */
+  double get(uint64_t step, int id) const {
+    return distr_default->get(rng_.normal2(step, static_cast<uint32_t>(id)).first);
+  }
 
-  virtual void reset(unsigned long seed) {
-    rnd_.reset(distr_default);
-    rnd_.reset(seed);
-    // In case of multiple random number generators, a different seed must
-    // be used for each generator (e.g. increment after each rnd_.reset).
+  /**
+   * Return independent noise for the x and y components of the entity with
+   * the given id in the given step.
+   */
+  std::pair<double, double> get_xy(uint64_t step, int id) const {
+    auto z = rng_.normal2(step, static_cast<uint32_t>(id));
+    return {distr_default->get(z.first), distr_default->get(z.second)};
+  }
+
+  /**
+   * Set x[i] (and y[i], if y is not nullptr) to the noise for the entity
+   * with id ids[i] in the given step, for each i < n.
+   *
+   * The result is the same as from get and get_xy.
+   */
+  void get_batch(uint64_t step, const int* ids, size_t n, double* x, double* y = nullptr) const {
+    rng_.normal_batch(step, ids, n, x, y);
+    distr_default->get(x, n);
+    if (y != nullptr) {
+      distr_default->get(y, n);
+    }
+  }
+
+  virtual void reset(unsigned long seed, uint32_t stream) {
+    if (!distr_default) {
+      throw cloe::ModelError("noisy_sensor: empty distribution assignment.");
+    }
+    rng_.reset(seed, stream);
   }
 
   CONFABLE_SCHEMA(NoiseConf) {
@@ -164,7 +190,7 @@ class NoiseConf : public Confable {
 
  private:
   DistributionPtr distr_default{nullptr};
-  Random<double> rnd_ = Random<double>(0, distr_default);
+  CounterRng rng_;
 };
 
 struct NoisySensorConf : public Confable {
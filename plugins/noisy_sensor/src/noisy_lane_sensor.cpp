@@ -20,10 +20,13 @@
  */
 
 #include <Eigen/Geometry>  // for Isometry3d
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint32_t, uint64_t
 #include <memory>          // for shared_ptr<>
 #include <random>          // for random_device
 #include <string>          // for string
 #include <utility>         // for pair
+#include <vector>          // for vector<>
 
 #include <cloe/component.hpp>                // for Component, Json
 #include <cloe/component/frustum.hpp>        // for Frustum
@@ -34,7 +37,7 @@
 #include <cloe/registrar.hpp>                // for Registrar
 #include <cloe/sync.hpp>                     // for Sync
 #include <cloe/trigger/set_action.hpp>       // for actions::SetVariableActionFactory
-#include "noise_data.hpp"                    // for NoiseData, NoiseConf
+#include "noise_data.hpp"                    // for NoiseConf
 
 namespace cloe {
 
@@ -66,30 +69,6 @@ ENUM_SERIALIZATION(LaneBoundaryField, ({
 
 namespace component {
 
-void add_noise_dy_start(LaneBoundary* lb, const NoiseConf* noise) {
-  lb->dy_start = lb->dy_start + noise->get();
-}
-
-void add_noise_dx_start(LaneBoundary* lb, const NoiseConf* noise) {
-  lb->dx_start = lb->dx_start + noise->get();
-}
-
-void add_noise_heading_start(LaneBoundary* lb, const NoiseConf* noise) {
-  lb->heading_start = lb->heading_start + noise->get();
-}
-
-void add_noise_curv_hor_start(LaneBoundary* lb, const NoiseConf* noise) {
-  lb->curv_hor_start = lb->curv_hor_start + noise->get();
-}
-
-void add_noise_curv_hor_change(LaneBoundary* lb, const NoiseConf* noise) {
-  lb->curv_hor_change = lb->curv_hor_change + noise->get();
-}
-
-void add_noise_dx_end(LaneBoundary* lb, const NoiseConf* noise) {
-  lb->dx_end = lb->dx_end + noise->get();
-}
-
 class LaneNoiseConf : public NoiseConf {
  public:
   LaneNoiseConf() = default;
@@ -97,34 +76,16 @@ class LaneNoiseConf : public NoiseConf {
   virtual ~LaneNoiseConf() noexcept = default;
 
   /**
-   * Add noise to target parameter.
-   */
-  std::function<void(LaneBoundary*)> apply;
-
-  /**
-   * Set the appropriate target function.
+   * Add noise to the target parameter of the n lane boundaries in lbs.
+   *
+   * The noise of each lane boundary only depends on the step and its id.
    */
-  void set_target() {
-    using namespace std::placeholders;  // for _1
-    switch (target_) {
-      case LaneBoundaryField::DyStart:
-        apply = std::bind(add_noise_dy_start, _1, this);
-        break;
-      case LaneBoundaryField::DxStart:
-        apply = std::bind(add_noise_dx_start, _1, this);
-        break;
-      case LaneBoundaryField::HeadingStart:
-        apply = std::bind(add_noise_heading_start, _1, this);
-        break;
-      case LaneBoundaryField::CurvhorStart:
-        apply = std::bind(add_noise_curv_hor_start, _1, this);
-        break;
-      case LaneBoundaryField::CurvhorChange:
-        apply = std::bind(add_noise_curv_hor_change, _1, this);
-        break;
-      case LaneBoundaryField::DxEnd:
-        apply = std::bind(add_noise_dx_end, _1, this);
-        break;
+  void apply_batch(uint64_t step, LaneBoundary* const* lbs, const int* ids, size_t n) const {
+    noise_.resize(n);
+    get_batch(step, ids, n, noise_.data());
+    auto field = target_field();
+    for (size_t i = 0; i < n; ++i) {
+      lbs[i]->*field += noise_[i];
     }
   }
 
@@ -146,8 +107,30 @@ class LaneNoiseConf : public NoiseConf {
     };
   }
 
+ private:
+  double LaneBoundary::*target_field() const {
+    switch (target_) {
+      case LaneBoundaryField::DxStart:
+        return &LaneBoundary::dx_start;
+      case LaneBoundaryField::HeadingStart:
+        return &LaneBoundary::heading_start;
+      case LaneBoundaryField::CurvhorStart:
+        return &LaneBoundary::curv_hor_start;
+      case LaneBoundaryField::CurvhorChange:
+        return &LaneBoundary::curv_hor_change;
+      case LaneBoundaryField::DxEnd:
+        return &LaneBoundary::dx_end;
+      case LaneBoundaryField::DyStart:
+      default:
+        return &LaneBoundary::dy_start;
+    }
+  }
+
  private:
   LaneBoundaryField target_{LaneBoundaryField::DyStart};
+
+  // State
+  mutable std::vector<double> noise_;
 };
 
 struct NoisyLaneSensorConf : public NoisySensorConf {
@@ -184,18 +167,26 @@ class NoisyLaneBoundarySensor : public LaneBoundarySensor {
   virtual ~NoisyLaneBoundarySensor() noexcept = default;
 
   const LaneBoundaries& sensed_lane_boundaries() const override {
+    if (!config_.enabled) {
+      // Nothing to do, so forward the lane boundaries of the source sensor.
+      return sensor_->sensed_lane_boundaries();
+    }
     if (cached_) {
       return lbs_;
     }
+    // Noise is only applied to the clothoid parameters, so the copies share
+    // their points with the source lane boundaries.
     for (const auto& kv : sensor_->sensed_lane_boundaries()) {
-      auto lb = kv.second;
-      apply_noise(lb);
-      auto count = kv.first;
-      auto ptr = std::make_shared<LaneBoundary>(lb);
-      if (ptr) {
-        lbs_.insert(std::pair<int, LaneBoundary>(count, lb));
-      }
+      lbs_.emplace_hint(lbs_.end(), kv.first, kv.second);
+    }
+    // Pointers are only stable once all lane boundaries have been inserted.
+    ids_.clear();
+    ptrs_.clear();
+    for (auto& kv : lbs_) {
+      ids_.push_back(kv.first);
+      ptrs_.push_back(&kv.second);
     }
+    apply_noise();
     cached_ = true;
     return lbs_;
   }
@@ -223,6 +214,7 @@ class NoisyLaneBoundarySensor : public LaneBoundarySensor {
     // Process the underlying sensor and clear the cache.
     t = sensor_->process(sync);
     clear_cache();
+    step_ = sync.step();
     return t;
   }
 
@@ -246,12 +238,9 @@ class NoisyLaneBoundarySensor : public LaneBoundarySensor {
   }
 
  protected:
-  void apply_noise(LaneBoundary& lb) const {
-    if (!config_.enabled) {
-      return;
-    }
+  void apply_noise() const {
     for (auto& np : config_.noisy_params) {
-      np.apply(&lb);
+      np.apply_batch(step_, ptrs_.data(), ids_.data(), ptrs_.size());
     }
   }
 
@@ -268,10 +257,11 @@ class NoisyLaneBoundarySensor : public LaneBoundarySensor {
         config_.seed = seed;
       }
     }
+    // Each noise parameter draws from its own stream, so that parameters
+    // with the same distribution do not receive the same noise.
+    uint32_t stream = 0;
     for (auto& np : config_.noisy_params) {
-      np.set_target();
-      np.reset(seed);
-      ++seed;
+      np.reset(seed, stream++);
     }
   }
 
@@ -283,8 +273,11 @@ class NoisyLaneBoundarySensor : public LaneBoundarySensor {
  private:
   NoisyLaneSensorConf config_;
   std::shared_ptr<LaneBoundarySensor> sensor_;
-  mutable bool cached_;
+  mutable bool cached_{false};
+  uint64_t step_{0};
   mutable LaneBoundaries lbs_;
+  mutable std::vector<int> ids_;
+  mutable std::vector<LaneBoundary*> ptrs_;
 };
 
 DEFINE_COMPONENT_FACTORY(NoisyLaneSensorFactory, NoisyLaneSensorConf, "noisy_lane_sensor",
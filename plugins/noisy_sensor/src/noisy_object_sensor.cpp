@@ -20,6 +20,7 @@
  */
 
 #include <Eigen/Geometry>  // for Isometry3d, Vector3d
+#include <cstdint>         // for uint32_t, uint64_t
 #include <memory>          // for shared_ptr<>
 #include <random>          // for random_device
 #include <string>          // for string
@@ -27,13 +28,14 @@
 #include <cloe/component.hpp>                // for Component, Json
 #include <cloe/component/frustum.hpp>        // for Frustum
 #include <cloe/component/object.hpp>         // for Object
+#include <cloe/component/object_batch.hpp>   // for ObjectBatch
 #include <cloe/component/object_sensor.hpp>  // for ObjectSensor
 #include <cloe/conf/action.hpp>              // for actions::ConfigureFactory
 #include <cloe/plugin.hpp>                   // for EXPORT_CLOE_PLUGIN
 #include <cloe/registrar.hpp>                // for Registrar
 #include <cloe/sync.hpp>                     // for Sync
 #include <cloe/trigger/set_action.hpp>       // for actions::SetVariableActionFactory
-#include "noise_data.hpp"                    // for NoiseData, NoiseConf
+#include "noise_data.hpp"                    // for NoiseConf
 
 namespace cloe {
 
@@ -49,29 +51,6 @@ ENUM_SERIALIZATION(ObjectField, ({
 
 namespace component {
 
-void apply_noise_xy(Eigen::Vector3d* vec, const NoiseConf& noise) {
-  vec->x() = vec->x() + noise.get();
-  vec->y() = vec->y() + noise.get();
-}
-
-void add_noise_translation(Object* obj, const NoiseConf* noise) {
-  Eigen::Vector3d transl = obj->pose.translation();
-  apply_noise_xy(&transl, *noise);
-  obj->pose.translation() = transl;
-}
-
-void add_noise_velocity(Object* obj, const NoiseConf* noise) {
-  Eigen::Vector3d vel = obj->velocity;
-  apply_noise_xy(&vel, *noise);
-  obj->velocity = vel;
-}
-
-void add_noise_acceleration(Object* obj, const NoiseConf* noise) {
-  Eigen::Vector3d accel = obj->acceleration;
-  apply_noise_xy(&accel, *noise);
-  obj->acceleration = accel;
-}
-
 class ObjectNoiseConf : public NoiseConf {
  public:
   ObjectNoiseConf() = default;
@@ -79,26 +58,16 @@ class ObjectNoiseConf : public NoiseConf {
   virtual ~ObjectNoiseConf() noexcept = default;
 
   /**
-   * Add noise to target parameter.
-   */
-  std::function<void(Object*)> apply;
-
-  /**
-   * Set the appropriate target function.
+   * Add noise to the x and y components of the target parameter of all
+   * objects in the batch.
+   *
+   * The noise of each object only depends on the step and its id.
    */
-  void set_target() {
-    using namespace std::placeholders;  // for _1
-    switch (target_) {
-      case ObjectField::Translation:
-        apply = std::bind(add_noise_translation, _1, this);
-        break;
-      case ObjectField::Velocity:
-        apply = std::bind(add_noise_velocity, _1, this);
-        break;
-      case ObjectField::Acceleration:
-        apply = std::bind(add_noise_acceleration, _1, this);
-        break;
-    }
+  void apply_batch(uint64_t step, ObjectBatch& batch) const {
+    auto n = static_cast<Eigen::Index>(batch.size());
+    noise_.resize(n, 2);
+    get_batch(step, batch.ids().data(), batch.size(), noise_.col(0).data(), noise_.col(1).data());
+    target_column(batch).leftCols<2>() += noise_;
   }
 
   CONFABLE_SCHEMA(ObjectNoiseConf) {
@@ -119,8 +88,24 @@ class ObjectNoiseConf : public NoiseConf {
     };
   }
 
+ private:
+  ObjectBatch::ColumnRef target_column(ObjectBatch& batch) const {
+    switch (target_) {
+      case ObjectField::Velocity:
+        return batch.velocities();
+      case ObjectField::Acceleration:
+        return batch.accelerations();
+      case ObjectField::Translation:
+      default:
+        return batch.positions();
+    }
+  }
+
  private:
   ObjectField target_{ObjectField::Translation};
+
+  // State
+  mutable Eigen::Matrix<double, Eigen::Dynamic, 2> noise_;
 };
 
 struct NoisyObjectSensorConf : public NoisySensorConf {
@@ -160,11 +145,12 @@ class NoisyObjectSensor : public ObjectSensor {
     if (cached_) {
       return objects_;
     }
-    for (const auto& o : sensor_->sensed_objects()) {
-      auto obj = apply_noise(o);
-      if (obj) {
-        objects_.push_back(obj);
-      }
+    if (!config_.enabled) {
+      objects_ = sensor_->sensed_objects();
+    } else {
+      batch_.assign(sensor_->sensed_objects());
+      apply_noise(batch_);
+      batch_.to_objects(objects_, [this]() { return make_step_shared<Object>(); });
     }
     cached_ = true;
     return objects_;
@@ -193,6 +179,7 @@ class NoisyObjectSensor : public ObjectSensor {
     // Process the underlying sensor and clear the cache.
     t = sensor_->process(sync);
     clear_cache();
+    step_ = sync.step();
     return t;
   }
 
@@ -216,16 +203,10 @@ class NoisyObjectSensor : public ObjectSensor {
   }
 
  protected:
-  std::shared_ptr<Object> apply_noise(const std::shared_ptr<Object>& o) const {
-    if (!config_.enabled) {
-      return o;
-    }
-    auto obj = std::make_shared<Object>(*o);
-
+  void apply_noise(ObjectBatch& batch) const {
     for (auto& np : config_.noisy_params) {
-      np.apply(obj.get());
+      np.apply_batch(step_, batch);
     }
-    return obj;
   }
 
   void reset_random() {
@@ -241,10 +222,11 @@ class NoisyObjectSensor : public ObjectSensor {
         config_.seed = seed;
       }
     }
+    // Each noise parameter draws from its own stream, so that parameters
+    // with the same distribution do not receive the same noise.
+    uint32_t stream = 0;
     for (auto& np : config_.noisy_params) {
-      np.set_target();
-      np.reset(seed);
-      ++seed;
+      np.reset(seed, stream++);
     }
   }
 
@@ -257,7 +239,9 @@ class NoisyObjectSensor : public ObjectSensor {
   NoisyObjectSensorConf config_;
   std::shared_ptr<ObjectSensor> sensor_;
   mutable bool cached_;
+  uint64_t step_{0};
   mutable Objects objects_;
+  mutable ObjectBatch batch_;
 };
 
 DEFINE_COMPONENT_FACTORY(NoisyObjectSensorFactory, NoisyObjectSensorConf, "noisy_object_sensor",
@@ -17,6 +17,7 @@
  */
 /**
  * \file noisy_sensor_test.cpp
+ * \see  counter_rng.hpp
  * \see  noise_data.hpp
  * \see  noisy_object_sensor.cpp
  * \see  noisy_lane_sensor.cpp
@@ -24,7 +25,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>   // for sqrt
+#include <vector>  // for vector<>
+
 #include <fable/utility/gtest.hpp>  // for assert_validate
+#include "counter_rng.hpp"          // for CounterRng, philox4x32
 #include "noise_data.hpp"           // for NoiseConf
 
 using namespace cloe;  // NOLINT(build/namespaces)
@@ -40,3 +45,67 @@ TEST(noisy_sensor, deserialize_distribution) {
     }
   })");
 }
+
+TEST(noisy_sensor, philox_known_answer) {
+  // Known-answer vectors from the Random123 reference implementation.
+  auto r = component::philox4x32({0, 0, 0, 0}, {0, 0});
+  EXPECT_EQ(r, (component::PhiloxCounter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  r = component::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                            {0xffffffff, 0xffffffff});
+  EXPECT_EQ(r, (component::PhiloxCounter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+}
+
+TEST(noisy_sensor, counter_rng_is_order_independent) {
+  component::CounterRng rng(42, 1);
+  std::vector<int> ids{7, 3, 12, 5};
+  std::vector<double> x(ids.size()), y(ids.size());
+  rng.normal_batch(10, ids.data(), ids.size(), x.data(), y.data());
+
+  // Each sample only depends on its key, not on the other ids in the batch.
+  for (size_t i = 0; i < ids.size(); ++i) {
+    auto z = rng.normal2(10, ids[i]);
+    EXPECT_EQ(x[i], z.first);
+    EXPECT_EQ(y[i], z.second);
+  }
+  std::vector<int> one{12};
+  double x1;
+  rng.normal_batch(10, one.data(), 1, &x1, nullptr);
+  EXPECT_EQ(x1, x[2]);
+
+  // A different seed, stream, or step gives different noise.
+  EXPECT_NE(component::CounterRng(43, 1).normal2(10, 7), rng.normal2(10, 7));
+  EXPECT_NE(component::CounterRng(42, 2).normal2(10, 7), rng.normal2(10, 7));
+  EXPECT_NE(rng.normal2(11, 7), rng.normal2(10, 7));
+}
+
+TEST(noisy_sensor, noise_conf_normal_distribution) {
+  component::NoiseConf n;
+  n.from_conf(fable::Conf{fable::Json::parse(R"({
+    "distribution": {
+        "binding": "normal",
+        "mean": 1.0,
+        "std_deviation": 0.5
+    }
+  })")});
+  n.reset(1234, 0);
+
+  const size_t count = 100000;
+  std::vector<int> ids(count);
+  for (size_t i = 0; i < count; ++i) {
+    ids[i] = static_cast<int>(i);
+  }
+  std::vector<double> x(count), y(count);
+  n.get_batch(3, ids.data(), count, x.data(), y.data());
+  EXPECT_EQ(x[17], n.get(3, 17));
+  EXPECT_EQ(y[17], n.get_xy(3, 17).second);
+
+  double sum = 0.0, sum_sq = 0.0;
+  for (size_t i = 0; i < count; ++i) {
+    sum += x[i] + y[i];
+    sum_sq += x[i] * x[i] + y[i] * y[i];
+  }
+  double mean = sum / (2 * count);
+  double std_deviation = std::sqrt(sum_sq / (2 * count) - mean * mean);
+  EXPECT_NEAR(mean, 1.0, 0.01);
+  EXPECT_NEAR(std_deviation, 0.5, 0.01);
+}
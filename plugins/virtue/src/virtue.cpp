@@ -35,7 +35,7 @@
 #include <cloe/registrar.hpp>                           // for DirectCallback
 #include <cloe/sync.hpp>                                // for Sync
 #include <cloe/trigger/nil_event.hpp>                   // for DEFINE_NIL_EVENT
-#include <cloe/vehicle.hpp>                             // for Vehicle
+#include <cloe/vehicle.hpp>                             // for Vehicle, ComponentHandle
 
 namespace cloe {
 namespace controller {
@@ -134,16 +134,18 @@ class RationalityChecker : public Checker {
   void enroll(Registrar& r) override { callback_ = r.register_event<events::IrrationalFactory>(); }
 
   void init(const Sync&, const Vehicle& v) override {
-    auto ego =
-        utility::EgoSensorCanon(v.get<const EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR));
+    ego_ = v.handle<EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR);
+    auto ego = utility::EgoSensorCanon(ego_.get());
 
     // Test 1
     original_ego_ = ego.sensed_state();
   }
 
   void check(const Sync& s, const Vehicle& v) override {
-    auto ego =
-        utility::EgoSensorCanon(v.get<const EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR));
+    if (!ego_) {
+      ego_ = v.handle<EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR);
+    }
+    auto ego = utility::EgoSensorCanon(ego_.get());
 
     // Test 1: ego object cannot change size
     auto ego_state = ego.sensed_state();
@@ -168,6 +170,7 @@ class RationalityChecker : public Checker {
   void private_fail(const Sync& s) override { callback_->trigger(s); }
 
  private:
+  ComponentHandle<const EgoSensor> ego_;
   Object original_ego_;
   std::shared_ptr<events::IrrationalCallback> callback_;
 };
@@ -179,8 +182,8 @@ class SafetyChecker : public Checker {
   SafetyChecker() : Checker("safety") {}
 
   void init(const Sync& s, const Vehicle& v) override {
-    auto ego =
-        utility::EgoSensorCanon(v.get<const EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR));
+    ego_ = v.handle<EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR);
+    auto ego = utility::EgoSensorCanon(ego_.get());
 
     // Test 2
     prev_mps_ = ego.velocity_as_mps();
@@ -190,8 +193,10 @@ class SafetyChecker : public Checker {
   void enroll(Registrar& r) override { callback_ = r.register_event<events::UnsafeFactory>(); }
 
   void check(const Sync& s, const Vehicle& v) override {
-    auto ego =
-        utility::EgoSensorCanon(v.get<const EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR));
+    if (!ego_) {
+      ego_ = v.handle<EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR);
+    }
+    auto ego = utility::EgoSensorCanon(ego_.get());
 
     // Test 1: reported acceleration is not over max
     auto mpss = std::fabs(ego.acceleration_as_mpss());
@@ -249,6 +254,7 @@ class SafetyChecker : public Checker {
   double max_abs_acceleration_{20.0};
 
   // State:
+  ComponentHandle<const EgoSensor> ego_;
   double prev_mps_{0.0};
   size_t prev_step_{0};
 
@@ -267,19 +273,22 @@ class MissingLaneBoundariesChecker : public Checker {
   }
 
   void init(const Sync&, const Vehicle& v) override {
+    // This throws an exception if a component is missing.
+    sensors_.clear();
     for (auto& c : components_) {
-      // Just try to open the component and force an exception to be thrown.
-      v.get<LaneBoundarySensor>(c);
+      sensors_.emplace_back(v.handle<LaneBoundarySensor>(c));
     }
   }
 
   void check(const Sync& s, const Vehicle& v) override {
-    for (auto& comp : components_) {
-      const auto& lbs = v.get<LaneBoundarySensor>(comp);
+    if (sensors_.size() != components_.size()) {
+      init(s, v);
+    }
+    for (auto& lbs : sensors_) {
       if (lbs->sensed_lane_boundaries().empty()) {
         fail(s, "missing_lane_boundaries",
              Json{
-                 {"component", comp},
+                 {"component", lbs.key()},
              });
       }
     }
@@ -291,6 +300,7 @@ class MissingLaneBoundariesChecker : public Checker {
  private:
   std::shared_ptr<events::MissingLaneBoundariesCallback> callback_;
   std::vector<std::string> components_;
+  std::vector<ComponentHandle<const LaneBoundarySensor>> sensors_;
 };
 
 struct VirtueConfiguration : public Confable {
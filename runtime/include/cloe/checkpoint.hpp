@@ -0,0 +1,166 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/checkpoint.hpp
+ * \see  cloe/checkpoint_test.cpp
+ * \see  cloe/model.hpp
+ *
+ * This file defines the binary format in which models save and load their
+ * state for simulation checkpoints.
+ */
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <cstring>      // for memcpy
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <type_traits>  // for is_trivially_copyable_v
+#include <utility>      // for move
+
+#include <cloe/core/error.hpp>  // for Error
+
+namespace cloe {
+
+/**
+ * CheckpointError is thrown when a checkpoint cannot be written or read.
+ */
+class CheckpointError : public Error {
+ public:
+  using Error::Error;
+  virtual ~CheckpointError() noexcept = default;
+};
+
+/**
+ * CheckpointWriter appends values to a binary blob.
+ *
+ * Values are stored in host byte order without padding, so a checkpoint can
+ * only be loaded on the same architecture and by the same version of the
+ * model that saved it. Variable-length data is prefixed by its size.
+ *
+ * Example:
+ *
+ *     void save_state(CheckpointWriter& w) const override {
+ *       w.write(count_);
+ *       w.write(name_);
+ *       w.write_array(values_.data(), values_.size());
+ *     }
+ */
+class CheckpointWriter {
+ public:
+  template <typename T>
+  void write(const T& x) {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    write_bytes(&x, sizeof(T));
+  }
+
+  void write(std::string_view s) {
+    write<uint64_t>(s.size());
+    write_bytes(s.data(), s.size());
+  }
+
+  void write(const std::string& s) { write(std::string_view(s)); }
+  void write(const char* s) { write(std::string_view(s)); }
+
+  /**
+   * Write n values from data, prefixed by n.
+   */
+  template <typename T>
+  void write_array(const T* data, size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    write<uint64_t>(n);
+    write_bytes(data, n * sizeof(T));
+  }
+
+  void write_bytes(const void* data, size_t n) {
+    buf_.append(static_cast<const char*>(data), n);
+  }
+
+  [[nodiscard]] const std::string& data() const { return buf_; }
+  [[nodiscard]] std::string release() { return std::move(buf_); }
+
+ private:
+  std::string buf_;
+};
+
+/**
+ * CheckpointReader reads values from a binary blob in the order in which
+ * they were written by a CheckpointWriter.
+ *
+ * Reading past the end of the blob throws a CheckpointError.
+ */
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(std::string_view data) : data_(data) {}
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    T x;
+    read_bytes(&x, sizeof(T));
+    return x;
+  }
+
+  template <typename T>
+  void read(T& x) {
+    x = read<T>();
+  }
+
+  void read(std::string& s) { s = std::string(read_view(read<uint64_t>())); }
+
+  /**
+   * Return the size of an array written with write_array.
+   *
+   * The values must then be read with read_array_data.
+   */
+  size_t read_array_size() { return static_cast<size_t>(read<uint64_t>()); }
+
+  template <typename T>
+  void read_array_data(T* data, size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    read_bytes(data, n * sizeof(T));
+  }
+
+  void read_bytes(void* data, size_t n) {
+    auto v = read_view(n);
+    if (n != 0) {
+      std::memcpy(data, v.data(), n);
+    }
+  }
+
+  [[nodiscard]] size_t remaining() const { return data_.size() - pos_; }
+  [[nodiscard]] bool at_end() const { return pos_ == data_.size(); }
+
+ private:
+  std::string_view read_view(uint64_t n) {
+    if (n > remaining()) {
+      throw CheckpointError("checkpoint truncated: cannot read {} bytes, {} remaining", n,
+                            remaining());
+    }
+    auto v = data_.substr(pos_, n);
+    pos_ += n;
+    return v;
+  }
+
+ private:
+  std::string_view data_;
+  size_t pos_{0};
+};
+
+}  // namespace cloe
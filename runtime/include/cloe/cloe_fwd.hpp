@@ -32,6 +32,10 @@
 
 namespace cloe {
 
+// from checkpoint.hpp
+class CheckpointWriter;
+class CheckpointReader;
+
 // from core/duration.hpp
 using Duration = std::chrono::nanoseconds;
 
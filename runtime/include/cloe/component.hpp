@@ -34,8 +34,9 @@
 
 #include <fable/fable_fwd.hpp>  // for Json
 
-#include <cloe/model.hpp>  // for Model, ModelFactory
-#include <cloe/sync.hpp>   // for Sync
+#include <cloe/model.hpp>                // for Model, ModelFactory
+#include <cloe/sync.hpp>                 // for Sync
+#include <cloe/utility/step_arena.hpp>  // for StepArena
 
 /**
  * This macro defines a ComponentFactory named xFactoryType and with the
@@ -190,7 +191,34 @@ class Component : public Model {
    */
   void abort() override {}
 
+  /**
+   * Set the arena that values derived by this component in a step should be
+   * allocated from.
+   *
+   * This is set by the Vehicle that the component is added to, which resets
+   * the arena at the end of each step.
+   */
+  void set_step_arena(std::shared_ptr<utility::StepArena> arena) { arena_ = std::move(arena); }
+
  protected:
+  /**
+   * Return a new value that is valid at least until the end of the step.
+   *
+   * Use this instead of std::make_shared for values that are recreated
+   * every step, such as filtered or transformed objects. Components should
+   * release all such values when they clear their cache in process(),
+   * so that the memory can be reused without allocating.
+   *
+   * If the component is not part of a vehicle, this is std::make_shared.
+   */
+  template <typename T, typename... Args>
+  std::shared_ptr<T> make_step_shared(Args&&... args) const {
+    if (arena_) {
+      return arena_->make<T>(std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+
   friend void to_json(fable::Json& j, const Component& c) {
     j = c.active_state();
     j["id"] = c.id();
@@ -200,6 +228,7 @@ class Component : public Model {
  private:
   static uint64_t gid_;
   uint64_t id_;
+  std::shared_ptr<utility::StepArena> arena_;
 };
 
 /**
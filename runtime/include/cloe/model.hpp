@@ -50,7 +50,7 @@
 
 #include <fable/confable.hpp>  // for Confable
 
-#include <cloe/cloe_fwd.hpp>  // for Sync, Registrar
+#include <cloe/cloe_fwd.hpp>  // for Sync, Registrar, CheckpointWriter, CheckpointReader
 #include <cloe/core.hpp>      // for Duration, Error
 #include <cloe/entity.hpp>    // for Entity
 
@@ -326,6 +326,28 @@ class Model : public Entity {
    */
   virtual Duration process(const Sync&) = 0;
 
+  /**
+   * Return the earliest simulation time at which the model needs to be
+   * processed again.
+   *
+   * This is called after `process(const Sync&)` with the same sync. When
+   * fast-forwarding is enabled, the engine skips steps in which no model
+   * needs to be processed and no trigger needs to be evaluated, so a model
+   * that only needs to react to certain points in time can return the next
+   * of these. A model is always processed in all steps that are not skipped.
+   * The step width of the sync passed to the next `process(const Sync&)`
+   * includes the skipped steps, so it is the time since the last step.
+   *
+   * Return `Duration::max()` if the model does not need to be processed
+   * again by itself, such as when it only reacts to the other models.
+   *
+   * The default implementation returns the time of the next step, which
+   * prevents any step from being skipped. It is based on the configured
+   * step width, not on the time since the last step, so that a schedule of
+   * the model can take precedence.
+   */
+  virtual Duration next_wakeup(const Sync& sync) const;
+
   /**
    * Perform any work for transitioning into a paused state.
    *
@@ -391,6 +413,44 @@ class Model : public Entity {
    */
   virtual void abort() { throw ModelError("abort not supported by this model"); }
 
+  /**
+   * Return whether the model can save and load its state for a simulation
+   * checkpoint.
+   *
+   * Simulators and controllers must support checkpoints for a checkpoint of
+   * the simulation to be taken. Components that do not support checkpoints
+   * are assumed to derive their state entirely from their inputs in each
+   * step, and are skipped.
+   */
+  virtual bool is_checkpointable() const { return false; }
+
+  /**
+   * Write the state of the model into the checkpoint.
+   *
+   * This is called between two steps, after the model has processed the
+   * step with the time of the last sync it has seen.
+   *
+   * The default implementation will raise an error.
+   *
+   * \see  cloe/checkpoint.hpp
+   */
+  virtual void save_state(CheckpointWriter&) const {
+    throw ModelError("checkpoints not supported by this model");
+  }
+
+  /**
+   * Restore the state of the model from the checkpoint.
+   *
+   * This is called after `start(const Sync&)`, and before the first call of
+   * `process(const Sync&)`, which continues from the time of the checkpoint.
+   * The model must read exactly what it wrote in `save_state`.
+   *
+   * The default implementation will raise an error.
+   */
+  virtual void load_state(CheckpointReader&) {
+    throw ModelError("checkpoints not supported by this model");
+  }
+
  protected:
   bool connected_{false};
   bool operational_{false};
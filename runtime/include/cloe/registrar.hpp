@@ -49,6 +49,7 @@ class DirectCallback : public Callback {
   bool empty() const { return triggers_.empty(); }
 
   void emplace(TriggerPtr&& t, const Sync&) override { triggers_.emplace_back(std::move(t)); }
+  void clear() override { triggers_.clear(); }
   void to_json(fable::Json& j) const override { j = triggers_; }
 
   void trigger(const Sync& sync, const Ctx&... args) {
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/schedule.hpp
+ * \see  cloe/schedule.cpp
+ * \see  cloe/schedule_test.cpp
+ *
+ * This file defines the execution schedule of models that do not need to be
+ * processed in every simulation step, such as planners or camera sensors.
+ */
+
+#pragma once
+
+#include <cstdint>   // for uint64_t
+#include <optional>  // for optional<>
+
+#include <cloe/core.hpp>  // for Confable, Duration, Json
+#include <cloe/sync.hpp>  // for Sync
+
+namespace cloe {
+
+/**
+ * Schedule configures how often a model is processed.
+ *
+ * A model with a period of zero is processed in every step. Otherwise, it
+ * is processed in the first step at or after each multiple of the period,
+ * shifted by the phase. The phase can be used to spread the load of several
+ * models with the same period over different steps.
+ */
+struct Schedule : public Confable {
+  Duration period{0};
+  Duration phase{0};
+
+ public:
+  Schedule() = default;
+  explicit Schedule(Duration period, Duration phase = Duration{0})
+      : period(period), phase(phase) {}
+
+  [[nodiscard]] bool is_every_step() const { return period.count() == 0; }
+
+ public:  // Confable Overrides
+  CONFABLE_SCHEMA(Schedule) {
+    using namespace schema;  // NOLINT(build/namespaces)
+    return Struct{
+        {"period", make_schema(&period, "execution period in ns, or 0 for every step").minimum(0)},
+        {"phase", make_schema(&phase, "execution phase offset in ns").minimum(0)},
+    };
+  }
+};
+
+/**
+ * ScheduledSync is the Sync that a scheduled model sees.
+ *
+ * The time is the same as that of the simulation, but the step counts the
+ * executions of the model and the step width is the time since its last
+ * execution. All other values are those of the simulation.
+ */
+class ScheduledSync : public Sync {
+ public:
+  uint64_t step() const override { return step_; }
+  Duration step_width() const override { return step_width_; }
+  Duration base_step_width() const override { return base_->base_step_width(); }
+  Duration time() const override { return base_->time(); }
+  Duration eta() const override { return base_->eta(); }
+  double realtime_factor() const override { return base_->realtime_factor(); }
+  double achievable_realtime_factor() const override {
+    return base_->achievable_realtime_factor();
+  }
+
+ private:
+  friend class Scheduler;
+
+  const Sync* base_{nullptr};
+  uint64_t step_{0};
+  Duration step_width_{0};
+};
+
+/**
+ * Scheduler decides in each step whether a model is due according to its
+ * Schedule, and maintains the ScheduledSync it is processed with.
+ *
+ * Usage:
+ *
+ *     if (scheduler.is_due(sync)) {
+ *       model.process(scheduler.sync());
+ *     }
+ */
+class Scheduler {
+ public:
+  Scheduler() = default;
+  explicit Scheduler(const Schedule& s) : schedule_(s) {}
+
+  [[nodiscard]] const Schedule& schedule() const { return schedule_; }
+
+  /**
+   * Return true if the model should be processed in the step of the given
+   * simulation sync, in which case sync() is updated accordingly.
+   *
+   * This must be called exactly once per simulation step.
+   */
+  bool is_due(const Sync& s);
+
+  /**
+   * Return the sync to process the model with.
+   *
+   * This is only valid after is_due returned true and as long as the sync
+   * that was passed to it is alive.
+   */
+  [[nodiscard]] const Sync& sync() const { return sync_; }
+
+  /**
+   * Return the simulation time at which the model is next due.
+   */
+  [[nodiscard]] Duration next_time() const { return next_; }
+
+  /**
+   * Return the simulation time at which a model that needs to be processed
+   * at the given time is next due.
+   *
+   * A model cannot be due before the next time of its schedule, but it is
+   * due in any step after that.
+   */
+  [[nodiscard]] Duration next_wakeup(Duration requested) const;
+
+  /**
+   * Forget all executions, so that the model is due again as if the
+   * simulation started anew.
+   */
+  void reset();
+
+  friend void to_json(Json& j, const Scheduler& s) {
+    j = Json{
+        {"period", s.schedule_.period},
+        {"phase", s.schedule_.phase},
+        {"num_processed", s.num_processed_},
+        {"num_skipped", s.num_skipped_},
+    };
+  }
+
+ private:
+  Schedule schedule_;
+  ScheduledSync sync_;
+  std::optional<Duration> last_;
+  Duration next_{0};
+
+  // Statistics:
+  uint64_t num_processed_{0};
+  uint64_t num_skipped_{0};
+};
+
+}  // namespace cloe
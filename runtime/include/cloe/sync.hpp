@@ -43,10 +43,19 @@ class Sync {
   /**
    * Return the atomic simulation step width.
    *
-   * This is the lowest-common-denominator of all models.
+   * This is the lowest-common-denominator of all models. If steps were
+   * skipped by fast-forwarding, it is the time since the last step instead.
    */
   virtual Duration step_width() const = 0;
 
+  /**
+   * Return the configured simulation step width.
+   *
+   * Unlike step_width(), this never includes skipped steps, so it is the
+   * time until the next step that the simulation could execute.
+   */
+  virtual Duration base_step_width() const { return step_width(); }
+
   /**
    * Return the simulation time.
    */
@@ -556,6 +556,14 @@ class Callback {
    */
   virtual void emplace(TriggerPtr&& t, const Sync& s) = 0;
 
+  /**
+   * Remove all contained triggers without executing them.
+   *
+   * The default implementation does nothing, which is only correct for
+   * callbacks that do not store triggers themselves, such as AliasCallback.
+   */
+  virtual void clear() {}
+
   /**
    * Return JSON representation of all contained triggers.
    */
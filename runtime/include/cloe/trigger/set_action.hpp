@@ -46,6 +46,11 @@ inline int from_string<int>(const std::string& s) {
   return std::stoi(s);
 }
 
+template <>
+inline std::string from_string<std::string>(const std::string& s) {
+  return s;
+}
+
 template <>
 inline bool from_string<bool>(const std::string& s) {
   if (s == "true") {
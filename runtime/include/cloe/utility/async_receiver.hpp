@@ -0,0 +1,289 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/async_receiver.hpp
+ * \see  cloe/utility/tcp_transceiver.hpp
+ *
+ * This file defines an asynchronous receive pipeline, which can be used by
+ * transceivers to move network I/O and message decoding off the simulation
+ * thread.
+ *
+ * Example:
+ * ```cpp
+ * AsyncReceiver<std::shared_ptr<Message>> receiver;
+ * receiver.start([this]() { return this->receive_wait(); });
+ *
+ * // In the simulation thread:
+ * std::vector<std::shared_ptr<Message>> msgs;
+ * receiver.drain(msgs);
+ * ```
+ */
+
+#pragma once
+
+#include <atomic>              // for atomic<>
+#include <chrono>              // for steady_clock, duration<>
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <exception>           // for exception_ptr, rethrow_exception
+#include <functional>          // for function<>
+#include <mutex>               // for mutex, unique_lock<>
+#include <thread>              // for thread
+#include <utility>             // for move
+
+#include <boost/lockfree/spsc_queue.hpp>  // for spsc_queue<>
+
+#include <cloe/utility/statistics.hpp>  // for Accumulator
+#include <fable/json.hpp>               // for Json
+
+namespace cloe::utility {
+
+/**
+ * AsyncReceiver runs a blocking read function on a dedicated reader thread
+ * and makes the decoded messages available via a lock-free single-producer
+ * single-consumer queue.
+ *
+ * The consumer side (has, size, wait, wait_for, drain, to_json) must only be
+ * used from a single thread, normally the simulation thread.
+ *
+ * If the read function throws an exception, the reader thread stops and the
+ * exception is rethrown in the consumer thread by the next call to drain(),
+ * once all messages received before the error have been drained.
+ */
+template <typename T>
+class AsyncReceiver {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  static constexpr size_t default_capacity = 1024;
+
+  explicit AsyncReceiver(size_t capacity = default_capacity)
+      : queue_(capacity), capacity_(capacity) {}
+  AsyncReceiver(const AsyncReceiver&) = delete;
+  AsyncReceiver& operator=(const AsyncReceiver&) = delete;
+  AsyncReceiver(AsyncReceiver&&) = delete;
+  AsyncReceiver& operator=(AsyncReceiver&&) = delete;
+
+  /**
+   * Stop the reader thread, if still running.
+   *
+   * This calls the unblock function passed to start(), so that a blocking
+   * read does not keep the destructor from returning. The resource that
+   * read and unblock use must therefore still exist at this point.
+   */
+  ~AsyncReceiver() { stop(); }
+
+  /**
+   * Start the reader thread, which calls read repeatedly until stop() is
+   * called or read throws an exception.
+   *
+   * The read function should block until a complete message is available.
+   * The unblock function is called by stop() after the stop flag is set, and
+   * should cause any blocking read to return or throw, for example by
+   * shutting down the underlying socket. Without it, stop() blocks until the
+   * current read returns.
+   */
+  void start(std::function<T()> read, std::function<void()> unblock = {}) {
+    stop_ = false;
+    unblock_ = std::move(unblock);
+    thread_ = std::thread([this, read = std::move(read)]() { this->run(read); });
+  }
+
+  /**
+   * Stop the reader thread and wait for it to finish.
+   *
+   * If given, the unblock function is called instead of the one passed to
+   * start().
+   */
+  void stop(const std::function<void()>& unblock = {}) {
+    stop_ = true;
+    if (thread_.joinable()) {
+      if (unblock) {
+        unblock();
+      } else if (unblock_) {
+        unblock_();
+      }
+      thread_.join();
+    }
+  }
+
+  /**
+   * Return true if the reader thread is still receiving messages.
+   */
+  [[nodiscard]] bool is_running() const { return thread_.joinable() && !done_; }
+
+  /**
+   * Return true if there is at least one decoded message in the queue.
+   */
+  [[nodiscard]] bool has() const { return queue_.read_available() != 0; }
+
+  /**
+   * Return the number of decoded messages in the queue.
+   */
+  [[nodiscard]] size_t size() const { return queue_.read_available(); }
+
+  /**
+   * Block until at least one message is available or the reader thread has
+   * stopped.
+   */
+  void wait() {
+    std::unique_lock<std::mutex> lock(wait_mtx_);
+    wait_cv_.wait(lock, [this]() { return has() || done_; });
+  }
+
+  /**
+   * Block until at least one message is available, the reader thread has
+   * stopped, or the timeout expires.
+   *
+   * Return true if a message is available.
+   */
+  template <typename Rep, typename Period>
+  bool wait_for(std::chrono::duration<Rep, Period> timeout) {
+    std::unique_lock<std::mutex> lock(wait_mtx_);
+    wait_cv_.wait_for(lock, timeout, [this]() { return has() || done_; });
+    return has();
+  }
+
+  /**
+   * Call fn with each message currently in the queue, in the order they were
+   * received.
+   *
+   * If the reader thread failed and there are no messages left, the exception
+   * from the reader thread is rethrown.
+   *
+   * Return the number of messages drained.
+   */
+  template <typename F>
+  size_t drain_with(F&& fn) {
+    // Read this before consuming, so that we don't miss messages that are
+    // pushed just before the reader thread stops.
+    bool done = done_;
+    auto depth = queue_.read_available();
+    if (depth > max_depth_) {
+      max_depth_ = depth;
+    }
+    depth_.push_back(static_cast<double>(depth));
+
+    auto now = Clock::now();
+    auto n = queue_.consume_all([&](Entry& e) {
+      latency_.push_back(Milliseconds(now - e.received).count());
+      fn(std::move(e.msg));
+    });
+    num_drained_ += n;
+
+    if (done && !has() && error_) {
+      auto err = error_;
+      error_ = nullptr;
+      std::rethrow_exception(err);
+    }
+    return n;
+  }
+
+  /**
+   * Move all messages currently in the queue to the back of out.
+   *
+   * \see drain_with
+   */
+  template <typename Container>
+  size_t drain(Container& out) {
+    return drain_with([&out](T&& msg) { out.push_back(std::move(msg)); });
+  }
+
+  /**
+   * Write statistics about queue depth and latency between decoding and
+   * draining in milliseconds.
+   */
+  friend void to_json(fable::Json& j, const AsyncReceiver<T>& r) {
+    j = fable::Json{
+        {"running", r.is_running()},
+        {"queue_capacity", r.capacity_},
+        {"queue_depth", r.queue_.read_available()},
+        {"queue_depth_max", r.max_depth_},
+        {"queue_depth_stats", r.depth_},
+        {"queue_full_waits", r.num_full_.load()},
+        {"latency_ms", r.latency_},
+        {"num_messages_decoded", r.num_decoded_.load()},
+        {"num_messages_drained", r.num_drained_},
+    };
+  }
+
+ private:
+  struct Entry {
+    T msg;
+    Clock::time_point received;
+  };
+
+  void run(const std::function<T()>& read) {
+    try {
+      while (!stop_) {
+        Entry e{read(), Clock::now()};
+        while (!queue_.push(e)) {
+          // The consumer is not keeping up, so we apply backpressure to the
+          // sender by not reading any further.
+          if (stop_) {
+            return finish();
+          }
+          num_full_++;
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        num_decoded_++;
+        notify();
+      }
+    } catch (...) {
+      // When we are stopping, errors are expected, since the unblock
+      // function will cause the read to fail.
+      if (!stop_) {
+        error_ = std::current_exception();
+      }
+    }
+    finish();
+  }
+
+  void finish() {
+    done_ = true;
+    notify();
+  }
+
+  void notify() {
+    { std::lock_guard<std::mutex> guard(wait_mtx_); }
+    wait_cv_.notify_all();
+  }
+
+ private:
+  boost::lockfree::spsc_queue<Entry> queue_;
+  size_t capacity_;
+  std::thread thread_;
+  std::function<void()> unblock_;
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> done_{false};
+  std::exception_ptr error_{nullptr};  // written before done_ is set
+  std::mutex wait_mtx_;
+  std::condition_variable wait_cv_;
+
+  // Statistics updated by the reader thread:
+  std::atomic<uint64_t> num_decoded_{0};
+  std::atomic<uint64_t> num_full_{0};
+
+  // Statistics updated by the consumer thread:
+  uint64_t num_drained_{0};
+  size_t max_depth_{0};
+  Accumulator depth_;
+  Accumulator latency_;
+};
+
+}  // namespace cloe::utility
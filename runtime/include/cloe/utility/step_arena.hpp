@@ -0,0 +1,194 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/step_arena.hpp
+ * \see  cloe/utility/step_arena.cpp
+ * \see  cloe/utility/step_arena_test.cpp
+ * \see  cloe/component.hpp
+ * \see  cloe/vehicle.hpp
+ *
+ * This file defines a step-scoped memory pool for values that components
+ * derive from the output of other components, such as filtered or
+ * transformed objects.
+ */
+
+#pragma once
+
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <deque>          // for deque<>
+#include <list>           // for list<>
+#include <memory>         // for shared_ptr<>, unique_ptr<>
+#include <type_traits>    // for is_same, decay_t
+#include <typeindex>      // for type_index
+#include <typeinfo>       // for typeid
+#include <unordered_map>  // for unordered_map<>
+#include <utility>        // for forward, move
+
+#include <fable/fable_fwd.hpp>  // for Json
+
+namespace cloe::utility {
+
+class StepPoolBase {
+ public:
+  virtual ~StepPoolBase() = default;
+  virtual void reset() = 0;
+
+  /**
+   * Write the statistics of the pool to j.
+   */
+  void to_json(fable::Json& j) const;
+
+ protected:
+  size_t last_used_{0};
+  size_t num_generations_{1};
+  uint64_t num_made_{0};
+  uint64_t num_slots_allocated_{0};
+  uint64_t num_retired_{0};
+};
+
+/**
+ * StepPool hands out values of type T that live until the pool is reset,
+ * normally at the end of each step.
+ *
+ * Values are returned as shared_ptr that share ownership of the storage
+ * of the current step (the generation) instead of owning the value, so no
+ * allocation is necessary once the pool has grown to its peak size.
+ *
+ * When the pool is reset and no value of the current generation is still
+ * referenced, the storage is reused for the next step. Otherwise, the
+ * generation is retired and kept alive until the last value is released,
+ * so holding on to values past the end of a step is safe, if less
+ * efficient.
+ */
+template <typename T>
+class StepPool : public StepPoolBase {
+ public:
+  StepPool() : current_(std::make_shared<Generation>()) {}
+
+  /**
+   * Return a new value constructed from args.
+   *
+   * If there is a free slot, it is assigned to, which allows T to reuse
+   * memory it already owns, such as the capacity of a vector.
+   */
+  template <typename... Args>
+  std::shared_ptr<T> make(Args&&... args) {
+    auto& gen = *current_;
+    T* slot;
+    if (gen.used < gen.slots.size()) {
+      slot = &gen.slots[gen.used];
+      if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, T> && ...)) {
+        *slot = (std::forward<Args>(args), ...);
+      } else {
+        *slot = T(std::forward<Args>(args)...);
+      }
+    } else {
+      slot = &gen.slots.emplace_back(std::forward<Args>(args)...);
+      num_slots_allocated_++;
+    }
+    gen.used++;
+    num_made_++;
+    return std::shared_ptr<T>(current_, slot);
+  }
+
+  /**
+   * Release all values for reuse, or retire the current generation if any
+   * of its values is still in use.
+   */
+  void reset() override {
+    last_used_ = current_->used;
+    if (current_.use_count() == 1) {
+      current_->used = 0;
+      return;
+    }
+    num_retired_++;
+    retired_.push_back(std::move(current_));
+    current_ = take_free_generation();
+    num_generations_ = retired_.size() + 1;
+  }
+
+  /**
+   * Return the number of values handed out in the current step.
+   */
+  [[nodiscard]] size_t size() const { return current_->used; }
+
+  /**
+   * Return the number of slots available in the current generation.
+   */
+  [[nodiscard]] size_t capacity() const { return current_->slots.size(); }
+
+ private:
+  struct Generation {
+    std::deque<T> slots;
+    size_t used{0};
+  };
+
+  std::shared_ptr<Generation> take_free_generation() {
+    for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+      if (it->use_count() == 1) {
+        auto gen = std::move(*it);
+        retired_.erase(it);
+        gen->used = 0;
+        return gen;
+      }
+    }
+    return std::make_shared<Generation>();
+  }
+
+ private:
+  std::shared_ptr<Generation> current_;
+  std::list<std::shared_ptr<Generation>> retired_;
+};
+
+/**
+ * StepArena contains a StepPool for each type that is requested from it,
+ * and resets all of them at once.
+ *
+ * A Vehicle owns a StepArena, which it shares with its components, and
+ * resets it at the end of each step.
+ */
+class StepArena {
+ public:
+  template <typename T>
+  StepPool<T>& pool() {
+    auto& p = pools_[std::type_index(typeid(T))];
+    if (!p) {
+      p = std::make_unique<StepPool<T>>();
+    }
+    return static_cast<StepPool<T>&>(*p);
+  }
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> make(Args&&... args) {
+    return pool<T>().make(std::forward<Args>(args)...);
+  }
+
+  void reset() {
+    for (auto& kv : pools_) {
+      kv.second->reset();
+    }
+  }
+
+  friend void to_json(fable::Json& j, const StepArena& a);
+
+ private:
+  std::unordered_map<std::type_index, std::unique_ptr<StepPoolBase>> pools_;
+};
+
+}  // namespace cloe::utility
@@ -21,11 +21,14 @@
 
 #pragma once
 
-#include <chrono>   // for duration<>
-#include <memory>   // for unique_ptr<>
-#include <string>   // for string, to_string
-#include <thread>   // for this_thread, sleep_for
-#include <utility>  // for move
+#include <unistd.h>  // for dup, close
+#include <cerrno>    // for errno
+#include <chrono>    // for duration<>
+#include <cstring>   // for strerror
+#include <memory>    // for unique_ptr<>
+#include <string>    // for string, to_string
+#include <thread>    // for this_thread, sleep_for
+#include <utility>   // for move
 
 #include <boost/asio.hpp>  // for iostream
 
@@ -92,15 +95,27 @@ class TcpTransceiver {
   bool tcp_is_ok() const { return static_cast<bool>(tcp_stream_); }
 
   /**
-   * Close the underlying stream and mark this object as disconnected.
+   * Close the underlying streams and mark this object as disconnected.
    *
    * It is not necessary to call this before destruction.
    */
   void tcp_disconnect() {
+    tcp_reader_.close();
     tcp_stream_.close();
     tcp_connected_ = false;
   }
 
+  /**
+   * Shut down both directions of the underlying socket without closing it.
+   *
+   * This causes any read that is blocked in another thread to return with
+   * an error, and can be used to stop a reader thread before disconnecting.
+   */
+  void tcp_shutdown() {
+    boost::system::error_code ec;
+    tcp_stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+  }
+
   uint16_t tcp_port() const { return tcp_port_; }
   const std::string& tcp_host() const { return tcp_host_; }
   std::string tcp_endpoint() const { return fmt::format("tcp://{}:{}", tcp_host_, tcp_port_); }
@@ -113,6 +128,30 @@ class TcpTransceiver {
     return tcp_stream_.rdbuf()->in_avail() + tcp_stream_.rdbuf()->available();
   }
 
+  /**
+   * Open tcp_reader_ on a duplicate of the connected socket.
+   *
+   * An iostream must not be used by several threads at once, so a reader
+   * thread should only use tcp_reader_, and leave tcp_stream_ to the owning
+   * thread for sending. Both refer to the same connection, so tcp_shutdown()
+   * also unblocks a read from tcp_reader_.
+   *
+   * - Throws `std::ios_base::failure` if the socket cannot be duplicated.
+   */
+  void tcp_open_reader() {
+    auto& socket = tcp_stream_.socket();
+    int fd = ::dup(socket.native_handle());
+    if (fd == -1) {
+      throw std::ios_base::failure("cannot duplicate socket: " + std::string(std::strerror(errno)));
+    }
+    boost::system::error_code ec;
+    tcp_reader_.socket().assign(socket.local_endpoint(ec).protocol(), fd, ec);
+    if (ec) {
+      ::close(fd);
+      throw std::ios_base::failure("cannot open reader on socket: " + ec.message());
+    }
+  }
+
   template <typename M>
   void tcp_send(M* msg, size_t sz) {
     tcp_stream_.write(reinterpret_cast<const char*>(msg), sz);
@@ -121,6 +160,7 @@ class TcpTransceiver {
 
  protected:
   boost::asio::ip::tcp::iostream tcp_stream_;
+  boost::asio::ip::tcp::iostream tcp_reader_;
   bool tcp_connected_{false};
   std::string tcp_host_{};
   uint16_t tcp_port_{};
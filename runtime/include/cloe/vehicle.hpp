@@ -28,11 +28,14 @@
 #include <map>          // for map<>
 #include <memory>       // for shared_ptr<>
 #include <string>       // for string
-#include <type_traits>  // for enable_if_t<>, is_enum<>
+#include <type_traits>  // for enable_if_t<>, is_enum<>, is_const<>
+#include <utility>      // for move
+#include <vector>       // for vector<>
 
 #include <cloe/component.hpp>  // for Component
 #include <cloe/core.hpp>       // for Json
 #include <cloe/model.hpp>      // for Model
+#include <cloe/schedule.hpp>   // for Schedule, Scheduler
 
 namespace cloe {
 
@@ -85,6 +88,9 @@ class CannotAddComponent : public Error {
   std::string component_;
 };
 
+template <typename T>
+class ComponentHandle;
+
 /**
  * A Vehicle is a collection of sensor and actuator components.
  *
@@ -174,6 +180,43 @@ class Vehicle : public Model {
     return get<T>(to_string(c));
   }
 
+  /**
+   * Return a handle to the component associated with the key.
+   *
+   * The handle resolves the component once and only resolves it again when
+   * the components of the vehicle change, so it is cheap to use every step.
+   * The handle must not outlive the vehicle.
+   *
+   * This may throw the same errors as get.
+   */
+  template <typename T>
+  ComponentHandle<const T> handle(const std::string& key) const {
+    return ComponentHandle<const T>(*this, key);
+  }
+
+  template <typename T>
+  ComponentHandle<T> handle(const std::string& key) {
+    return ComponentHandle<T>(*this, key);
+  }
+
+  template <typename T, typename Enum, std::enable_if_t<std::is_enum<Enum>::value, int> = 0>
+  ComponentHandle<const T> handle(Enum c) const {
+    return handle<T>(to_string(c));
+  }
+
+  template <typename T, typename Enum, std::enable_if_t<std::is_enum<Enum>::value, int> = 0>
+  ComponentHandle<T> handle(Enum c) {
+    return handle<T>(to_string(c));
+  }
+
+  /**
+   * Return a number that changes whenever a component is set.
+   *
+   * This is used by ComponentHandle to detect when it needs to resolve its
+   * component again.
+   */
+  uint64_t components_version() const { return components_version_; }
+
  public:  // Component Management
   template <typename... Arguments>
   void new_component(Component* ptr, const Arguments&... aliases) {
@@ -217,9 +260,28 @@ class Vehicle : public Model {
   }
 
   void set_component(const std::string& key, std::shared_ptr<Component> component) {
+    component->set_step_arena(arena_);
     this->components_[key] = component;
+    this->update_unique_components();
   }
 
+  /**
+   * Set the schedule with which the component under the given key is
+   * processed.
+   *
+   * The schedule applies to the component itself, and thus to all of its
+   * aliases. By default, components are processed in every step. Setting
+   * other components later keeps the state of the schedule.
+   *
+   * A component that wraps another, such as a noisy sensor, processes the
+   * wrapped component itself. The wrapped component is therefore processed
+   * when the wrapper is due, and in addition according to its own schedule
+   * if it is still part of the vehicle under another key.
+   *
+   * \see  Schedule
+   */
+  void set_schedule(const std::string& key, const Schedule& s);
+
   std::vector<std::string> component_names() const {
     std::vector<std::string> results;
     results.reserve(components_.size());
@@ -234,6 +296,14 @@ class Vehicle : public Model {
    * Process all components.
    *
    * This primarily consists of clearing the cache and updating internal state.
+   * Afterwards, the step arena shared with all components is reset.
+   *
+   * Components that are available under several aliases are only processed
+   * once. The list of unique components is maintained by set_component, so
+   * this does not allocate.
+   *
+   * Components with a schedule are skipped in steps in which they are not
+   * due, and otherwise processed with a Sync that reflects their rate.
    *
    * # Note
    *
@@ -243,6 +313,13 @@ class Vehicle : public Model {
    * be directly reachable, but two different components will update it.
    */
   Duration process(const Sync& sync) override;
+
+  /**
+   * Return the earliest time at which any component needs to be processed,
+   * respecting the schedules of the components.
+   */
+  Duration next_wakeup(const Sync& sync) const override;
+
   void connect() override;
   void disconnect() override;
 
@@ -255,6 +332,7 @@ class Vehicle : public Model {
         {"id", v.id()},
         {"name", v.name()},
         {"components", v.components_},
+        {"step_arena", *v.arena_},
     };
   }
 
@@ -266,6 +344,15 @@ class Vehicle : public Model {
   std::shared_ptr<const Component> at(const std::string& key) const;
   std::shared_ptr<Component> at(const std::string& key);
 
+ private:
+  /**
+   * Update the list of unique components from the map of components.
+   *
+   * This is called whenever a component is set, so that process doesn't
+   * need to deduplicate aliased components every step.
+   */
+  void update_unique_components();
+
  private:
   uint64_t id_;
 
@@ -287,6 +374,103 @@ class Vehicle : public Model {
    * this to a shared_ptr and deal with the collateral damage.
    */
   std::map<std::string, std::shared_ptr<Component>> components_;
+
+  /**
+   * Schedules of components by component id.
+   */
+  std::map<uint64_t, Schedule> schedules_;
+
+  struct ScheduledComponent {
+    std::shared_ptr<Component> component;
+    Scheduler scheduler;
+  };
+
+  /**
+   * Components without aliases, in the order they are processed.
+   */
+  std::vector<ScheduledComponent> unique_components_;
+
+  /**
+   * Incremented whenever a component is set.
+   */
+  uint64_t components_version_{1};
+
+  /**
+   * Values derived by components in a step are allocated from this arena.
+   *
+   * \see  Component::make_step_shared
+   */
+  std::shared_ptr<utility::StepArena> arena_{std::make_shared<utility::StepArena>()};
+};
+
+/**
+ * ComponentHandle refers to a component of a vehicle by its key, and keeps
+ * the resolved component until the components of the vehicle change.
+ *
+ * This saves the map lookup and dynamic cast of Vehicle::get in code that
+ * accesses the same component every step, such as controllers:
+ *
+ *     // In init:
+ *     ego_ = vehicle.handle<EgoSensor>(CloeComponent::GROUNDTRUTH_EGO_SENSOR);
+ *
+ *     // In process:
+ *     const auto& obj = ego_->sensed_state();
+ *
+ * The handle must not outlive the vehicle it was created from.
+ */
+template <typename T>
+class ComponentHandle {
+ public:
+  ComponentHandle() = default;
+
+  /**
+   * Resolve the component associated with the key.
+   *
+   * This may throw one of:
+   * - UnknownComponent
+   * - BadComponentCast
+   */
+  ComponentHandle(Vehicle& v, std::string key) : vehicle_(&v), key_(std::move(key)) { resolve(); }
+
+  template <typename U = T, std::enable_if_t<std::is_const<U>::value, int> = 0>
+  ComponentHandle(const Vehicle& v, std::string key) : vehicle_(&v), key_(std::move(key)) {
+    resolve();
+  }
+
+  /**
+   * Return whether the handle refers to a vehicle.
+   */
+  explicit operator bool() const { return vehicle_ != nullptr; }
+
+  const std::string& key() const { return key_; }
+
+  /**
+   * Return the component, resolving it again if the components of the
+   * vehicle changed since it was last resolved.
+   */
+  const std::shared_ptr<T>& get() const {
+    if (version_ != vehicle_->components_version()) {
+      resolve();
+    }
+    return ptr_;
+  }
+
+  T* operator->() const { return get().get(); }
+  T& operator*() const { return *get(); }
+
+ private:
+  void resolve() const {
+    ptr_ = std::const_pointer_cast<T>(vehicle_->template get<std::remove_const_t<T>>(key_));
+    version_ = vehicle_->components_version();
+  }
+
+ private:
+  // A non-const vehicle is required unless T is const, so it is safe to cast
+  // away the constness of the component in resolve.
+  const Vehicle* vehicle_{nullptr};
+  std::string key_;
+  mutable std::shared_ptr<T> ptr_;
+  mutable uint64_t version_{0};
 };
 
 }  // namespace cloe
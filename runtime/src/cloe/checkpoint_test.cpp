@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/checkpoint_test.cpp
+ * \see  cloe/checkpoint.hpp
+ */
+
+#include <cstdint>  // for uint64_t
+#include <string>   // for string
+#include <vector>   // for vector<>
+
+#include <gtest/gtest.h>
+
+#include <cloe/checkpoint.hpp>  // for CheckpointWriter, CheckpointReader
+#include <cloe/model.hpp>       // for Model, ModelError
+#include <cloe/sync.hpp>        // for Sync
+
+using namespace cloe;  // NOLINT(build/namespaces)
+
+namespace {
+
+class TestModel : public Model {
+ public:
+  TestModel() : Model("test") {}
+  Duration process(const Sync& sync) override { return sync.time(); }
+  void abort() override {}
+};
+
+}  // anonymous namespace
+
+TEST(cloe_checkpoint, round_trip) {
+  std::vector<double> xs{1.0, -2.5, 3.25};
+  CheckpointWriter w;
+  w.write<uint64_t>(42);
+  w.write("hello");
+  w.write(true);
+  w.write_array(xs.data(), xs.size());
+  w.write(std::string());
+  auto blob = w.release();
+
+  CheckpointReader r(blob);
+  EXPECT_EQ(r.read<uint64_t>(), 42);
+  std::string s;
+  r.read(s);
+  EXPECT_EQ(s, "hello");
+  EXPECT_TRUE(r.read<bool>());
+  std::vector<double> ys(r.read_array_size());
+  r.read_array_data(ys.data(), ys.size());
+  EXPECT_EQ(xs, ys);
+  r.read(s);
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(r.at_end());
+}
+
+TEST(cloe_checkpoint, truncated) {
+  CheckpointWriter w;
+  w.write("hello");
+  auto blob = w.release();
+
+  CheckpointReader r(std::string_view(blob).substr(0, blob.size() - 1));
+  std::string s;
+  EXPECT_THROW(r.read(s), CheckpointError);
+
+  CheckpointReader r2(blob);
+  r2.read(s);
+  EXPECT_THROW(r2.read<int>(), CheckpointError);
+}
+
+TEST(cloe_checkpoint, model_default) {
+  TestModel m;
+  EXPECT_FALSE(m.is_checkpointable());
+  CheckpointWriter w;
+  EXPECT_THROW(m.save_state(w), ModelError);
+}
@@ -22,8 +22,14 @@
 
 #include <cloe/model.hpp>
 
+#include <cloe/sync.hpp>  // for Sync
+
 namespace cloe {
 
 Duration Model::resolution() const { return Duration(20000); }
 
+Duration Model::next_wakeup(const Sync& sync) const {
+  return sync.time() + sync.base_step_width();
+}
+
 }  // namespace cloe
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/schedule.cpp
+ * \see  cloe/schedule.hpp
+ */
+
+#include <cloe/schedule.hpp>
+
+#include <algorithm>  // for max
+
+namespace cloe {
+
+bool Scheduler::is_due(const Sync& s) {
+  const Duration now = s.time();
+  if (schedule_.is_every_step()) {
+    sync_.base_ = &s;
+    sync_.step_ = s.step();
+    sync_.step_width_ = s.step_width();
+    num_processed_++;
+    return true;
+  }
+
+  if (now < next_ || now < schedule_.phase) {
+    num_skipped_++;
+    return false;
+  }
+
+  // The model is due in the first step at or after the next multiple of the
+  // period, so a period that is not a multiple of the simulation step width
+  // does not drift, and the step width the model sees varies instead.
+  const Duration& period = schedule_.period;
+  sync_.base_ = &s;
+  sync_.step_ = num_processed_;
+  sync_.step_width_ = last_ ? now - *last_ : period;
+  last_ = now;
+  next_ = schedule_.phase + period * ((now - schedule_.phase) / period + 1);
+  num_processed_++;
+  return true;
+}
+
+Duration Scheduler::next_wakeup(Duration requested) const {
+  if (schedule_.is_every_step()) {
+    return requested;
+  }
+  return std::max({requested, next_, schedule_.phase});
+}
+
+void Scheduler::reset() {
+  sync_ = ScheduledSync{};
+  last_.reset();
+  next_ = Duration{0};
+  num_processed_ = 0;
+  num_skipped_ = 0;
+}
+
+}  // namespace cloe
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/schedule_test.cpp
+ * \see  cloe/schedule.hpp
+ */
+
+#include <vector>  // for vector<>
+
+#include <gtest/gtest.h>
+
+#include <cloe/schedule.hpp>  // for Schedule, Scheduler
+#include <cloe/sync.hpp>      // for Sync
+
+using namespace cloe;  // NOLINT(build/namespaces)
+
+namespace {
+
+constexpr Duration ms(int64_t x) { return Duration(x * 1'000'000); }
+
+class StepSync : public Sync {
+ public:
+  explicit StepSync(Duration step_width) : step_width_(step_width) {}
+  uint64_t step() const override { return step_; }
+  Duration step_width() const override { return step_width_; }
+  Duration time() const override { return step_width_ * static_cast<int64_t>(step_); }
+  Duration eta() const override { return Duration(0); }
+  double realtime_factor() const override { return -1.0; }
+  double achievable_realtime_factor() const override { return -1.0; }
+
+  void increment_step() { step_++; }
+
+ private:
+  uint64_t step_{0};
+  Duration step_width_;
+};
+
+/**
+ * Return the times at which a model with the given schedule is processed
+ * within the first n steps of the sync.
+ */
+std::vector<int64_t> due_times_ms(Scheduler& sched, StepSync& sync, int n) {
+  std::vector<int64_t> times;
+  for (int i = 0; i < n; ++i, sync.increment_step()) {
+    if (sched.is_due(sync)) {
+      times.push_back(sched.sync().time().count() / 1'000'000);
+    }
+  }
+  return times;
+}
+
+}  // anonymous namespace
+
+TEST(cloe_schedule, every_step) {
+  StepSync sync{ms(1)};
+  Scheduler sched;
+  ASSERT_TRUE(sched.schedule().is_every_step());
+  EXPECT_EQ(due_times_ms(sched, sync, 4), (std::vector<int64_t>{0, 1, 2, 3}));
+  EXPECT_EQ(sched.sync().step(), 3);
+  EXPECT_EQ(sched.sync().step_width(), ms(1));
+}
+
+TEST(cloe_schedule, period_and_phase) {
+  StepSync sync{ms(1)};
+  Scheduler sched{Schedule{ms(10), ms(3)}};
+  EXPECT_EQ(due_times_ms(sched, sync, 35), (std::vector<int64_t>{3, 13, 23, 33}));
+  EXPECT_EQ(sched.sync().step(), 3);
+  EXPECT_EQ(sched.sync().step_width(), ms(10));
+  EXPECT_EQ(sched.next_time(), ms(43));
+
+  fable::Json j = sched;
+  EXPECT_EQ(j["num_processed"], 4);
+  EXPECT_EQ(j["num_skipped"], 31);
+
+  // After a reset, the model is due from the start again.
+  sched.reset();
+  StepSync restart{ms(1)};
+  EXPECT_EQ(due_times_ms(sched, restart, 4), (std::vector<int64_t>{3}));
+  EXPECT_EQ(sched.sync().step(), 0);
+}
+
+TEST(cloe_schedule, period_not_multiple_of_step_width) {
+  // A 33 ms period with a 20 ms step width does not drift: the model runs
+  // in the first step at or after each multiple of 33 ms.
+  StepSync sync{ms(20)};
+  Scheduler sched{Schedule{ms(33)}};
+  std::vector<Duration> widths;
+  std::vector<int64_t> times;
+  for (int i = 0; i < 10; ++i, sync.increment_step()) {
+    if (sched.is_due(sync)) {
+      times.push_back(sched.sync().time().count() / 1'000'000);
+      widths.push_back(sched.sync().step_width());
+    }
+  }
+  EXPECT_EQ(times, (std::vector<int64_t>{0, 40, 80, 100, 140, 180}));
+  EXPECT_EQ(widths, (std::vector<Duration>{ms(33), ms(40), ms(40), ms(20), ms(40), ms(40)}));
+}
+
+TEST(cloe_schedule, next_wakeup) {
+  Scheduler every;
+  EXPECT_EQ(every.next_wakeup(ms(7)), ms(7));
+
+  StepSync sync{ms(1)};
+  Scheduler sched{Schedule{ms(10), ms(3)}};
+  EXPECT_EQ(sched.next_wakeup(ms(1)), ms(3));
+  EXPECT_EQ(due_times_ms(sched, sync, 4), (std::vector<int64_t>{3}));
+  EXPECT_EQ(sched.next_wakeup(ms(4)), ms(13));
+  EXPECT_EQ(sched.next_wakeup(ms(17)), ms(17));
+}
+
+TEST(cloe_schedule, from_conf) {
+  Schedule s;
+  s.from_conf(fable::Conf{fable::Json{{"period", 100'000'000}}});
+  EXPECT_EQ(s.period, ms(100));
+  EXPECT_EQ(s.phase, Duration(0));
+  EXPECT_FALSE(s.is_every_step());
+  EXPECT_ANY_THROW(s.from_conf(fable::Conf{fable::Json{{"period", -1}}}));
+}
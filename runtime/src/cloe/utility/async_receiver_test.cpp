@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/async_receiver_test.cpp
+ * \see  cloe/utility/async_receiver.hpp
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>     // for atomic<>
+#include <chrono>     // for milliseconds
+#include <memory>     // for shared_ptr<>
+#include <stdexcept>  // for runtime_error
+#include <thread>     // for sleep_for
+#include <vector>     // for vector<>
+
+#include <cloe/utility/async_receiver.hpp>
+using cloe::utility::AsyncReceiver;
+
+TEST(utility_async_receiver, drain_in_order) {
+  AsyncReceiver<std::shared_ptr<int>> receiver(4);
+  int i = 0;
+  receiver.start([&i]() {
+    if (i == 100) {
+      throw std::runtime_error("end of stream");
+    }
+    return std::make_shared<int>(i++);
+  });
+
+  std::vector<std::shared_ptr<int>> msgs;
+  ASSERT_THROW(
+      {
+        while (true) {
+          receiver.wait();
+          receiver.drain(msgs);
+        }
+      },
+      std::runtime_error);
+
+  ASSERT_EQ(100, msgs.size());
+  for (int j = 0; j < 100; j++) {
+    ASSERT_EQ(j, *msgs[j]);
+  }
+  ASSERT_FALSE(receiver.is_running());
+  ASSERT_FALSE(receiver.has());
+}
+
+TEST(utility_async_receiver, stop_with_unblock) {
+  std::atomic<bool> unblocked{false};
+  AsyncReceiver<int> receiver;
+  receiver.start([&unblocked]() {
+    while (!unblocked) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    throw std::runtime_error("connection closed");
+    return 0;
+  });
+
+  ASSERT_FALSE(receiver.wait_for(std::chrono::milliseconds(10)));
+  receiver.stop([&unblocked]() { unblocked = true; });
+  ASSERT_FALSE(receiver.is_running());
+
+  // Errors caused by stopping should not be rethrown.
+  std::vector<int> msgs;
+  ASSERT_EQ(0, receiver.drain(msgs));
+}
+
+TEST(utility_async_receiver, destroy_with_unblock) {
+  std::atomic<bool> unblocked{false};
+  {
+    AsyncReceiver<int> receiver;
+    receiver.start(
+        [&unblocked]() {
+          while (!unblocked) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+          throw std::runtime_error("connection closed");
+          return 0;
+        },
+        [&unblocked]() { unblocked = true; });
+    ASSERT_FALSE(receiver.wait_for(std::chrono::milliseconds(10)));
+  }
+  ASSERT_TRUE(unblocked);
+}
+
+TEST(utility_async_receiver, to_json) {
+  AsyncReceiver<int> receiver(8);
+  receiver.start([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return 42;
+  });
+  ASSERT_TRUE(receiver.wait_for(std::chrono::seconds(1)));
+
+  std::vector<int> msgs;
+  receiver.drain(msgs);
+  receiver.stop();
+
+  fable::Json j = receiver;
+  ASSERT_EQ(8, j["queue_capacity"].get<size_t>());
+  ASSERT_EQ(msgs.size(), j["num_messages_drained"].get<size_t>());
+  ASSERT_TRUE(j["latency_ms"].contains("mean"));
+}
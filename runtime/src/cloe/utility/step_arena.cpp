@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/step_arena.cpp
+ * \see  cloe/utility/step_arena.hpp
+ */
+
+#include <cloe/utility/step_arena.hpp>
+
+#include <boost/core/demangle.hpp>  // for demangle
+
+#include <fable/json.hpp>  // for Json
+
+namespace cloe::utility {
+
+void StepPoolBase::to_json(fable::Json& j) const {
+  j = fable::Json{
+      {"last_step_values", last_used_},
+      {"num_values", num_made_},
+      {"num_slots_allocated", num_slots_allocated_},
+      {"num_generations_retired", num_retired_},
+      {"num_generations", num_generations_},
+  };
+}
+
+void to_json(fable::Json& j, const StepArena& a) {
+  j = fable::Json::object();
+  for (const auto& kv : a.pools_) {
+    kv.second->to_json(j[boost::core::demangle(kv.first.name())]);
+  }
+}
+
+}  // namespace cloe::utility
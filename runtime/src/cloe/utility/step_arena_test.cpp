@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/utility/step_arena_test.cpp
+ * \see  cloe/utility/step_arena.hpp
+ */
+
+#include <memory>  // for shared_ptr<>
+#include <string>  // for string
+#include <vector>  // for vector<>
+
+#include <gtest/gtest.h>
+
+#include <cloe/utility/step_arena.hpp>
+#include <fable/json.hpp>  // for Json
+using cloe::utility::StepArena;
+using cloe::utility::StepPool;
+
+TEST(utility_step_arena_test, reuse_in_steady_state) {
+  StepPool<std::vector<int>> pool;
+  std::vector<std::shared_ptr<std::vector<int>>> cache;
+
+  const std::vector<int>* first = nullptr;
+  for (int step = 0; step < 10; ++step) {
+    for (int i = 0; i < 100; ++i) {
+      cache.push_back(pool.make(std::vector<int>(16, step)));
+    }
+    if (step == 0) {
+      first = cache.front().get();
+    }
+    EXPECT_EQ(cache.front().get(), first);
+    EXPECT_EQ((*cache.back())[15], step);
+    EXPECT_EQ(pool.size(), 100);
+
+    // This is what components do when they clear their cache:
+    cache.clear();
+    pool.reset();
+  }
+  EXPECT_EQ(pool.capacity(), 100);
+
+  fable::Json j;
+  pool.to_json(j);
+  EXPECT_EQ(j["num_slots_allocated"], 100);
+  EXPECT_EQ(j["num_generations_retired"], 0);
+}
+
+TEST(utility_step_arena_test, retire_when_in_use) {
+  StepPool<std::string> pool;
+  auto kept = pool.make("kept");
+  auto released = pool.make("released");
+  released.reset();
+  pool.reset();
+
+  // The value that is still in use must not be overwritten.
+  auto other = pool.make("other");
+  EXPECT_EQ(*kept, "kept");
+  EXPECT_EQ(*other, "other");
+  EXPECT_NE(kept.get(), other.get());
+
+  // Once released, the retired generation can be reused.
+  kept.reset();
+  other.reset();
+  pool.reset();
+  pool.reset();
+  fable::Json j;
+  pool.to_json(j);
+  EXPECT_EQ(j["num_generations_retired"], 1);
+  EXPECT_EQ(j["num_generations"], 2);
+}
+
+TEST(utility_step_arena_test, arena_pools) {
+  StepArena arena;
+  auto i = arena.make<int>(42);
+  auto s = arena.make<std::string>("hello");
+  EXPECT_EQ(*i, 42);
+  EXPECT_EQ(*s, "hello");
+  EXPECT_EQ(arena.pool<int>().size(), 1);
+  EXPECT_EQ(arena.pool<std::string>().size(), 1);
+  i.reset();
+  s.reset();
+  arena.reset();
+  EXPECT_EQ(arena.pool<int>().size(), 0);
+}
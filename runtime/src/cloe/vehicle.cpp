@@ -22,11 +22,14 @@
 
 #include <cloe/vehicle.hpp>
 
-#include <cstdint>  // for uint64_t
-#include <map>      // for map<>
-#include <memory>   // for shared_ptr<>
-#include <set>      // for set<>
-#include <string>   // for string
+#include <algorithm>  // for min
+#include <cstdint>    // for uint64_t
+#include <map>        // for map<>
+#include <memory>     // for shared_ptr<>
+#include <set>        // for set<>
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector<>
 
 #include <cloe/registrar.hpp>  // for Registrar
 #include <cloe/sync.hpp>       // for Sync
@@ -38,6 +41,9 @@ namespace cloe {
 std::shared_ptr<Vehicle> Vehicle::clone(uint64_t id, const std::string& name) {
   auto veh = std::make_shared<Vehicle>(id, name);
   veh->components_ = std::map<std::string, std::shared_ptr<Component>>(components_);
+  veh->schedules_ = schedules_;
+  veh->unique_components_ = unique_components_;
+  veh->arena_ = arena_;
   return veh;
 }
 
@@ -68,25 +74,76 @@ void Vehicle::disconnect() {
 }
 
 Duration Vehicle::process(const Sync& sync) {
-  std::set<uint64_t> component_ids;
   Duration target = sync.time();
-  for (auto& c : this->components_) {
-    auto id = c.second->id();
-    if (component_ids.count(id) == 0) {
-      Duration t = c.second->process(sync);
-      if (t < target) {
-        return t;
-      }
-      component_ids.insert(id);
+  for (auto& c : this->unique_components_) {
+    if (!c.scheduler.is_due(sync)) {
+      continue;
+    }
+    Duration t = c.component->process(c.scheduler.sync());
+    if (t < target) {
+      target = t;
+      break;
     }
   }
+
+  // Components have cleared their caches now, so the values they derived
+  // in the last step can be reused.
+  arena_->reset();
   return target;
 }
 
+Duration Vehicle::next_wakeup(const Sync& sync) const {
+  Duration wakeup = Duration::max();
+  for (const auto& c : this->unique_components_) {
+    wakeup = std::min(wakeup, c.scheduler.next_wakeup(c.component->next_wakeup(sync)));
+  }
+  return wakeup;
+}
+
+void Vehicle::set_schedule(const std::string& key, const Schedule& s) {
+  auto id = this->at(key)->id();
+  schedules_[id] = s;
+  for (auto& c : unique_components_) {
+    if (c.component->id() == id) {
+      c.scheduler = Scheduler{s};
+    }
+  }
+}
+
+void Vehicle::update_unique_components() {
+  // Keep the state of the schedulers of components that remain, so that
+  // setting one component does not make all others due again.
+  std::map<uint64_t, Scheduler> previous;
+  for (auto& c : unique_components_) {
+    previous.emplace(c.component->id(), std::move(c.scheduler));
+  }
+
+  std::set<uint64_t> component_ids;
+  unique_components_.clear();
+  for (auto& kv : this->components_) {
+    auto id = kv.second->id();
+    if (!component_ids.insert(id).second) {
+      continue;
+    }
+    if (auto prev = previous.find(id); prev != previous.end()) {
+      unique_components_.push_back(ScheduledComponent{kv.second, std::move(prev->second)});
+    } else {
+      auto it = schedules_.find(id);
+      Scheduler sched{it == schedules_.end() ? Schedule{} : it->second};
+      unique_components_.push_back(ScheduledComponent{kv.second, std::move(sched)});
+    }
+  }
+  components_version_++;
+}
+
 void Vehicle::reset() {
   for (auto& c : this->components_) {
     c.second->reset();
   }
+  for (auto& c : this->unique_components_) {
+    c.scheduler.reset();
+  }
+  arena_->reset();
 }
 
 void Vehicle::abort() {
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/vehicle_test.cpp
+ * \see  cloe/vehicle.hpp
+ */
+
+#include <algorithm>  // for max
+#include <memory>     // for shared_ptr<>, make_shared
+#include <string>     // for string
+#include <vector>     // for vector<>
+
+#include <gtest/gtest.h>
+
+#include <cloe/component.hpp>  // for Component
+#include <cloe/schedule.hpp>   // for Schedule
+#include <cloe/sync.hpp>       // for Sync
+#include <cloe/vehicle.hpp>    // for Vehicle, ComponentHandle
+
+using namespace cloe;  // NOLINT(build/namespaces)
+
+namespace {
+
+class TestSync : public Sync {
+ public:
+  uint64_t step() const override { return 1; }
+  Duration step_width() const override { return Duration(20'000'000); }
+  Duration time() const override { return time_; }
+  Duration eta() const override { return Duration(0); }
+  double realtime_factor() const override { return -1.0; }
+  double achievable_realtime_factor() const override { return -1.0; }
+
+  Duration time_{20'000'000};
+};
+
+/**
+ * FastForwardSync skips to the step of the next wakeup, as the engine does
+ * when fast-forwarding, so the step width spans the skipped steps.
+ */
+class FastForwardSync : public TestSync {
+ public:
+  Duration step_width() const override { return elapsed_; }
+  Duration base_step_width() const override { return Duration(10'000'000); }
+
+  void skip_to(Duration wakeup) {
+    auto base = base_step_width();
+    auto next = std::max(time_ + base, base * ((wakeup + base - Duration(1)) / base));
+    elapsed_ = next - time_;
+    time_ = next;
+  }
+
+  Duration elapsed_{10'000'000};
+};
+
+class CountingComponent : public Component {
+ public:
+  explicit CountingComponent(const std::string& name) : Component(name) {}
+  fable::Json active_state() const override { return fable::Json{{"count", count}}; }
+  Duration process(const Sync& sync) override {
+    count++;
+    return Component::process(sync);
+  }
+
+  int count{0};
+};
+
+class RecordingComponent : public Component {
+ public:
+  explicit RecordingComponent(const std::string& name) : Component(name) {}
+  fable::Json active_state() const override { return fable::Json{}; }
+  Duration process(const Sync& sync) override {
+    times.push_back(sync.time());
+    return Component::process(sync);
+  }
+
+  std::vector<Duration> times;
+};
+
+class WakingComponent : public CountingComponent {
+ public:
+  WakingComponent(const std::string& name, Duration wakeup)
+      : CountingComponent(name), wakeup_(wakeup) {}
+  Duration next_wakeup(const Sync&) const override { return wakeup_; }
+
+  Duration wakeup_;
+};
+
+}  // anonymous namespace
+
+TEST(cloe_vehicle, process_aliases_once) {
+  Vehicle v(1, "default");
+  auto a = std::make_shared<CountingComponent>("a");
+  auto b = std::make_shared<CountingComponent>("b");
+  v.set_component("a", a);
+  v.set_component("a_alias", a);
+  v.set_component("b", b);
+
+  TestSync sync;
+  v.process(sync);
+  v.process(sync);
+  EXPECT_EQ(a->count, 2);
+  EXPECT_EQ(b->count, 2);
+
+  // Replacing the only reference to a component removes it.
+  v.set_component("b", a);
+  v.process(sync);
+  EXPECT_EQ(a->count, 3);
+  EXPECT_EQ(b->count, 2);
+}
+
+TEST(cloe_vehicle, component_handle) {
+  Vehicle v(1, "default");
+  auto a = std::make_shared<CountingComponent>("a");
+  v.set_component("sensor", a);
+
+  auto h = v.handle<CountingComponent>("sensor");
+  EXPECT_EQ(h.get(), a);
+  h->count = 42;
+  EXPECT_EQ(a->count, 42);
+
+  const Vehicle& cv = v;
+  ComponentHandle<const CountingComponent> ch = cv.handle<CountingComponent>("sensor");
+  EXPECT_EQ(ch->count, 42);
+
+  // The handle follows the component when it is replaced.
+  auto b = std::make_shared<CountingComponent>("b");
+  v.set_component("sensor", b);
+  EXPECT_EQ(h.get(), b);
+  EXPECT_EQ(ch->count, 0);
+
+  EXPECT_THROW(v.handle<CountingComponent>("unknown"), UnknownComponent);
+  EXPECT_FALSE(ComponentHandle<CountingComponent>());
+}
+
+TEST(cloe_vehicle, process_scheduled) {
+  Vehicle v(1, "default");
+  auto a = std::make_shared<CountingComponent>("a");
+  auto b = std::make_shared<CountingComponent>("b");
+  v.set_component("a", a);
+  v.set_component("a_alias", a);
+  v.set_component("b", b);
+
+  // The schedule applies to all aliases, and survives setting other components.
+  v.set_schedule("a_alias", Schedule{Duration(60'000'000)});
+  v.set_component("c", std::make_shared<CountingComponent>("c"));
+
+  TestSync sync;
+  for (int i = 0; i < 6; ++i) {
+    sync.time_ = Duration(20'000'000 * i);
+    v.process(sync);
+  }
+  EXPECT_EQ(a->count, 2);
+  EXPECT_EQ(b->count, 6);
+  EXPECT_THROW(v.set_schedule("unknown", Schedule{}), UnknownComponent);
+}
+
+TEST(cloe_vehicle, process_scheduled_keeps_state) {
+  Vehicle v(1, "default");
+  auto a = std::make_shared<CountingComponent>("a");
+  v.set_component("a", a);
+  v.set_schedule("a", Schedule{Duration(60'000'000)});
+
+  TestSync sync;
+  sync.time_ = Duration(0);
+  v.process(sync);
+  EXPECT_EQ(a->count, 1);
+
+  // Setting a component during the simulation does not make a due again.
+  v.set_component("b", std::make_shared<CountingComponent>("b"));
+  sync.time_ = Duration(20'000'000);
+  v.process(sync);
+  EXPECT_EQ(a->count, 1);
+  sync.time_ = Duration(60'000'000);
+  v.process(sync);
+  EXPECT_EQ(a->count, 2);
+}
+
+TEST(cloe_vehicle, process_scheduled_fast_forward) {
+  Vehicle v(1, "default");
+  auto a = std::make_shared<RecordingComponent>("a");
+  auto b = std::make_shared<RecordingComponent>("b");
+  v.set_component("a", a);
+  v.set_component("b", b);
+  v.set_schedule("a", Schedule{Duration(30'000'000)});
+  v.set_schedule("b", Schedule{Duration(70'000'000)});
+
+  // A skip to the next due component must not pass the slot of another.
+  FastForwardSync sync;
+  sync.time_ = Duration(0);
+  while (sync.time_ <= Duration(150'000'000)) {
+    v.process(sync);
+    sync.skip_to(v.next_wakeup(sync));
+  }
+  auto ms = [](std::vector<int64_t> xs) {
+    std::vector<Duration> ds;
+    for (auto x : xs) {
+      ds.emplace_back(Duration(x * 1'000'000));
+    }
+    return ds;
+  };
+  EXPECT_EQ(a->times, ms({0, 30, 60, 90, 120, 150}));
+  EXPECT_EQ(b->times, ms({0, 70, 140}));
+}
+
+TEST(cloe_vehicle, next_wakeup) {
+  Vehicle v(1, "default");
+  TestSync sync;
+  EXPECT_EQ(v.next_wakeup(sync), Duration::max());
+
+  v.set_component("a", std::make_shared<WakingComponent>("a", Duration(500'000'000)));
+  v.set_component("b", std::make_shared<WakingComponent>("b", Duration(300'000'000)));
+  EXPECT_EQ(v.next_wakeup(sync), Duration(300'000'000));
+
+  // A scheduled component cannot wake up before it is due.
+  v.set_schedule("b", Schedule{Duration(1'000'000'000), Duration(800'000'000)});
+  EXPECT_EQ(v.next_wakeup(sync), Duration(500'000'000));
+
+  // Components that do not declare a wakeup need the next step.
+  v.set_component("c", std::make_shared<CountingComponent>("c"));
+  EXPECT_EQ(v.next_wakeup(sync), sync.time() + sync.step_width());
+}
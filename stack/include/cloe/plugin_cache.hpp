@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/plugin_cache.hpp
+ * \see  cloe/plugin_cache.cpp
+ * \see  cloe/plugin_cache_test.cpp
+ *
+ * This file defines a persistent cache of plugin manifests, so that plugins
+ * can be registered without opening them.
+ */
+
+#pragma once
+
+#include <cstdint>     // for int64_t, uintmax_t
+#include <filesystem>  // for path
+#include <map>         // for map<>
+#include <mutex>       // for mutex
+#include <optional>    // for optional<>
+#include <string>      // for string
+
+#include <cloe/core.hpp>  // for Json
+
+namespace cloe {
+
+/**
+ * PluginCacheEntry contains everything that is needed to register a plugin
+ * with the stack without opening it.
+ *
+ * The entry is only valid as long as the file at the path has the same size
+ * and modification time.
+ */
+struct PluginCacheEntry {
+  std::string path;
+  uintmax_t size{0};
+  int64_t mtime{0};
+
+  std::string name;
+  std::string type;
+  std::string type_version;
+  Json schema;
+  bool schema_required{false};
+
+  /**
+   * Return an entry with the path, size, and modification time of the file
+   * at the given path.
+   *
+   * - Throws std::filesystem::filesystem_error if the file cannot be read.
+   */
+  static PluginCacheEntry stat(const std::string& path);
+
+  /**
+   * Return whether the entry describes the same file as other.
+   */
+  bool is_same_file(const PluginCacheEntry& other) const {
+    return path == other.path && size == other.size && mtime == other.mtime;
+  }
+
+  friend void to_json(Json& j, const PluginCacheEntry& e);
+  friend void from_json(const Json& j, PluginCacheEntry& e);
+};
+
+/**
+ * PluginCache is a persistent map from plugin paths to plugin manifests.
+ *
+ * The cache is stored as a JSON file, which is read the first time the cache
+ * is used and written by save() if it has been modified. The cache file is
+ * discarded as a whole if it was written by a different version, since the
+ * plugin manifest and the schema of a plugin may depend on the version of
+ * Cloe it was loaded with.
+ *
+ * All methods are thread-safe, so that plugins can be loaded in parallel.
+ */
+class PluginCache {
+ public:
+  PluginCache(std::filesystem::path file, std::string version)
+      : file_(std::move(file)), version_(std::move(version)) {}
+
+  /**
+   * Return the path to the cache file.
+   */
+  const std::filesystem::path& file() const { return file_; }
+
+  /**
+   * Return the version that the cache entries are valid for.
+   */
+  const std::string& version() const { return version_; }
+
+  /**
+   * Return the entry for the plugin at the given path, if it exists and the
+   * file has not changed since it was inserted.
+   */
+  std::optional<PluginCacheEntry> find(const std::string& path);
+
+  /**
+   * Insert or replace the entry for the plugin at the path of the entry.
+   */
+  void insert(PluginCacheEntry e);
+
+  /**
+   * Remove the entry for the plugin at the given path, if it exists.
+   */
+  void erase(const std::string& path);
+
+  /**
+   * Return the number of entries in the cache.
+   */
+  size_t size();
+
+  /**
+   * Write the cache file if the cache has been modified since it was read.
+   *
+   * Errors are logged but not raised, since the cache is only an
+   * optimization. The file is written atomically, so that concurrent engine
+   * invocations never read a partially written cache.
+   */
+  void save();
+
+ private:
+  void read();
+
+ private:
+  std::filesystem::path file_;
+  std::string version_;
+
+  std::mutex mtx_;
+  bool read_{false};
+  bool dirty_{false};
+  std::map<std::string, PluginCacheEntry> entries_;
+};
+
+}  // namespace cloe
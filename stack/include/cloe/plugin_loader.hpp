@@ -23,11 +23,14 @@
 #pragma once
 
 #include <functional>  // for function<>
-#include <memory>      // for unique_ptr<>
+#include <memory>      // for unique_ptr<>, enable_shared_from_this<>
+#include <mutex>       // for mutex
+#include <optional>    // for optional<>
 #include <string>      // for string
 
-#include <cloe/core.hpp>    // for Json, Error
-#include <cloe/plugin.hpp>  // for PluginManifest
+#include <cloe/core.hpp>          // for Duration, Json, Error
+#include <cloe/plugin.hpp>        // for PluginManifest
+#include <cloe/plugin_cache.hpp>  // for PluginCacheEntry
 
 namespace cloe {
 
@@ -57,7 +60,7 @@ class PluginError : public Error {
   std::string plugin_path_;
 };
 
-class Plugin {
+class Plugin : public std::enable_shared_from_this<Plugin> {
  public:
   /**
    * Construct a Plugin by loading a dynamic library from disk.
@@ -112,6 +115,17 @@ class Plugin {
    */
   explicit Plugin(const std::string& plugin_path, const std::string& name = "");
 
+  /**
+   * Construct a Plugin from a cached manifest without loading it.
+   *
+   * The dynamic library is only opened once a factory is made from the
+   * plugin. Until then, the schema of the plugin is answered from the cache
+   * as far as possible.
+   *
+   * \see PluginCache
+   */
+  explicit Plugin(const PluginCacheEntry& e, const std::string& name = "");
+
   /**
    * Construct a Plugin from a Plugin-compatible type itself.
    *
@@ -134,12 +148,12 @@ class Plugin {
   /**
    * Return the plugin type.
    */
-  std::string type() const { return manifest_.plugin_type; }
+  std::string type() const { return type_; }
 
   /**
    * Return the API version of the plugin.
    */
-  std::string type_version() const { return manifest_.plugin_type_version; }
+  std::string type_version() const { return type_version_; }
 
   /**
    * Return the version that the Cloe library expects the plugin to have.
@@ -148,9 +162,37 @@ class Plugin {
 
   /**
    * Return the schema of this plugin.
+   *
+   * If the plugin was constructed from a cache entry and has not been
+   * loaded yet, the schema is only loaded once it is used for more than
+   * its JSON schema.
    */
   Schema schema() const;
 
+  /**
+   * Return whether the dynamic library of this plugin has been opened.
+   *
+   * This is always true unless the plugin was constructed from a cache
+   * entry and no factory has been made from it yet.
+   */
+  bool is_loaded() const;
+
+  /**
+   * Open the dynamic library of this plugin now, if it has not been opened
+   * yet because the plugin was constructed from a cache entry.
+   *
+   * - Throws PluginError if the library cannot be opened.
+   */
+  void ensure_loaded() const { load(); }
+
+  /**
+   * Return the cache entry that describes this plugin.
+   *
+   * This creates a factory from the plugin, so it may only be called if the
+   * plugin is compatible.
+   */
+  PluginCacheEntry cache_entry() const;
+
   /**
    * Return whether this plugin is builtin (as opposed to loaded from disk).
    */
@@ -169,6 +211,18 @@ class Plugin {
    */
   bool is_compatible() const;
 
+  /**
+   * Return the wall-clock time it took to load the plugin.
+   *
+   * This includes opening the library, reading the manifest, and creating
+   * the factory to find its name. It is zero for builtin plugins and for
+   * cached plugins that have not been loaded yet.
+   */
+  Duration load_time() const {
+    std::lock_guard<std::mutex> guard(mtx_);
+    return load_time_;
+  }
+
   /**
    * Attempt to cast this component to a sub-type.
    *
@@ -180,7 +234,7 @@ class Plugin {
       throw PluginError(path(), "cannot make factory from incompatible plugin");
     }
 
-    auto f = std::unique_ptr<F>(dynamic_cast<F*>(createf_()));
+    auto f = std::unique_ptr<F>(dynamic_cast<F*>(load()()));
     f->set_name(name());
     return f;
   }
@@ -196,12 +250,33 @@ class Plugin {
     };
   }
 
+ private:
+  /**
+   * Open the dynamic library and read the manifest and factory function.
+   */
+  void open() const;
+
+  /**
+   * Return the factory function, opening the dynamic library if necessary.
+   */
+  std::function<ModelFactory*()> load() const;
+
  private:
   std::string path_;
   std::string name_;
-  PluginManifest manifest_;
-  void* handle_;
-  std::function<ModelFactory*()> createf_;
+  std::string type_;
+  std::string type_version_;
+
+  // Set only if constructed from a cache entry:
+  std::optional<Json> cached_schema_;
+  bool cached_schema_required_{false};
+
+  // Set once the plugin is loaded:
+  mutable std::mutex mtx_;
+  mutable PluginManifest manifest_{};
+  mutable void* handle_{nullptr};
+  mutable std::function<ModelFactory*()> createf_;
+  mutable Duration load_time_{0};
 };
 
 /**
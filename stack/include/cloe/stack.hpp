@@ -24,6 +24,7 @@
 #pragma once
 
 #include <filesystem>  // for filesystem::path
+#include <future>      // for future<>
 #include <map>         // for map<>
 #include <memory>      // for shared_ptr<>
 #include <optional>    // for optional<>
@@ -38,10 +39,12 @@
 #include <cloe/component.hpp>        // for ComponentFactory
 #include <cloe/controller.hpp>       // for ControllerFactory
 #include <cloe/core.hpp>             // for Conf, Confable, Json
+#include <cloe/schedule.hpp>         // for Schedule
 #include <cloe/simulator.hpp>        // for SimulatorFactory
 #include <cloe/trigger.hpp>          // for Source
 #include <cloe/utility/command.hpp>  // for Command
 
+#include <cloe/plugin_cache.hpp>   // for PluginCache
 #include <cloe/plugin_loader.hpp>  // for Plugin
 #include <cloe/stack_config.hpp>
 
@@ -299,6 +302,16 @@ struct EngineConf : public Confable {
   bool plugins_ignore_failure{false};
   bool plugins_allow_clobber{true};
 
+  /**
+   * Whether to load the plugins of a directory in parallel.
+   *
+   * The plugins are registered in order of their path regardless, so
+   * clobbering and errors do not depend on timing. However, the plugin
+   * factories are constructed concurrently while loading, so this should
+   * only be enabled if all plugins in the directory allow that.
+   */
+  bool plugins_parallel_load{false};
+
   // Hooks:
   std::vector<Command> hooks_pre_connect{};
   std::vector<Command> hooks_post_disconnect{};
@@ -315,8 +328,17 @@ struct EngineConf : public Confable {
   std::optional<std::filesystem::path> output_file_signals{"signals.json"};
   std::optional<std::filesystem::path> output_file_signals_autocompletion;
   std::optional<std::filesystem::path> output_file_data_stream;
+  std::optional<std::filesystem::path> output_file_trace;
   bool output_clobber_files{true};
 
+  /**
+   * Number of trace events to keep per thread when tracing.
+   *
+   * Tracing is enabled by setting `output_file_trace`. When more events are
+   * recorded, the oldest ones are overwritten.
+   */
+  size_t trace_buffer_size{1'000'000};
+
   /**
    * Number of milliseconds between states when waiting for continuation.
    *
@@ -384,6 +406,47 @@ struct EngineConf : public Confable {
    */
   bool keep_alive{false};
 
+  /**
+   * Whether to connect the simulators and the controllers in parallel.
+   *
+   * Simulators are connected at the same time as each other, and so are
+   * controllers. This only works if the connect() methods of the models
+   * do not depend on each other, which is why it is disabled by default.
+   */
+  bool parallel_connect{false};
+
+  /**
+   * Whether to pace the simulation with absolute deadlines.
+   *
+   * Otherwise, each step sleeps for the time that remains of it, which wakes
+   * up late by an amount that varies with the kernel.
+   */
+  bool realtime_enable{false};
+
+  /**
+   * CPUs to run the simulation thread on, or empty for any.
+   */
+  std::vector<int> realtime_cpus{};
+
+  /**
+   * CPUs to run the server threads on, or empty for any.
+   */
+  std::vector<int> realtime_server_cpus{};
+
+  /**
+   * Priority of the simulation thread with the SCHED_FIFO policy, or zero
+   * to keep the default policy.
+   *
+   * This requires the CAP_SYS_NICE capability. Without it, the simulation
+   * runs with the default policy and a warning is logged.
+   */
+  int realtime_fifo_priority{0};
+
+  /**
+   * Time before each deadline in which to spin instead of sleep.
+   */
+  std::chrono::microseconds realtime_spin_time{200};
+
  public:  // Confable Overrides
   CONFABLE_SCHEMA(EngineConf) {
     // clang-format off
@@ -407,6 +470,7 @@ struct EngineConf : public Confable {
            {"ignore_missing", make_schema(&plugins_ignore_missing, "ignore not-exist errors")},
            {"ignore_failure", make_schema(&plugins_ignore_failure, "ignore plugin loading errors")},
            {"allow_clobber", make_schema(&plugins_allow_clobber, "replace same-named plugins")},
+           {"parallel_load", make_schema(&plugins_parallel_load, "load plugins of a directory in parallel")},
         }},
         {"registry_path", make_schema(&registry_path, dir_proto(), "cloe registry directory")},
         {"output", Struct{
@@ -419,8 +483,12 @@ struct EngineConf : public Confable {
               {"signals", make_schema(&output_file_signals, file_proto(), "file to store signals in")},
               {"signals_autocompletion", make_schema(&output_file_signals_autocompletion, file_proto(), "file to store signal autocompletion in")},
               {"api_recording", make_schema(&output_file_data_stream, file_proto(), "file to store api data stream")},
+              {"trace", make_schema(&output_file_trace, file_proto(), "file to store Chrome trace of engine in")},
            }},
         }},
+        {"trace", Struct{
+           {"buffer_size", make_schema(&trace_buffer_size, "number of trace events to keep per thread")},
+        }},
         {"triggers", Struct{
            {"ignore_source", make_schema(&triggers_ignore_source, "ignore trigger source when reading in triggers")},
         }},
@@ -431,6 +499,14 @@ struct EngineConf : public Confable {
            {"state_timeouts", make_schema(&watchdog_state_timeouts, "timeout specific to a given state, 0 for no timeout").unique_properties(false)},
         }},
         {"keep_alive", make_schema(&keep_alive, "keep simulation alive after termination")},
+        {"parallel_connect", make_schema(&parallel_connect, "connect simulators and controllers in parallel")},
+        {"realtime", Struct{
+           {"enable", make_schema(&realtime_enable, "pace simulation with absolute deadlines")},
+           {"cpus", make_schema(&realtime_cpus, "CPUs to run simulation thread on").extend(false)},
+           {"server_cpus", make_schema(&realtime_server_cpus, "CPUs to run server threads on").extend(false)},
+           {"fifo_priority", make_schema(&realtime_fifo_priority, "SCHED_FIFO priority of simulation thread, 0 to disable").minimum(0).maximum(99)},
+           {"spin_time", make_schema(&realtime_spin_time, "microseconds to spin before each deadline")},
+        }},
     };
     // clang-format on
   }
@@ -478,12 +554,25 @@ class FactoryPlugin : public fable::schema::FactoryPointerless<C> {
   virtual ~FactoryPlugin() = default;
 
   void add_plugin(const std::string& name, std::shared_ptr<Plugin> p) {
-    this->set_factory(name, p->make<F>()->schema(), [p, name](const Conf& c) {
+    this->set_factory(name, p->schema(), [p, name](const Conf& c) {
       C tmp{name, p->make<F>()};
       tmp.from_conf(c);
       return tmp;
     });
   }
+
+ protected:
+  /**
+   * Validate the input only against the schema of the given factory.
+   *
+   * Only one factory can match, since the binding is part of each variant.
+   * Validating just that one means that cached plugins which are not used
+   * in the stack file are not loaded.
+   */
+  bool validate_factory(const std::string& key, const Conf& c,
+                        std::optional<SchemaError>& err) const {
+    return this->factory_schema(*this->available_.find(key)).validate(c, err);
+  }
 };
 
 // --------------------------------------------------------------------------------------------- //
@@ -529,6 +618,7 @@ struct ControllerConf : public Confable {
   const std::string binding;
   std::optional<std::string> name;
   std::string vehicle;
+  Schedule schedule;
   std::shared_ptr<ControllerFactory> factory;
   Conf args;
 
@@ -544,6 +634,7 @@ struct ControllerConf : public Confable {
         {"binding", make_const_schema(binding, "name of controller binding").require()},
         {"name", make_schema(&name, id_prototype(), "identifier override for binding")},
         {"vehicle", make_schema(&vehicle, "vehicle controller is assigned to").c_identifier().require()},
+        {"schedule", make_schema(&schedule, "execution rate of controller")},
         {"args", make_schema(&args, factory->schema(), "factory-specific arguments")},
     };
     // clang-format on
@@ -615,6 +706,7 @@ struct ComponentConf : public Confable {
   const std::string binding;
   std::optional<std::string> name;
   std::vector<std::string> from;
+  Schedule schedule;
   std::shared_ptr<ComponentFactory> factory;
   Conf args;
 
@@ -638,6 +730,7 @@ struct ComponentConf : public Confable {
                  }
              ),
         }},
+        {"schedule", make_schema(&schedule, "execution rate of component")},
         {"args", make_schema(&args, factory->schema(), "factory-specific args")},
     };
     // clang-format on
@@ -848,6 +941,16 @@ struct SimulationConf : public Confable {
    */
   bool abort_on_controller_failure{true};
 
+  /**
+   * Whether to skip steps in which no model needs to be processed and no
+   * trigger needs to be evaluated.
+   *
+   * Steps are only skipped when the realtime factor is unlimited.
+   *
+   * \see `Model::next_wakeup`
+   */
+  bool fast_forward{false};
+
  public:  // Confable Overrides
   CONFABLE_SCHEMA(SimulationConf) {
     // clang-format off
@@ -858,6 +961,7 @@ struct SimulationConf : public Confable {
         {"controller_retry_limit", make_schema(&controller_retry_limit, "times to retry controller processing before aborting")},
         {"controller_retry_sleep", make_schema(&controller_retry_sleep, "time to sleep before retrying controller process")},
         {"abort_on_controller_failure", make_schema(&abort_on_controller_failure, "abort simulation on controller failure")},
+        {"fast_forward", make_schema(&fast_forward, "skip steps in which no model needs to be processed")},
     };
     // clang-format on
   }
@@ -917,6 +1021,7 @@ class Stack : public Confable {
  private:  // State (3)
   std::set<std::string> scanned_plugin_paths_;
   std::map<std::string, std::shared_ptr<Plugin>> all_plugins_;
+  std::shared_ptr<PluginCache> plugin_cache_;
   std::vector<Conf> applied_confs_;
   ConfReader conf_reader_func_;
 
@@ -946,6 +1051,17 @@ class Stack : public Confable {
     conf_reader_func_ = std::move(fn);
   }
 
+  /**
+   * Set the cache that plugins are looked up in before they are loaded.
+   *
+   * Plugins that are found in the cache are only loaded once they are used.
+   * Plugins that are not found are loaded and inserted into the cache, which
+   * is saved after each plugin configuration is applied.
+   *
+   * If the cache is nullptr, all plugins are loaded right away.
+   */
+  void set_plugin_cache(std::shared_ptr<PluginCache> cache) { plugin_cache_ = std::move(cache); }
+
   /**
    * Open the given JSON file and merge it into the stack.
    */
@@ -1130,6 +1246,14 @@ class Stack : public Confable {
    * account.
    */
   void from_conf(const Conf& c, size_t depth);
+
+  /**
+   * Register the plugin that is being loaded for the PluginConf.
+   *
+   * This waits for the plugin to be loaded, and handles errors as
+   * configured in the PluginConf.
+   */
+  void insert_plugin(const PluginConf& c, std::future<std::shared_ptr<Plugin>>&& loading);
 };
 
 }  // namespace cloe
@@ -39,6 +39,7 @@
 
 namespace cloe {
 
+class PluginCache;
 class Stack;
 
 /**
@@ -51,6 +52,7 @@ class Stack;
 struct StackOptions {
   std::ostream* error = &std::cerr;
   std::shared_ptr<fable::Environment> environment;
+  std::shared_ptr<PluginCache> plugin_cache;
 
   // Flags:
   std::vector<std::string> plugin_paths;
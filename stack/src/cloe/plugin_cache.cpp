@@ -0,0 +1,183 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/plugin_cache.cpp
+ * \see  cloe/plugin_cache.hpp
+ */
+
+#include "cloe/plugin_cache.hpp"
+
+#include <unistd.h>  // for getpid
+
+#include <filesystem>    // for file_size, last_write_time, rename, ...
+#include <fstream>       // for ifstream, ofstream
+#include <stdexcept>     // for runtime_error
+#include <string>        // for string
+#include <system_error>  // for error_code
+#include <utility>       // for move
+
+#include <fmt/format.h>  // for format
+
+namespace cloe {
+
+namespace fs = std::filesystem;
+
+PluginCacheEntry PluginCacheEntry::stat(const std::string& path) {
+  PluginCacheEntry e;
+  e.path = path;
+  e.size = fs::file_size(path);
+  e.mtime = fs::last_write_time(path).time_since_epoch().count();
+  return e;
+}
+
+void to_json(Json& j, const PluginCacheEntry& e) {
+  j = Json{
+      {"path", e.path},
+      {"size", e.size},
+      {"mtime", e.mtime},
+      {"name", e.name},
+      {"type", e.type},
+      {"type_version", e.type_version},
+      {"schema", e.schema},
+      {"schema_required", e.schema_required},
+  };
+}
+
+void from_json(const Json& j, PluginCacheEntry& e) {
+  j.at("path").get_to(e.path);
+  j.at("size").get_to(e.size);
+  j.at("mtime").get_to(e.mtime);
+  j.at("name").get_to(e.name);
+  j.at("type").get_to(e.type);
+  j.at("type_version").get_to(e.type_version);
+  e.schema = j.at("schema");
+  j.at("schema_required").get_to(e.schema_required);
+}
+
+std::optional<PluginCacheEntry> PluginCache::find(const std::string& path) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  read();
+  auto it = entries_.find(path);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+
+  std::error_code ec;
+  auto size = fs::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto mtime = fs::last_write_time(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  if (it->second.size != size || it->second.mtime != mtime.time_since_epoch().count()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void PluginCache::insert(PluginCacheEntry e) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  read();
+  auto key = e.path;
+  entries_[key] = std::move(e);
+  dirty_ = true;
+}
+
+void PluginCache::erase(const std::string& path) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  read();
+  if (entries_.erase(path) != 0) {
+    dirty_ = true;
+  }
+}
+
+size_t PluginCache::size() {
+  std::lock_guard<std::mutex> guard(mtx_);
+  read();
+  return entries_.size();
+}
+
+void PluginCache::read() {
+  if (read_) {
+    return;
+  }
+  read_ = true;
+
+  std::ifstream ifs(file_);
+  if (!ifs) {
+    return;
+  }
+  auto log = logger::get("cloe");
+  try {
+    auto j = Json::parse(ifs);
+    if (j.at("version") != version_) {
+      log->debug("Discard plugin cache {} from version {}", file_.native(),
+                 j.at("version").dump());
+      return;
+    }
+    for (const auto& x : j.at("plugins")) {
+      auto e = x.get<PluginCacheEntry>();
+      auto key = e.path;
+      entries_.emplace(std::move(key), std::move(e));
+    }
+  } catch (std::exception& e) {
+    log->warn("Discard invalid plugin cache {}: {}", file_.native(), e.what());
+    entries_.clear();
+  }
+}
+
+void PluginCache::save() {
+  std::lock_guard<std::mutex> guard(mtx_);
+  if (!dirty_) {
+    return;
+  }
+
+  Json plugins = Json::array();
+  for (const auto& kv : entries_) {
+    plugins.push_back(kv.second);
+  }
+  Json j{
+      {"version", version_},
+      {"plugins", std::move(plugins)},
+  };
+
+  // Write to a temporary file first and then replace the cache file, so that
+  // other processes never see a partially written file.
+  auto tmp = file_;
+  tmp += fmt::format(".{}.tmp", getpid());
+  try {
+    fs::create_directories(file_.parent_path());
+    {
+      std::ofstream ofs(tmp, std::ios::trunc);
+      ofs << j.dump() << std::endl;
+      if (!ofs) {
+        throw std::runtime_error("cannot write file");
+      }
+    }
+    fs::rename(tmp, file_);
+    dirty_ = false;
+  } catch (std::exception& e) {
+    logger::get("cloe")->warn("Cannot write plugin cache {}: {}", file_.native(), e.what());
+    std::error_code ec;
+    fs::remove(tmp, ec);
+  }
+}
+
+}  // namespace cloe
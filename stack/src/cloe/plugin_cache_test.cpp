@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 Robert Bosch GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * \file cloe/plugin_cache_test.cpp
+ * \see  cloe/plugin_cache.hpp
+ * \see  cloe/plugin_cache.cpp
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>  // for getpid
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <cloe/core.hpp>       // for Json
+#include <cloe/simulator.hpp>  // for SimulatorFactory
+#include <fmt/format.h>        // for format
+
+#include "cloe/plugin_cache.hpp"   // for PluginCache
+#include "cloe/plugin_loader.hpp"  // for Plugin
+using namespace cloe;              // NOLINT(build/namespaces)
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class PluginCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = fs::temp_directory_path() / fmt::format("cloe_plugin_cache_test.{}", getpid());
+    fs::remove_all(dir_);
+    fs::create_directories(dir_);
+    plugin_ = (dir_ / "fake.so").native();
+    std::ofstream(plugin_) << "not a shared library";
+  }
+
+  void TearDown() override { fs::remove_all(dir_); }
+
+  PluginCacheEntry make_entry() const {
+    auto e = PluginCacheEntry::stat(plugin_);
+    e.name = "fake";
+    e.type = "simulator";
+    e.type_version = SimulatorFactory::PLUGIN_API_VERSION;
+    e.schema = Json{
+        {"type", "object"},
+        {"description", "fake simulator"},
+    };
+    return e;
+  }
+
+  fs::path cache_file() const { return dir_ / "cache" / "plugins.json"; }
+
+  fs::path dir_;
+  std::string plugin_;
+};
+
+}  // anonymous namespace
+
+TEST_F(PluginCacheTest, round_trip) {
+  {
+    PluginCache c{cache_file(), "1.0"};
+    ASSERT_FALSE(c.find(plugin_));
+    c.insert(make_entry());
+    ASSERT_TRUE(c.find(plugin_));
+    c.save();
+  }
+
+  PluginCache c{cache_file(), "1.0"};
+  auto e = c.find(plugin_);
+  ASSERT_TRUE(e);
+  ASSERT_EQ(e->name, "fake");
+  ASSERT_EQ(e->type, "simulator");
+  ASSERT_EQ(e->schema, make_entry().schema);
+}
+
+TEST_F(PluginCacheTest, invalidate) {
+  {
+    PluginCache c{cache_file(), "1.0"};
+    c.insert(make_entry());
+    c.save();
+  }
+
+  // Another version discards the whole cache.
+  ASSERT_FALSE(PluginCache(cache_file(), "2.0").find(plugin_));
+
+  // A modified plugin invalidates its entry.
+  std::ofstream(plugin_, std::ios::app) << "modified";
+  ASSERT_FALSE(PluginCache(cache_file(), "1.0").find(plugin_));
+
+  // An invalid cache file is ignored.
+  std::ofstream(cache_file()) << "{ not json";
+  PluginCache c{cache_file(), "1.0"};
+  ASSERT_EQ(c.size(), 0);
+}
+
+TEST_F(PluginCacheTest, lazy_plugin) {
+  auto p = std::make_shared<Plugin>(make_entry());
+  ASSERT_FALSE(p->is_loaded());
+  ASSERT_EQ(p->name(), "fake");
+  ASSERT_EQ(p->path(), plugin_);
+  ASSERT_TRUE(p->is_compatible());
+
+  // The JSON schema comes from the cache.
+  auto s = p->schema();
+  ASSERT_EQ(s.json_schema(), make_entry().schema);
+  ASSERT_EQ(s.description(), "fake simulator");
+  ASSERT_FALSE(p->is_loaded());
+
+  // Everything else needs the plugin, which cannot be loaded here.
+  ASSERT_THROW(s.validate_or_throw(Conf{Json::object()}), PluginError);
+  ASSERT_THROW(p->make<SimulatorFactory>(), PluginError);
+  ASSERT_FALSE(p->is_loaded());
+}
@@ -23,9 +23,13 @@
 #include "cloe/plugin_loader.hpp"
 
 #include <dlfcn.h>  // for dlopen, dlsym, RTLD_NOW, ...
-#include <memory>   // for unique_ptr<>
+#include <chrono>   // for steady_clock, duration_cast
+#include <memory>   // for unique_ptr<>, shared_ptr<>
 #include <set>      // for set<>
 #include <string>   // for string
+#include <utility>  // for move
+
+#include <fable/schema/interface.hpp>  // for Interface
 
 #include <cloe/component.hpp>   // for ComponentFactory
 #include <cloe/controller.hpp>  // for ControllerFactory
@@ -117,30 +121,132 @@ const std::set<std::string> PLUGIN_TYPES_KNOWN({
     "simulator",
 });
 
+/**
+ * CachedPluginSchema is the schema of a plugin that has not been loaded yet.
+ *
+ * The JSON schema is answered from the cache; everything else loads the
+ * plugin and delegates to its actual schema. This allows the stack to build
+ * its schema from all known plugins, while only the plugins that are
+ * actually used for validation or deserialization are loaded.
+ */
+class CachedPluginSchema : public fable::schema::Interface {
+ public:
+  CachedPluginSchema(std::shared_ptr<const Plugin> p, Json schema, bool required)
+      : plugin_(std::move(p)), json_(std::move(schema)), required_(required) {
+    if (json_.contains("description")) {
+      desc_ = json_["description"].get<std::string>();
+    }
+  }
+
+  std::unique_ptr<fable::schema::Interface> clone() const override {
+    return std::make_unique<CachedPluginSchema>(*this);
+  }
+  JsonType type() const override { return JsonType::object; }
+  std::string type_string() const override { return "object"; }
+  bool is_required() const override { return required_; }
+  const std::string& description() const override { return desc_; }
+  void set_description(std::string s) override {
+    if (loaded_) {
+      loaded_->set_description(s);
+    }
+    json_["description"] = s;
+    desc_ = std::move(s);
+  }
+  Json usage() const override { return loaded().usage(); }
+  Json json_schema() const override { return json_; }
+  bool validate(const Conf& c, std::optional<fable::SchemaError>& err) const override {
+    return loaded().validate(c, err);
+  }
+  using Interface::to_json;
+  void to_json(Json& j) const override { loaded().to_json(j); }
+  void from_conf(const Conf& c) override { loaded().from_conf(c); }
+  void reset_ptr() override {
+    if (loaded_) {
+      loaded_->reset_ptr();
+    }
+  }
+
+ private:
+  Schema& loaded() const {
+    if (!loaded_) {
+      auto f = plugin_->make<ModelFactory>();
+      loaded_ = Schema{f->schema()}.reset_pointer();
+      if (loaded_->description() != desc_) {
+        loaded_->set_description(desc_);
+      }
+    }
+    return *loaded_;
+  }
+
+ private:
+  std::shared_ptr<const Plugin> plugin_;
+  Json json_;
+  std::string desc_;
+  bool required_;
+  mutable std::optional<Schema> loaded_;
+};
+
 }  // anonymous namespace
 
 Plugin::Plugin(const std::string& plugin_path, const std::string& name)
     : path_(plugin_path), name_(name) {
+  auto begin = std::chrono::steady_clock::now();
+  open();
+  type_ = manifest_.plugin_type;
+  type_version_ = manifest_.plugin_type_version;
+
+  // Get the factory name if none is specified.
+  if (name_.empty()) {
+    std::unique_ptr<ModelFactory> factory{createf_()};
+    name_ = factory->name();
+  }
+
+  load_time_ = std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - begin);
+}
+
+Plugin::Plugin(const PluginCacheEntry& e, const std::string& name)
+    : path_(e.path)
+    , name_(name.empty() ? e.name : name)
+    , type_(e.type)
+    , type_version_(e.type_version)
+    , cached_schema_(e.schema)
+    , cached_schema_required_(e.schema_required) {}
+
+Plugin::Plugin(const PluginManifest& m, std::function<ModelFactory*()> fn, const std::string& name)
+    : path_()
+    , name_(name)
+    , type_(m.plugin_type)
+    , type_version_(m.plugin_type_version)
+    , manifest_(m)
+    , handle_(nullptr)
+    , createf_(fn) {
+  if (name_.empty()) {
+    auto tmpf = std::unique_ptr<ModelFactory>(createf_());
+    name_ = tmpf->name();
+  }
+}
+
+void Plugin::open() const {
   // Load the plugin with a very conservative mode.
   // This will called again after we have the plugin manifest.
-  handle_ = dlopen(plugin_path.c_str(), RTLD_LOCAL | RTLD_LAZY);
+  handle_ = dlopen(path_.c_str(), RTLD_LOCAL | RTLD_LAZY);
   if (handle_ == nullptr) {
-    throw PluginError(plugin_path, dlerror());
+    throw PluginError(path_, dlerror());
   }
 
   // Get the manifest.
-  manifest_ = read_plugin_manifest(handle_, plugin_path);
+  manifest_ = read_plugin_manifest(handle_, path_);
 
   // If the plugin manifest defines different loader settings, apply those now.
   if (manifest_.glibc_dlopen_mode != 0) {
     int mode = manifest_.glibc_dlopen_mode;
     auto log = logger::get("cloe");
 
-    log->debug("{}: Overriding GLIBC dlopen() mode: {}", plugin_path, mode);
+    log->debug("{}: Overriding GLIBC dlopen() mode: {}", path_, mode);
     dlclose(handle_);
-    handle_ = dlopen(plugin_path.c_str(), mode);
+    handle_ = dlopen(path_.c_str(), mode);
     if (handle_ == nullptr) {
-      throw PluginError(plugin_path, dlerror());
+      throw PluginError(path_, dlerror());
     }
   }
 
@@ -148,27 +254,63 @@ Plugin::Plugin(const std::string& plugin_path, const std::string& name)
   auto factory_fn = dlsym(handle_, manifest_.factory_symbol);
   assert(factory_fn != nullptr);
   createf_ = reinterpret_cast<ModelFactory* (*)()>(factory_fn);
+}
 
-  // Get the factory name if none is specified.
-  if (name_.empty()) {
-    std::unique_ptr<ModelFactory> factory{createf_()};
-    name_ = factory->name();
+std::function<ModelFactory*()> Plugin::load() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  if (createf_) {
+    return createf_;
   }
-}
 
-Plugin::Plugin(const PluginManifest& m, std::function<ModelFactory*()> fn, const std::string& name)
-    : path_(), name_(name), manifest_(m), handle_(nullptr), createf_(fn) {
-  if (name_.empty()) {
-    auto tmpf = std::unique_ptr<ModelFactory>(createf_());
-    name_ = tmpf->name();
+  auto begin = std::chrono::steady_clock::now();
+  logger::get("cloe")->debug("Load cached plugin {}", path_);
+  open();
+
+  // The cache entry is keyed by size and modification time, but if the
+  // plugin changed nonetheless, the cached schema cannot be trusted.
+  if (type_ != manifest_.plugin_type || type_version_ != manifest_.plugin_type_version) {
+    createf_ = nullptr;
+    dlclose(handle_);
+    handle_ = nullptr;
+    throw PluginError(path_, "plugin manifest differs from cache: {} {} != {} {}",
+                      manifest_.plugin_type, manifest_.plugin_type_version, type_, type_version_);
   }
+
+  load_time_ = std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - begin);
+  return createf_;
+}
+
+bool Plugin::is_loaded() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return createf_ != nullptr;
 }
 
 Schema Plugin::schema() const {
-  auto tmpf = std::unique_ptr<ModelFactory>(createf_());
+  if (cached_schema_ && !is_loaded()) {
+    // Only plugins managed by a shared_ptr can be loaded later, since the
+    // schema needs to keep the plugin alive.
+    if (auto self = weak_from_this().lock()) {
+      return Schema{std::make_shared<CachedPluginSchema>(self, *cached_schema_,
+                                                         cached_schema_required_)};
+    }
+  }
+  auto tmpf = std::unique_ptr<ModelFactory>(load()());
   return Schema{tmpf->schema()}.reset_pointer();
 }
 
+PluginCacheEntry Plugin::cache_entry() const {
+  assert(is_compatible());
+  auto e = PluginCacheEntry::stat(path_);
+  auto tmpf = std::unique_ptr<ModelFactory>(load()());
+  e.name = tmpf->name();
+  e.type = type_;
+  e.type_version = type_version_;
+  const auto& s = tmpf->schema();
+  e.schema = s.json_schema();
+  e.schema_required = s.is_required();
+  return e;
+}
+
 bool Plugin::is_type_known() const { return PLUGIN_TYPES_KNOWN.count(type()); }
 
 bool Plugin::is_compatible() const {
@@ -23,8 +23,10 @@
 
 #include "cloe/stack.hpp"
 
-#include <algorithm>   // for transform, swap
+#include <algorithm>   // for sort, transform, swap
+#include <chrono>      // for duration<>
 #include <filesystem>  // for filesystem
+#include <future>      // for async, future<>
 #include <map>         // for map<>
 #include <memory>      // for shared_ptr<>
 #include <set>         // for set<>
@@ -174,6 +176,7 @@ Stack::Stack(const Stack& other)
     // State (3)
     , scanned_plugin_paths_(other.scanned_plugin_paths_)
     , all_plugins_(other.all_plugins_)
+    , plugin_cache_(other.plugin_cache_)
     , applied_confs_(other.applied_confs_)
     , conf_reader_func_(other.conf_reader_func_) {
   // Reset invalidated schema caches.
@@ -224,6 +227,7 @@ void swap(Stack& left, Stack& right) {
   // State (3)
   swap(left.scanned_plugin_paths_, right.scanned_plugin_paths_);
   swap(left.all_plugins_, right.all_plugins_);
+  swap(left.plugin_cache_, right.plugin_cache_);
   swap(left.applied_confs_, right.applied_confs_);
   swap(left.conf_reader_func_, right.conf_reader_func_);
 
@@ -254,6 +258,36 @@ void Stack::merge_stackfile(const std::string& filepath) {
   from_conf(config);
 }
 
+namespace {
+
+/**
+ * Return the plugin for the PluginConf, which is loaded from the canonical
+ * path of the plugin.
+ *
+ * If the plugin is in the cache, it is not loaded until it is used.
+ * Otherwise, it is loaded and inserted into the cache if it is compatible.
+ *
+ * This does not modify any shared state except the thread-safe cache, so it
+ * can run in parallel.
+ */
+std::shared_ptr<Plugin> load_plugin(const PluginConf& c, std::shared_ptr<PluginCache> cache) {
+  auto canon = c.canonical();
+  auto name = c.plugin_name.value_or("");
+  if (cache) {
+    if (auto e = cache->find(canon)) {
+      return std::make_shared<Plugin>(*e, name);
+    }
+  }
+
+  auto p = std::make_shared<Plugin>(canon, name);
+  if (cache && p->is_compatible()) {
+    cache->insert(p->cache_entry());
+  }
+  return p;
+}
+
+}  // anonymous namespace
+
 void Stack::apply_plugin_conf(const PluginConf& c) {
   // 1. Check existence
   if (!fs::exists(c.plugin_path)) {
@@ -266,6 +300,7 @@ void Stack::apply_plugin_conf(const PluginConf& c) {
   }
 
   // 2. Load plugins
+  std::vector<PluginConf> confs;
   if (fs::is_directory(c.plugin_path)) {
     if (c.plugin_name) {
       throw Error("name can only be specified when path is a file");
@@ -276,20 +311,61 @@ void Stack::apply_plugin_conf(const PluginConf& c) {
       if (x->path().extension() == ".so") {
         PluginConf xc{c};
         xc.plugin_path = x->path();
-        insert_plugin(xc);
+        confs.emplace_back(std::move(xc));
       }
     }
+    std::sort(confs.begin(), confs.end(), [](const auto& a, const auto& b) {
+      return a.plugin_path < b.plugin_path;
+    });
   } else {
-    insert_plugin(c);
+    confs.emplace_back(c);
+  }
+
+  // Loading plugins is a large part of the startup time, so all plugins
+  // are loaded at once. They are registered in order of their path
+  // however, so that clobbering and errors do not depend on timing.
+  auto policy = engine.plugins_parallel_load ? std::launch::async : std::launch::deferred;
+  std::vector<std::future<std::shared_ptr<Plugin>>> loading;
+  loading.reserve(confs.size());
+  for (const auto& xc : confs) {
+    if (all_plugins_.count(xc.canonical()) != 0) {
+      loading.emplace_back();
+    } else {
+      loading.emplace_back(std::async(policy, load_plugin, xc, plugin_cache_));
+    }
+  }
+  for (size_t i = 0; i < confs.size(); ++i) {
+    if (!loading[i].valid()) {
+      logger()->debug("Skip {}", confs[i].canonical());
+      continue;
+    }
+    insert_plugin(confs[i], std::move(loading[i]));
+  }
+
+  if (plugin_cache_) {
+    plugin_cache_->save();
   }
 }
 
 void Stack::insert_plugin(const PluginConf& c) {
+  if (all_plugins_.count(c.canonical()) != 0) {
+    logger()->debug("Skip {}", c.canonical());
+    return;
+  }
+  insert_plugin(c, std::async(std::launch::deferred, load_plugin, c, plugin_cache_));
+}
+
+void Stack::insert_plugin(const PluginConf& c, std::future<std::shared_ptr<Plugin>>&& loading) {
   const auto canon = c.canonical();
-  logger()->debug("Load plugin {}", canon);
   std::shared_ptr<Plugin> plugin;
   try {
-    plugin = std::make_shared<Plugin>(canon, c.plugin_name.value_or(""));
+    plugin = loading.get();
+    if (plugin->is_loaded()) {
+      logger()->debug("Load plugin {} in {:.3f} ms", canon,
+                      std::chrono::duration<double, std::milli>(plugin->load_time()).count());
+    } else {
+      logger()->debug("Load plugin {} from cache", canon);
+    }
 
     if (!plugin->is_compatible()) {
       if (plugin->is_type_known()) {
@@ -814,7 +890,7 @@ bool SimulatorSchema::validate(const Conf& c, std::optional<SchemaError>& err) c
     // Override error message.
     throw_missing_plugin_error(c, "simulator", factory, get_factory_keys());
   }
-  return schema_->validate(c, err);
+  return validate_factory(factory, c, err);
 }
 
 bool ControllerSchema::validate(const Conf& c, std::optional<SchemaError>& err) const {
@@ -824,7 +900,7 @@ bool ControllerSchema::validate(const Conf& c, std::optional<SchemaError>& err)
     // Override error message.
     throw_missing_plugin_error(c, "controller", factory, get_factory_keys());
   }
-  return schema_->validate(c, err);
+  return validate_factory(factory, c, err);
 }
 
 bool ComponentSchema::validate(const Conf& c, std::optional<SchemaError>& err) const {
@@ -834,7 +910,7 @@ bool ComponentSchema::validate(const Conf& c, std::optional<SchemaError>& err) c
     // Override error message.
     throw_missing_plugin_error(c, "component", factory, get_factory_keys());
   }
-  return schema_->validate(c, err);
+  return validate_factory(factory, c, err);
 }
 
 }  // namespace cloe
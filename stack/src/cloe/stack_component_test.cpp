@@ -76,10 +76,15 @@ TEST(cloe_stack, deserialization_of_component) {
     "binding": "dummy_sensor",
     "name": "my_dummy_sensor",
     "from": "some_obj_sensor",
+    "schedule": {
+      "period": 33000000
+    },
     "args" : {
       "freq" : 9
     }
   })");
+  ASSERT_EQ(cc.schedule.period, cloe::Duration(33'000'000));
+  ASSERT_EQ(cc.schedule.phase, cloe::Duration(0));
 
   // In production code, "some_obj_sensor" would be fetched from a list of all
   // available sensors. Skip this step here.
@@ -122,6 +122,9 @@ Stack new_stack(const StackOptions& opt) {
         [&opt](const std::string& filepath) -> cloe::Conf { return read_conf(opt, filepath); });
   }
 
+  // Look up plugins in the cache before loading them, if provided.
+  s.set_plugin_cache(opt.plugin_cache);
+
   // Insert ignored sections
   for (const auto& i : opt.ignore_sections) {
     s.engine.ignore_sections.emplace_back(i);
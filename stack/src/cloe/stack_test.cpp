@@ -22,11 +22,16 @@
  */
 
 #include <gtest/gtest.h>
+#include <unistd.h>  // for getpid
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 
-#include <cloe/core.hpp>            // for Json
-#include <fable/utility/gtest.hpp>  // for assert_from_conf
+#include <cloe/core.hpp>                   // for Json
+#include <fmt/format.h>                    // for format
+#include <cloe/plugins/nop_simulator.hpp>  // for NopSimulatorFactory
+#include <fable/utility/gtest.hpp>         // for assert_from_conf
 
 #include "cloe/stack.hpp"  // for Stack
 using namespace cloe;      // NOLINT(build/namespaces)
@@ -57,19 +62,31 @@ TEST(cloe_stack, serialization_of_empty_stack) {
         }
       },
       "registry_path": "${XDG_DATA_HOME-${HOME}/.local/share}/cloe/registry",
+      "parallel_connect": false,
       "plugin_path": [],
       "plugins": {
         "allow_clobber": true,
         "ignore_failure": false,
-        "ignore_missing": false
+        "ignore_missing": false,
+        "parallel_load": false
       },
       "polling_interval": 100,
+      "realtime": {
+        "cpus": [],
+        "enable": false,
+        "fifo_priority": 0,
+        "server_cpus": [],
+        "spin_time": 200
+      },
       "security": {
         "enable_command_action": false,
         "enable_include_section": true,
         "enable_hooks_section": true,
         "max_include_depth": 64
       },
+      "trace": {
+        "buffer_size": 1000000
+      },
       "triggers": {
         "ignore_source": false
       },
@@ -104,7 +121,8 @@ TEST(cloe_stack, serialization_of_empty_stack) {
       "model_step_width": 20000000,
       "abort_on_controller_failure": true,
       "controller_retry_limit": 1000,
-      "controller_retry_sleep": 1
+      "controller_retry_sleep": 1,
+      "fast_forward": false
     },
     "simulators": [],
     "triggers": [],
@@ -149,19 +167,31 @@ TEST(cloe_stack, serialization_with_logging) {
         }
       },
       "registry_path": "${XDG_DATA_HOME-${HOME}/.local/share}/cloe/registry",
+      "parallel_connect": false,
       "plugin_path": [],
       "plugins": {
         "allow_clobber": true,
         "ignore_failure": false,
-        "ignore_missing": false
+        "ignore_missing": false,
+        "parallel_load": false
       },
       "polling_interval": 100,
+      "realtime": {
+        "cpus": [],
+        "enable": false,
+        "fifo_priority": 0,
+        "server_cpus": [],
+        "spin_time": 200
+      },
       "security": {
         "enable_command_action": false,
         "enable_include_section": true,
         "enable_hooks_section": true,
         "max_include_depth": 64
       },
+      "trace": {
+        "buffer_size": 1000000
+      },
       "triggers": {
         "ignore_source": false
       },
@@ -201,7 +231,8 @@ TEST(cloe_stack, serialization_with_logging) {
       "model_step_width": 20000000,
       "abort_on_controller_failure": true,
       "controller_retry_limit": 1000,
-      "controller_retry_sleep": 1
+      "controller_retry_sleep": 1,
+      "fast_forward": false
     },
     "triggers": [],
     "vehicles": [],
@@ -214,3 +245,133 @@ TEST(cloe_stack, serialization_with_logging) {
   Conf c{expect};
   ASSERT_TRUE(c.has_pointer("/engine/registry_path"));
 }
+
+TEST(cloe_stack, load_plugin_directory) {
+  namespace fs = std::filesystem;
+  auto dir = fs::temp_directory_path() / fmt::format("cloe_stack_test_plugins.{}", getpid());
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  for (const auto* name : {"a.so", "b.so", "c.so"}) {
+    std::ofstream(dir / name) << "not a shared library";
+  }
+
+  for (bool parallel : {true, false}) {
+    Stack s;
+    s.engine.plugins_parallel_load = parallel;
+
+    PluginConf c;
+    c.plugin_path = dir;
+    ASSERT_THROW(s.apply_plugin_conf(c), PluginError);
+
+    // Failures are ignored for all plugins in the directory.
+    c.ignore_failure = true;
+    ASSERT_NO_THROW(s.apply_plugin_conf(c));
+    ASSERT_TRUE(s.get_all_plugins().empty());
+  }
+
+  fs::remove_all(dir);
+}
+
+TEST(cloe_stack, load_plugin_directory_in_order) {
+  namespace fs = std::filesystem;
+  auto dir = fs::temp_directory_path() / fmt::format("cloe_stack_test_order.{}", getpid());
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  // All plugins have the same name, so each clobbers the previous one.
+  auto cache = std::make_shared<PluginCache>(dir / "plugins.json", "test");
+  for (const auto* name : {"c.so", "a.so", "d.so", "b.so"}) {
+    auto path = (dir / name).native();
+    std::ofstream(path) << "not a shared library";
+    auto e = PluginCacheEntry::stat(path);
+    e.name = "dup";
+    e.type = "simulator";
+    e.type_version = SimulatorFactory::PLUGIN_API_VERSION;
+    e.schema = Json{{"type", "object"}};
+    cache->insert(e);
+  }
+
+  for (int i = 0; i < 20; ++i) {
+    for (bool parallel : {true, false}) {
+      Stack s;
+      s.set_plugin_cache(cache);
+      s.engine.plugins_parallel_load = parallel;
+
+      PluginConf c;
+      c.plugin_path = dir;
+      ASSERT_NO_THROW(s.apply_plugin_conf(c));
+      ASSERT_EQ(s.get_all_plugins().size(), 4);
+      try {
+        s.from_conf(Conf{Json{
+            {"version", "4.1"},
+            {"simulators", Json::array({Json{{"binding", "dup"}}})},
+        }});
+        FAIL() << "expected PluginError";
+      } catch (PluginError& e) {
+        ASSERT_EQ(e.plugin_path(), (dir / "d.so").native());
+      } catch (std::exception& e) {
+        FAIL() << e.what();
+      }
+
+      // Without clobbering, the second plugin by path is the one that fails.
+      Stack t;
+      t.set_plugin_cache(cache);
+      t.engine.plugins_parallel_load = parallel;
+      c.allow_clobber = false;
+      try {
+        t.apply_plugin_conf(c);
+        FAIL() << "expected PluginError";
+      } catch (PluginError& e) {
+        ASSERT_EQ(e.plugin_path(), (dir / "b.so").native());
+      }
+    }
+  }
+
+  fs::remove_all(dir);
+}
+
+TEST(cloe_stack, load_plugin_from_cache) {
+  namespace fs = std::filesystem;
+  auto dir = fs::temp_directory_path() / fmt::format("cloe_stack_test_cache.{}", getpid());
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  auto path = (dir / "fake.so").native();
+  std::ofstream(path) << "not a shared library";
+
+  auto cache = std::make_shared<PluginCache>(dir / "plugins.json", "test");
+  auto e = PluginCacheEntry::stat(path);
+  e.name = "fake";
+  e.type = "simulator";
+  e.type_version = SimulatorFactory::PLUGIN_API_VERSION;
+  e.schema = Json{{"type", "object"}};
+  cache->insert(e);
+
+  Stack s;
+  s.set_plugin_cache(cache);
+  s.insert_plugin(make_plugin<plugins::NopSimulatorFactory>(),
+                  PluginConf{"builtin://simulator/nop"});
+
+  // The cached plugin is registered without loading it.
+  PluginConf c;
+  c.plugin_path = dir;
+  ASSERT_NO_THROW(s.apply_plugin_conf(c));
+  ASSERT_TRUE(s.has_plugin_with_name("fake"));
+  auto p = s.get_plugin_with_name("fake");
+  ASSERT_FALSE(p->is_loaded());
+
+  // It is only loaded once it is used.
+  ASSERT_NO_THROW(s.schema().json_schema());
+  fable::assert_from_conf(s, R"({
+    "version": "4.1",
+    "simulators": [
+      { "binding": "nop" }
+    ]
+  })");
+  ASSERT_FALSE(p->is_loaded());
+  ASSERT_ANY_THROW(s.from_conf(Conf{Json{
+      {"version", "4.1"},
+      {"simulators", Json::array({Json{{"binding", "fake"}}})},
+  }}));
+
+  fs::remove_all(dir);
+}
@@ -305,3 +305,61 @@ load setup_testname
     cloe-engine check test_engine_smoketest.json "${timestep_stack}"
     cloe-engine run test_engine_smoketest.json "${timestep_stack}"
 }
+
+@test "$(testname 'Expect run success' 'test_engine_checkpoint.json' 'cddd9ae1-88c5-41df-b3ab-d19518b2fb0c')" {
+    local output_path="$(mktemp -d --suffix=.cloe-test)"
+    local checkpoint="${output_path}/lead-in.ckpt"
+
+    # The lead-in writes a checkpoint and leaves a pending trigger.
+    cloe-engine run test_engine_checkpoint.json <(echo '{
+        "version": "4",
+        "triggers": [
+            { "event": "start", "action": "realtime_factor=-1" },
+            { "event": "time=1", "action": "checkpoint='"${checkpoint}"'" },
+            { "event": "time=2", "action": "succeed" }
+        ]
+    }')
+    test -f "${checkpoint}"
+
+    # Start triggers do not fire again when continuing from a checkpoint,
+    # so the restored trigger concludes the simulation.
+    cloe-engine run --from-checkpoint "${checkpoint}" test_engine_checkpoint.json <(echo '{
+        "version": "4",
+        "triggers": [
+            { "event": "start", "action": "fail" }
+        ]
+    }')
+
+    # The triggers of a variant are inserted after the checkpoint is restored,
+    # so this one fires before the restored trigger.
+    run cloe-engine run --from-checkpoint "${checkpoint}" test_engine_checkpoint.json <(echo '{
+        "version": "4",
+        "triggers": [
+            { "event": "time=1.5", "action": "fail" }
+        ]
+    }')
+    test $status -eq $CLOE_EXIT_FAILURE
+    rm -rf "${output_path}"
+}
+
+@test "$(testname 'Expect batch failure' 'test_engine_start_stop.json' '8a013c31-91a5-45d5-aae4-8731fcd36a6b')" {
+    require_program jq
+    local report="$(mktemp --suffix=.cloe-test.json)"
+
+    # Each stack file runs once per parameter value, and the batch fails if
+    # any of the simulations fails.
+    run bash -c "cloe-engine batch -j 2 -J -1 --param CLOE_BATCH_TEST=a,b \
+        test_engine_start_stop.json test_engine_fail_trigger.json > '${report}'"
+    test $status -eq 1
+
+    jq -e '.success == false' "${report}"
+    jq -e '.jobs | length == 4' "${report}"
+    jq -e '.outcomes == {"success": 2, "failure": 2}' "${report}"
+    jq -e '[.jobs[].parameters.CLOE_BATCH_TEST] == ["a", "b", "a", "b"]' "${report}"
+    jq -e '[.jobs[].exit_code] == [0, 0, 9, 9]' "${report}"
+
+    # Only the successful stack file succeeds.
+    cloe-engine batch --param CLOE_BATCH_TEST=a,b test_engine_start_stop.json > "${report}"
+    jq -e '.success == true and .outcomes == {"success": 2}' "${report}"
+    rm -f "${report}"
+}
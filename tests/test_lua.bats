@@ -64,6 +64,10 @@ load setup_testname
     cloe-engine run test_lua13_bdd_eval.lua
 }
 
+@test "$(testname 'Expect success' 'test_lua16_wait_until_predicate.lua' '6f791382-0b65-480b-b5a0-d57bb586bb35')" {
+    cloe-engine run test_lua16_wait_until_predicate.lua
+}
+
 # --- API ---------------------------------------------------------------------
 
 @test "$(testname 'Check API' 'test_lua_api_cloe_system.lua' '23496512-a7f9-4fb7-8ed3-a655954b24f7')" {
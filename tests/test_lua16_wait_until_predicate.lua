@@ -0,0 +1,37 @@
+local cloe = require("cloe")
+local events, actions = cloe.events, cloe.actions
+
+cloe.load_stackfile("config_nop_infinite.json")
+
+-- If wait_until does not work, then we will keep running until
+-- this event triggers and we fail.
+cloe.schedule({
+    on = events.time("10s"),
+    run = actions.fail(),
+})
+
+local dur = cloe.Duration.new
+
+cloe.schedule_test({
+    -- Note that this is the same ID as used in BATS.
+    id = "6f791382-0b65-480b-b5a0-d57bb586bb35",
+    on = events.start(),
+    run = function(z, sync)
+        cloe.log("info", "Waiting until predicate holds for 1s...")
+        z:wait_until("(default_speed/kmph >= 0 && !(default_speed/kmph > 1000)) for 1s")
+        z:assert(sync:time() >= dur("1s"), "predicate fired before it was held for 1s")
+        z:assert(sync:time() < dur("2s"), "predicate fired too late")
+
+        cloe.log("info", "Waiting until predicate holds before timeout...")
+        local start = sync:time()
+        z:wait_until("default_speed/kmph >= 0 for 200ms", "1s")
+        z:assert(sync:time() < start + dur("1s"), "predicate timed out")
+
+        cloe.log("info", "Waiting until predicate times out...")
+        start = sync:time()
+        z:wait_until("default_speed/kmph > 1000", "500ms")
+        z:assert(sync:time() > start + dur("500ms"), "predicate fired before timeout")
+
+        z:succeed()
+    end,
+})
@@ -27,3 +27,8 @@ load setup_testname
     cloe-engine check test_minimator_multi_agent_smoketest.json
     cloe-engine run test_minimator_multi_agent_smoketest.json
 }
+
+@test "$(testname 'Expect check/run success' 'test_minimator_traffic_smoketest.json' '3f0b8e5e-2d7c-4c1a-9a6e-6b1f0c2e4d85')" {
+    cloe-engine check test_minimator_traffic_smoketest.json
+    cloe-engine run test_minimator_traffic_smoketest.json
+}